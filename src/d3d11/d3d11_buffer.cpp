@@ -127,6 +127,8 @@ namespace dxvk {
       info.access |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
     }
     
+    info.renameHint = GetRenameHint(pDesc);
+    
     return m_device->GetDXVKDevice()->createBuffer(
       info, GetMemoryFlags(pDesc));
   }
@@ -147,4 +149,23 @@ namespace dxvk {
     return GetMemoryFlagsForUsage(pDesc->Usage);
   }
   
+  
+  DxvkBufferRenameHint D3D11Buffer::GetRenameHint(
+    const D3D11_BUFFER_DESC* pDesc) const {
+    // Only dynamic buffers can be invalidated with
+    // D3D11_MAP_WRITE_DISCARD, so they are the only
+    // ones that need a pool of backing slices
+    if (pDesc->Usage != D3D11_USAGE_DYNAMIC)
+      return DxvkBufferRenameHint::Static;
+    
+    // Dynamic constant buffers are typically discarded
+    // before every draw that uses them. Vertex and index
+    // buffers are more commonly discarded once per frame
+    // and written with D3D11_MAP_WRITE_NO_OVERWRITE.
+    if (pDesc->BindFlags & D3D11_BIND_CONSTANT_BUFFER)
+      return DxvkBufferRenameHint::Streaming;
+    
+    return DxvkBufferRenameHint::Dynamic;
+  }
+  
 }
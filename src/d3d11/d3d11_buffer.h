@@ -19,6 +19,8 @@ namespace dxvk {
    */
   struct D3D11BufferInfo {
     DxvkPhysicalBufferSlice mappedSlice;
+    bool                    ringTracked = false;
+    bool                    copyPending = false;
   };
   
   
@@ -86,6 +88,9 @@ namespace dxvk {
     VkMemoryPropertyFlags GetMemoryFlags(
       const D3D11_BUFFER_DESC* pDesc) const;
     
+    DxvkBufferRenameHint GetRenameHint(
+      const D3D11_BUFFER_DESC* pDesc) const;
+    
   };
   
 }
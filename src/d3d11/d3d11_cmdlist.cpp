@@ -60,8 +60,28 @@ namespace dxvk {
   
   
   void D3D11CommandList::EmitToCsThread(DxvkCsThread* CsThread) {
-    for (auto chunk : m_chunks)
-      CsThread->dispatchChunk(Rc<DxvkCsChunk>(chunk));
+    if (m_recording == nullptr) {
+      for (auto chunk : m_chunks)
+        CsThread->dispatchChunk(Rc<DxvkCsChunk>(chunk));
+      return;
+    }
+    
+    // Executes the pre-recorded secondary command buffers,
+    // or replays the chunks if they cannot be used
+    Rc<DxvkCsChunk> chunk = new DxvkCsChunk();
+    
+    auto command = [cRecording = m_recording] (DxvkContext* ctx) {
+      cRecording->execute(ctx);
+    };
+    
+    chunk->push(command, "ExecuteCommandList");
+    CsThread->dispatchChunk(std::move(chunk));
+  }
+  
+  
+  void D3D11CommandList::RecordCommands(DxvkCsRecorder* Recorder) {
+    if (m_chunks.size() != 0)
+      m_recording = Recorder->record(m_chunks);
   }
   
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "d3d11_context.h"
 
+#include "../dxvk/dxvk_cs_recorder.h"
+
 namespace dxvk {
   
   class D3D11CommandList : public D3D11DeviceChild<ID3D11CommandList> {
@@ -33,6 +35,9 @@ namespace dxvk {
     void EmitToCsThread(
             DxvkCsThread*       CsThread);
     
+    void RecordCommands(
+            DxvkCsRecorder*     Recorder);
+    
     UINT GetDrawCount() const {
       return m_drawCount;
     }
@@ -45,6 +50,8 @@ namespace dxvk {
     
     std::vector<Rc<DxvkCsChunk>> m_chunks;
     
+    Rc<DxvkCsRecording> m_recording;
+    
   };
   
 }
\ No newline at end of file
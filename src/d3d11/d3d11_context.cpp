@@ -35,7 +35,7 @@ namespace dxvk {
   
   
   D3D11DeviceContext::~D3D11DeviceContext() {
-    
+    LogRedundantCalls();
   }
   
   
@@ -59,18 +59,90 @@ namespace dxvk {
   }
   
   void STDMETHODCALLTYPE D3D11DeviceContext::DiscardResource(ID3D11Resource * pResource) {
-    Logger::err("D3D11DeviceContext::DiscardResource: Not implemented");
+    D3D11_CS_TAG("DiscardResource");
+    
+    if (pResource == nullptr)
+      return;
+    
+    D3D11_RESOURCE_DIMENSION resourceDim = D3D11_RESOURCE_DIMENSION_UNKNOWN;
+    pResource->GetType(&resourceDim);
+    
+    if (resourceDim == D3D11_RESOURCE_DIMENSION_BUFFER) {
+      auto buffer = static_cast<D3D11Buffer*>(pResource);
+      
+      // Mappable buffers can be renamed, which is what mapping
+      // them with D3D11_MAP_WRITE_DISCARD would do as well. On
+      // deferred contexts, the mapped slice must not change
+      // before the command list gets executed, so we ignore it.
+      if (GetType() == D3D11_DEVICE_CONTEXT_IMMEDIATE
+       && (buffer->GetBuffer()->memFlags() & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)) {
+        auto physicalSlice = buffer->GetBuffer()->allocPhysicalSlice();
+        buffer->GetBufferInfo()->mappedSlice = physicalSlice;
+        buffer->GetBufferInfo()->copyPending = false;
+        
+        EmitCs([
+          cBuffer        = buffer->GetBuffer(),
+          cPhysicalSlice = physicalSlice
+        ] (DxvkContext* ctx) {
+          ctx->invalidateBuffer(cBuffer, cPhysicalSlice);
+        });
+      }
+    } else {
+      const D3D11CommonTexture* texture = GetCommonTexture(pResource);
+      
+      if (texture != nullptr) {
+        const Rc<DxvkImage> image = texture->GetImage();
+        
+        VkImageSubresourceRange subresources;
+        subresources.aspectMask     = image->formatInfo()->aspectMask;
+        subresources.baseMipLevel   = 0;
+        subresources.levelCount     = image->info().mipLevels;
+        subresources.baseArrayLayer = 0;
+        subresources.layerCount     = image->info().numLayers;
+        
+        DiscardImage(image, subresources);
+      }
+    }
   }
 
   void STDMETHODCALLTYPE D3D11DeviceContext::DiscardView(ID3D11View * pResourceView) {
-    Logger::err("D3D11DeviceContext::DiscardView: Not implemented");
+    D3D11_CS_TAG("DiscardView");
+    
+    if (pResourceView == nullptr)
+      return;
+    
+    Rc<DxvkImageView> view;
+    
+    Com<ID3D11RenderTargetView>     rtv;
+    Com<ID3D11DepthStencilView>     dsv;
+    Com<ID3D11ShaderResourceView>   srv;
+    Com<ID3D11UnorderedAccessView>  uav;
+    
+    if (SUCCEEDED(pResourceView->QueryInterface(__uuidof(ID3D11RenderTargetView), reinterpret_cast<void**>(&rtv))))
+      view = static_cast<D3D11RenderTargetView*>(rtv.ptr())->GetImageView();
+    else if (SUCCEEDED(pResourceView->QueryInterface(__uuidof(ID3D11DepthStencilView), reinterpret_cast<void**>(&dsv))))
+      view = static_cast<D3D11DepthStencilView*>(dsv.ptr())->GetImageView();
+    else if (SUCCEEDED(pResourceView->QueryInterface(__uuidof(ID3D11ShaderResourceView), reinterpret_cast<void**>(&srv))))
+      view = static_cast<D3D11ShaderResourceView*>(srv.ptr())->GetImageView();
+    else if (SUCCEEDED(pResourceView->QueryInterface(__uuidof(ID3D11UnorderedAccessView), reinterpret_cast<void**>(&uav))))
+      view = static_cast<D3D11UnorderedAccessView*>(uav.ptr())->GetImageView();
+    
+    // Buffer views only cover parts of a buffer and
+    // cannot be discarded without a copy, so skip them
+    if (view != nullptr)
+      DiscardImage(view->image(), view->subresources());
   }
 
   void STDMETHODCALLTYPE D3D11DeviceContext::DiscardView1(
           ID3D11View*              pResourceView, 
     const D3D11_RECT*              pRects, 
           UINT                     NumRects) {
-    Logger::err("D3D11DeviceContext::DiscardView1: Not implemented");
+    D3D11_CS_TAG("DiscardView1");
+    
+    // Discarding parts of a view is only a hint
+    // which we cannot make use of, so ignore it
+    if (pRects == nullptr || NumRects == 0)
+      DiscardView(pResourceView);
   }
 
   void STDMETHODCALLTYPE D3D11DeviceContext::SwapDeviceContextState(
@@ -85,6 +157,8 @@ namespace dxvk {
   
   
   void STDMETHODCALLTYPE D3D11DeviceContext::ClearState() {
+    D3D11_CS_TAG("ClearState");
+    
     // Default shaders
     m_state.vs.shader = nullptr;
     m_state.hs.shader = nullptr;
@@ -181,6 +255,8 @@ namespace dxvk {
   
   
   void STDMETHODCALLTYPE D3D11DeviceContext::Begin(ID3D11Asynchronous *pAsync) {
+    D3D11_CS_TAG("Begin");
+    
     Com<ID3D11Query> query;
     
     if (SUCCEEDED(pAsync->QueryInterface(__uuidof(ID3D11Query), reinterpret_cast<void**>(&query)))) {
@@ -198,14 +274,18 @@ namespace dxvk {
   
   
   void STDMETHODCALLTYPE D3D11DeviceContext::End(ID3D11Asynchronous *pAsync) {
+    D3D11_CS_TAG("End");
+    
     Com<ID3D11Query> query;
     
     if (SUCCEEDED(pAsync->QueryInterface(__uuidof(ID3D11Query), reinterpret_cast<void**>(&query)))) {
       Com<D3D11Query> queryPtr = static_cast<D3D11Query*>(query.ptr());
       
       if (queryPtr->HasBeginEnabled()) {
-        EmitCs([queryPtr] (DxvkContext* ctx) {
-          queryPtr->End(ctx);
+        const uint32_t revision = queryPtr->GetRevision();
+        
+        EmitCs([revision, queryPtr] (DxvkContext* ctx) {
+          queryPtr->End(ctx, revision);
         });
       } else {
         const uint32_t revision = queryPtr->Reset();
@@ -283,6 +363,9 @@ namespace dxvk {
           ID3D11Resource*                   pSrcResource,
           UINT                              SrcSubresource,
     const D3D11_BOX*                        pSrcBox) {
+    DXVK_PROFILE_ZONE("CopySubresourceRegion");
+    D3D11_CS_TAG("CopySubresourceRegion");
+    
     D3D11_RESOURCE_DIMENSION dstResourceDim = D3D11_RESOURCE_DIMENSION_UNKNOWN;
     D3D11_RESOURCE_DIMENSION srcResourceDim = D3D11_RESOURCE_DIMENSION_UNKNOWN;
     
@@ -394,6 +477,8 @@ namespace dxvk {
           UINT                              SrcSubresource, 
     const D3D11_BOX*                        pSrcBox,
           UINT                              CopyFlags) {
+    D3D11_CS_TAG("CopySubresourceRegion1");
+    
     CopySubresourceRegion(pDstResource, DstSubresource, DstX, DstY, DstZ, pSrcResource, SrcSubresource, pSrcBox);
   }
   
@@ -401,6 +486,9 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeviceContext::CopyResource(
           ID3D11Resource*                   pDstResource,
           ID3D11Resource*                   pSrcResource) {
+    DXVK_PROFILE_ZONE("CopyResource");
+    D3D11_CS_TAG("CopyResource");
+    
     D3D11_RESOURCE_DIMENSION dstResourceDim = D3D11_RESOURCE_DIMENSION_UNKNOWN;
     D3D11_RESOURCE_DIMENSION srcResourceDim = D3D11_RESOURCE_DIMENSION_UNKNOWN;
     
@@ -466,6 +554,8 @@ namespace dxvk {
           ID3D11Buffer*                     pDstBuffer,
           UINT                              DstAlignedByteOffset,
           ID3D11UnorderedAccessView*        pSrcView) {
+    D3D11_CS_TAG("CopyStructureCount");
+    
     auto buf = static_cast<D3D11Buffer*>(pDstBuffer);
     auto uav = static_cast<D3D11UnorderedAccessView*>(pSrcView);
 
@@ -486,6 +576,9 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeviceContext::ClearRenderTargetView(
           ID3D11RenderTargetView*           pRenderTargetView,
     const FLOAT                             ColorRGBA[4]) {
+    DXVK_PROFILE_ZONE("ClearRenderTargetView");
+    D3D11_CS_TAG("ClearRenderTargetView");
+    
     auto rtv = static_cast<D3D11RenderTargetView*>(pRenderTargetView);
     
     if (rtv == nullptr)
@@ -526,6 +619,9 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeviceContext::ClearUnorderedAccessViewUint(
           ID3D11UnorderedAccessView*        pUnorderedAccessView,
     const UINT                              Values[4]) {
+    DXVK_PROFILE_ZONE("ClearUnorderedAccessViewUint");
+    D3D11_CS_TAG("ClearUnorderedAccessViewUint");
+    
     auto uav = static_cast<D3D11UnorderedAccessView*>(pUnorderedAccessView);
     
     if (uav == nullptr)
@@ -589,6 +685,9 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeviceContext::ClearUnorderedAccessViewFloat(
           ID3D11UnorderedAccessView*        pUnorderedAccessView,
     const FLOAT                             Values[4]) {
+    DXVK_PROFILE_ZONE("ClearUnorderedAccessViewFloat");
+    D3D11_CS_TAG("ClearUnorderedAccessViewFloat");
+    
     auto uav = static_cast<D3D11UnorderedAccessView*>(pUnorderedAccessView);
     
     if (uav == nullptr)
@@ -629,6 +728,9 @@ namespace dxvk {
           UINT                              ClearFlags,
           FLOAT                             Depth,
           UINT8                             Stencil) {
+    DXVK_PROFILE_ZONE("ClearDepthStencilView");
+    D3D11_CS_TAG("ClearDepthStencilView");
+    
     auto dsv = static_cast<D3D11DepthStencilView*>(pDepthStencilView);
     
     if (dsv == nullptr)
@@ -684,6 +786,9 @@ namespace dxvk {
   }
   
   void STDMETHODCALLTYPE D3D11DeviceContext::GenerateMips(ID3D11ShaderResourceView* pShaderResourceView) {
+    DXVK_PROFILE_ZONE("GenerateMips");
+    D3D11_CS_TAG("GenerateMips");
+    
     auto view = static_cast<D3D11ShaderResourceView*>(pShaderResourceView);
       
     if (view->GetResourceType() != D3D11_RESOURCE_DIMENSION_BUFFER) {
@@ -707,6 +812,9 @@ namespace dxvk {
     const void*                             pSrcData,
           UINT                              SrcRowPitch,
           UINT                              SrcDepthPitch) {
+    DXVK_PROFILE_ZONE("UpdateSubresource");
+    D3D11_CS_TAG("UpdateSubresource");
+    
     // We need a different code path for buffers
     D3D11_RESOURCE_DIMENSION resourceType;
     pDstResource->GetType(&resourceType);
@@ -824,6 +932,8 @@ namespace dxvk {
           UINT                              SrcRowPitch, 
           UINT                              SrcDepthPitch, 
           UINT                              CopyFlags) {
+    D3D11_CS_TAG("UpdateSubresource1");
+    
     UpdateSubresource(pDstResource, DstSubresource, pDstBox, pSrcData, SrcRowPitch, SrcDepthPitch);
   }
   
@@ -847,6 +957,9 @@ namespace dxvk {
           ID3D11Resource*                   pSrcResource,
           UINT                              SrcSubresource,
           DXGI_FORMAT                       Format) {
+    DXVK_PROFILE_ZONE("ResolveSubresource");
+    D3D11_CS_TAG("ResolveSubresource");
+    
     D3D11_RESOURCE_DIMENSION dstResourceType;
     D3D11_RESOURCE_DIMENSION srcResourceType;
     
@@ -930,6 +1043,8 @@ namespace dxvk {
   
   
   void STDMETHODCALLTYPE D3D11DeviceContext::DrawAuto() {
+    DXVK_PROFILE_ZONE("DrawAuto");
+    
     Logger::err("D3D11DeviceContext::DrawAuto: Not implemented");
   }
   
@@ -937,6 +1052,9 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeviceContext::Draw(
           UINT            VertexCount,
           UINT            StartVertexLocation) {
+    DXVK_PROFILE_ZONE("Draw");
+    D3D11_CS_TAG("Draw");
+    
     EmitCs([=] (DxvkContext* ctx) {
       ctx->draw(
         VertexCount, 1,
@@ -951,6 +1069,9 @@ namespace dxvk {
           UINT            IndexCount,
           UINT            StartIndexLocation,
           INT             BaseVertexLocation) {
+    DXVK_PROFILE_ZONE("DrawIndexed");
+    D3D11_CS_TAG("DrawIndexed");
+    
     EmitCs([=] (DxvkContext* ctx) {
       ctx->drawIndexed(
         IndexCount, 1,
@@ -967,6 +1088,9 @@ namespace dxvk {
           UINT            InstanceCount,
           UINT            StartVertexLocation,
           UINT            StartInstanceLocation) {
+    DXVK_PROFILE_ZONE("DrawInstanced");
+    D3D11_CS_TAG("DrawInstanced");
+    
     EmitCs([=] (DxvkContext* ctx) {
       ctx->draw(
         VertexCountPerInstance,
@@ -985,6 +1109,9 @@ namespace dxvk {
           UINT            StartIndexLocation,
           INT             BaseVertexLocation,
           UINT            StartInstanceLocation) {
+    DXVK_PROFILE_ZONE("DrawIndexedInstanced");
+    D3D11_CS_TAG("DrawIndexedInstanced");
+    
     EmitCs([=] (DxvkContext* ctx) {
       ctx->drawIndexed(
         IndexCountPerInstance,
@@ -1001,6 +1128,9 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeviceContext::DrawIndexedInstancedIndirect(
           ID3D11Buffer*   pBufferForArgs,
           UINT            AlignedByteOffsetForArgs) {
+    DXVK_PROFILE_ZONE("DrawIndexedInstancedIndirect");
+    D3D11_CS_TAG("DrawIndexedInstancedIndirect");
+    
     D3D11Buffer* buffer = static_cast<D3D11Buffer*>(pBufferForArgs);
     
     EmitCs([bufferSlice = buffer->GetBufferSlice(AlignedByteOffsetForArgs)]
@@ -1016,6 +1146,9 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeviceContext::DrawInstancedIndirect(
           ID3D11Buffer*   pBufferForArgs,
           UINT            AlignedByteOffsetForArgs) {
+    DXVK_PROFILE_ZONE("DrawInstancedIndirect");
+    D3D11_CS_TAG("DrawInstancedIndirect");
+    
     D3D11Buffer* buffer = static_cast<D3D11Buffer*>(pBufferForArgs);
     
     EmitCs([bufferSlice = buffer->GetBufferSlice(AlignedByteOffsetForArgs)]
@@ -1031,6 +1164,9 @@ namespace dxvk {
           UINT            ThreadGroupCountX,
           UINT            ThreadGroupCountY,
           UINT            ThreadGroupCountZ) {
+    DXVK_PROFILE_ZONE("Dispatch");
+    D3D11_CS_TAG("Dispatch");
+    
     EmitCs([=] (DxvkContext* ctx) {
       ctx->dispatch(
         ThreadGroupCountX,
@@ -1045,6 +1181,9 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeviceContext::DispatchIndirect(
           ID3D11Buffer*   pBufferForArgs,
           UINT            AlignedByteOffsetForArgs) {
+    DXVK_PROFILE_ZONE("DispatchIndirect");
+    D3D11_CS_TAG("DispatchIndirect");
+    
     D3D11Buffer* buffer = static_cast<D3D11Buffer*>(pBufferForArgs);
     
     EmitCs([bufferSlice = buffer->GetBufferSlice(AlignedByteOffsetForArgs)]
@@ -1057,19 +1196,27 @@ namespace dxvk {
   
   
   void STDMETHODCALLTYPE D3D11DeviceContext::IASetInputLayout(ID3D11InputLayout* pInputLayout) {
+    D3D11_CS_TAG("IASetInputLayout");
+    
     auto inputLayout = static_cast<D3D11InputLayout*>(pInputLayout);
     
     if (m_state.ia.inputLayout != inputLayout) {
       m_state.ia.inputLayout = inputLayout;
       ApplyInputLayout();
+    } else {
+      CountRedundantCall(D3D11StateCall::InputLayout);
     }
   }
   
   
   void STDMETHODCALLTYPE D3D11DeviceContext::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) {
+    D3D11_CS_TAG("IASetPrimitiveTopology");
+    
     if (m_state.ia.primitiveTopology != Topology) {
       m_state.ia.primitiveTopology = Topology;
       ApplyPrimitiveTopology();
+    } else {
+      CountRedundantCall(D3D11StateCall::PrimitiveTopology);
     }
   }
   
@@ -1080,14 +1227,34 @@ namespace dxvk {
           ID3D11Buffer* const*              ppVertexBuffers,
     const UINT*                             pStrides,
     const UINT*                             pOffsets) {
+    D3D11_CS_TAG("IASetVertexBuffers");
+    
+    uint32_t firstChanged = NumBuffers;
+    uint32_t lastChanged  = 0;
+    
     for (uint32_t i = 0; i < NumBuffers; i++) {
       auto newBuffer = static_cast<D3D11Buffer*>(ppVertexBuffers[i]);
       
-      m_state.ia.vertexBuffers[StartSlot + i].buffer = newBuffer;
-      m_state.ia.vertexBuffers[StartSlot + i].offset = pOffsets[i];
-      m_state.ia.vertexBuffers[StartSlot + i].stride = pStrides[i];
+      D3D11VertexBufferBinding& binding = m_state.ia.vertexBuffers[StartSlot + i];
       
-      BindVertexBuffer(StartSlot + i, newBuffer, pOffsets[i], pStrides[i]);
+      if (binding.buffer != newBuffer
+       || binding.offset != pOffsets[i]
+       || binding.stride != pStrides[i]) {
+        binding.buffer = newBuffer;
+        binding.offset = pOffsets[i];
+        binding.stride = pStrides[i];
+        
+        firstChanged = std::min(firstChanged, i);
+        lastChanged  = i;
+      }
+    }
+    
+    if (firstChanged <= lastChanged) {
+      BindVertexBuffers(StartSlot + firstChanged,
+        lastChanged - firstChanged + 1,
+        &m_state.ia.vertexBuffers[StartSlot + firstChanged]);
+    } else {
+      CountRedundantCall(D3D11StateCall::VertexBuffers);
     }
   }
   
@@ -1096,8 +1263,17 @@ namespace dxvk {
           ID3D11Buffer*                     pIndexBuffer,
           DXGI_FORMAT                       Format,
           UINT                              Offset) {
+    D3D11_CS_TAG("IASetIndexBuffer");
+    
     auto newBuffer = static_cast<D3D11Buffer*>(pIndexBuffer);
     
+    if (m_state.ia.indexBuffer.buffer == newBuffer
+     && m_state.ia.indexBuffer.offset == Offset
+     && m_state.ia.indexBuffer.format == Format) {
+      CountRedundantCall(D3D11StateCall::IndexBuffer);
+      return;
+    }
+    
     m_state.ia.indexBuffer.buffer = newBuffer;
     m_state.ia.indexBuffer.offset = Offset;
     m_state.ia.indexBuffer.format = Format;
@@ -1154,6 +1330,8 @@ namespace dxvk {
           ID3D11VertexShader*               pVertexShader,
           ID3D11ClassInstance* const*       ppClassInstances,
           UINT                              NumClassInstances) {
+    D3D11_CS_TAG("VSSetShader");
+    
     auto shader = static_cast<D3D11VertexShader*>(pVertexShader);
     
     if (NumClassInstances != 0)
@@ -1162,6 +1340,8 @@ namespace dxvk {
     if (m_state.vs.shader != shader) {
       m_state.vs.shader = shader;
       BindShader(shader, VK_SHADER_STAGE_VERTEX_BIT);
+    } else {
+      CountRedundantCall(D3D11StateCall::Shader);
     }
   }
   
@@ -1170,6 +1350,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumBuffers,
           ID3D11Buffer* const*              ppConstantBuffers) {
+    D3D11_CS_TAG("VSSetConstantBuffers");
+    
     SetConstantBuffers(
       DxbcProgramType::VertexShader,
       m_state.vs.constantBuffers,
@@ -1185,6 +1367,8 @@ namespace dxvk {
           ID3D11Buffer* const*              ppConstantBuffers, 
     const UINT*                             pFirstConstant, 
     const UINT*                             pNumConstants) {
+    D3D11_CS_TAG("VSSetConstantBuffers1");
+    
     SetConstantBuffers(
       DxbcProgramType::VertexShader,
       m_state.vs.constantBuffers,
@@ -1199,6 +1383,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumViews,
           ID3D11ShaderResourceView* const*  ppShaderResourceViews) {
+    D3D11_CS_TAG("VSSetShaderResources");
+    
     SetShaderResources(
       DxbcProgramType::VertexShader,
       m_state.vs.shaderResources,
@@ -1211,6 +1397,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumSamplers,
           ID3D11SamplerState* const*        ppSamplers) {
+    D3D11_CS_TAG("VSSetSamplers");
+    
     SetSamplers(
       DxbcProgramType::VertexShader,
       m_state.vs.samplers,
@@ -1280,6 +1468,8 @@ namespace dxvk {
           ID3D11HullShader*                 pHullShader,
           ID3D11ClassInstance* const*       ppClassInstances,
           UINT                              NumClassInstances) {
+    D3D11_CS_TAG("HSSetShader");
+    
     auto shader = static_cast<D3D11HullShader*>(pHullShader);
     
     if (NumClassInstances != 0)
@@ -1288,6 +1478,8 @@ namespace dxvk {
     if (m_state.hs.shader != shader) {
       m_state.hs.shader = shader;
       BindShader(shader, VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT);
+    } else {
+      CountRedundantCall(D3D11StateCall::Shader);
     }
   }
   
@@ -1296,6 +1488,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumViews,
           ID3D11ShaderResourceView* const*  ppShaderResourceViews) {
+    D3D11_CS_TAG("HSSetShaderResources");
+    
     SetShaderResources(
       DxbcProgramType::HullShader,
       m_state.hs.shaderResources,
@@ -1308,6 +1502,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumBuffers,
           ID3D11Buffer* const*              ppConstantBuffers) {
+    D3D11_CS_TAG("HSSetConstantBuffers");
+    
     SetConstantBuffers(
       DxbcProgramType::HullShader,
       m_state.hs.constantBuffers,
@@ -1323,6 +1519,8 @@ namespace dxvk {
           ID3D11Buffer* const*              ppConstantBuffers, 
     const UINT*                             pFirstConstant, 
     const UINT*                             pNumConstants) {
+    D3D11_CS_TAG("HSSetConstantBuffers1");
+    
     SetConstantBuffers(
       DxbcProgramType::HullShader,
       m_state.hs.constantBuffers,
@@ -1337,6 +1535,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumSamplers,
           ID3D11SamplerState* const*        ppSamplers) {
+    D3D11_CS_TAG("HSSetSamplers");
+    
     SetSamplers(
       DxbcProgramType::HullShader,
       m_state.hs.samplers,
@@ -1406,6 +1606,8 @@ namespace dxvk {
           ID3D11DomainShader*               pDomainShader,
           ID3D11ClassInstance* const*       ppClassInstances,
           UINT                              NumClassInstances) {
+    D3D11_CS_TAG("DSSetShader");
+    
     auto shader = static_cast<D3D11DomainShader*>(pDomainShader);
     
     if (NumClassInstances != 0)
@@ -1414,6 +1616,8 @@ namespace dxvk {
     if (m_state.ds.shader != shader) {
       m_state.ds.shader = shader;
       BindShader(shader, VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT);
+    } else {
+      CountRedundantCall(D3D11StateCall::Shader);
     }
   }
   
@@ -1422,6 +1626,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumViews,
           ID3D11ShaderResourceView* const*  ppShaderResourceViews) {
+    D3D11_CS_TAG("DSSetShaderResources");
+    
     SetShaderResources(
       DxbcProgramType::DomainShader,
       m_state.ds.shaderResources,
@@ -1434,6 +1640,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumBuffers,
           ID3D11Buffer* const*              ppConstantBuffers) {
+    D3D11_CS_TAG("DSSetConstantBuffers");
+    
     SetConstantBuffers(
       DxbcProgramType::DomainShader,
       m_state.ds.constantBuffers,
@@ -1449,6 +1657,8 @@ namespace dxvk {
           ID3D11Buffer* const*              ppConstantBuffers,
     const UINT*                             pFirstConstant,
     const UINT*                             pNumConstants) {
+    D3D11_CS_TAG("DSSetConstantBuffers1");
+    
     SetConstantBuffers(
       DxbcProgramType::DomainShader,
       m_state.ds.constantBuffers,
@@ -1463,6 +1673,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumSamplers,
           ID3D11SamplerState* const*        ppSamplers) {
+    D3D11_CS_TAG("DSSetSamplers");
+    
     SetSamplers(
       DxbcProgramType::DomainShader,
       m_state.ds.samplers,
@@ -1532,6 +1744,8 @@ namespace dxvk {
           ID3D11GeometryShader*             pShader,
           ID3D11ClassInstance* const*       ppClassInstances,
           UINT                              NumClassInstances) {
+    D3D11_CS_TAG("GSSetShader");
+    
     auto shader = static_cast<D3D11GeometryShader*>(pShader);
     
     if (NumClassInstances != 0)
@@ -1540,6 +1754,8 @@ namespace dxvk {
     if (m_state.gs.shader != shader) {
       m_state.gs.shader = shader;
       BindShader(shader, VK_SHADER_STAGE_GEOMETRY_BIT);
+    } else {
+      CountRedundantCall(D3D11StateCall::Shader);
     }
   }
   
@@ -1548,6 +1764,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumBuffers,
           ID3D11Buffer* const*              ppConstantBuffers) {
+    D3D11_CS_TAG("GSSetConstantBuffers");
+    
     SetConstantBuffers(
       DxbcProgramType::GeometryShader,
       m_state.gs.constantBuffers,
@@ -1577,6 +1795,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumViews,
           ID3D11ShaderResourceView* const*  ppShaderResourceViews) {
+    D3D11_CS_TAG("GSSetShaderResources");
+    
     SetShaderResources(
       DxbcProgramType::GeometryShader,
       m_state.gs.shaderResources,
@@ -1589,6 +1809,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumSamplers,
           ID3D11SamplerState* const*        ppSamplers) {
+    D3D11_CS_TAG("GSSetSamplers");
+    
     SetSamplers(
       DxbcProgramType::GeometryShader,
       m_state.gs.samplers,
@@ -1658,6 +1880,8 @@ namespace dxvk {
           ID3D11PixelShader*                pPixelShader,
           ID3D11ClassInstance* const*       ppClassInstances,
           UINT                              NumClassInstances) {
+    D3D11_CS_TAG("PSSetShader");
+    
     auto shader = static_cast<D3D11PixelShader*>(pPixelShader);
     
     if (NumClassInstances != 0)
@@ -1666,6 +1890,8 @@ namespace dxvk {
     if (m_state.ps.shader != shader) {
       m_state.ps.shader = shader;
       BindShader(shader, VK_SHADER_STAGE_FRAGMENT_BIT);
+    } else {
+      CountRedundantCall(D3D11StateCall::Shader);
     }
   }
   
@@ -1674,6 +1900,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumBuffers,
           ID3D11Buffer* const*              ppConstantBuffers) {
+    D3D11_CS_TAG("PSSetConstantBuffers");
+    
     SetConstantBuffers(
       DxbcProgramType::PixelShader,
       m_state.ps.constantBuffers,
@@ -1703,6 +1931,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumViews,
           ID3D11ShaderResourceView* const*  ppShaderResourceViews) {
+    D3D11_CS_TAG("PSSetShaderResources");
+    
     SetShaderResources(
       DxbcProgramType::PixelShader,
       m_state.ps.shaderResources,
@@ -1715,6 +1945,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumSamplers,
           ID3D11SamplerState* const*        ppSamplers) {
+    D3D11_CS_TAG("PSSetSamplers");
+    
     SetSamplers(
       DxbcProgramType::PixelShader,
       m_state.ps.samplers,
@@ -1784,6 +2016,8 @@ namespace dxvk {
           ID3D11ComputeShader*              pComputeShader,
           ID3D11ClassInstance* const*       ppClassInstances,
           UINT                              NumClassInstances) {
+    D3D11_CS_TAG("CSSetShader");
+    
     auto shader = static_cast<D3D11ComputeShader*>(pComputeShader);
     
     if (NumClassInstances != 0)
@@ -1792,6 +2026,8 @@ namespace dxvk {
     if (m_state.cs.shader != shader) {
       m_state.cs.shader = shader;
       BindShader(shader, VK_SHADER_STAGE_COMPUTE_BIT);
+    } else {
+      CountRedundantCall(D3D11StateCall::Shader);
     }
   }
   
@@ -1800,6 +2036,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumBuffers,
           ID3D11Buffer* const*              ppConstantBuffers) {
+    D3D11_CS_TAG("CSSetConstantBuffers");
+    
     SetConstantBuffers(
       DxbcProgramType::ComputeShader,
       m_state.cs.constantBuffers,
@@ -1815,6 +2053,8 @@ namespace dxvk {
           ID3D11Buffer* const*              ppConstantBuffers, 
     const UINT*                             pFirstConstant, 
     const UINT*                             pNumConstants) {
+    D3D11_CS_TAG("CSSetConstantBuffers1");
+    
     SetConstantBuffers(
       DxbcProgramType::ComputeShader,
       m_state.cs.constantBuffers,
@@ -1829,6 +2069,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumViews,
           ID3D11ShaderResourceView* const*  ppShaderResourceViews) {
+    D3D11_CS_TAG("CSSetShaderResources");
+    
     SetShaderResources(
       DxbcProgramType::ComputeShader,
       m_state.cs.shaderResources,
@@ -1841,6 +2083,8 @@ namespace dxvk {
           UINT                              StartSlot,
           UINT                              NumSamplers,
           ID3D11SamplerState* const*        ppSamplers) {
+    D3D11_CS_TAG("CSSetSamplers");
+    
     SetSamplers(
       DxbcProgramType::ComputeShader,
       m_state.cs.samplers,
@@ -1854,6 +2098,8 @@ namespace dxvk {
           UINT                              NumUAVs,
           ID3D11UnorderedAccessView* const* ppUnorderedAccessViews,
     const UINT*                             pUAVInitialCounts) {
+    D3D11_CS_TAG("CSSetUnorderedAccessViews");
+    
     SetUnorderedAccessViews(
       DxbcProgramType::ComputeShader,
       m_state.cs.unorderedAccessViews,
@@ -1938,18 +2184,35 @@ namespace dxvk {
           UINT                              NumViews,
           ID3D11RenderTargetView* const*    ppRenderTargetViews,
           ID3D11DepthStencilView*           pDepthStencilView) {
+    D3D11_CS_TAG("OMSetRenderTargets");
+    
+    bool changed = false;
+    
     for (UINT i = 0; i < m_state.om.renderTargetViews.size(); i++) {
       D3D11RenderTargetView* view = nullptr;
       
       if ((i < NumViews) && (ppRenderTargetViews[i] != nullptr))
         view = static_cast<D3D11RenderTargetView*>(ppRenderTargetViews[i]);
       
-      m_state.om.renderTargetViews.at(i) = view;
+      if (m_state.om.renderTargetViews.at(i) != view) {
+        m_state.om.renderTargetViews.at(i) = view;
+        changed = true;
+      }
     }
     
-    m_state.om.depthStencilView = static_cast<D3D11DepthStencilView*>(pDepthStencilView);
+    auto dsv = static_cast<D3D11DepthStencilView*>(pDepthStencilView);
     
-    BindFramebuffer();
+    if (m_state.om.depthStencilView != dsv) {
+      m_state.om.depthStencilView = dsv;
+      changed = true;
+    }
+    
+    // Rebinding the same framebuffer would still end
+    // the current render pass on the DXVK side
+    if (changed)
+      BindFramebuffer();
+    else
+      CountRedundantCall(D3D11StateCall::RenderTargets);
   }
   
   
@@ -1961,6 +2224,8 @@ namespace dxvk {
           UINT                              NumUAVs,
           ID3D11UnorderedAccessView* const* ppUnorderedAccessViews,
     const UINT*                             pUAVInitialCounts) {
+    D3D11_CS_TAG("OMSetRenderTargetsAndUnorderedAccessViews");
+    
     if (NumRTVs != D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL)
       OMSetRenderTargets(NumRTVs, ppRenderTargetViews, pDepthStencilView);
     
@@ -1987,6 +2252,8 @@ namespace dxvk {
           ID3D11BlendState*                 pBlendState,
     const FLOAT                             BlendFactor[4],
           UINT                              SampleMask) {
+    D3D11_CS_TAG("OMSetBlendState");
+    
     auto blendState = static_cast<D3D11BlendState*>(pBlendState);
     
     if (m_state.om.cbState    != blendState
@@ -1995,13 +2262,19 @@ namespace dxvk {
       m_state.om.sampleMask = SampleMask;
       
       ApplyBlendState();
+    } else {
+      CountRedundantCall(D3D11StateCall::BlendState);
     }
     
     if (BlendFactor != nullptr) {
-      for (uint32_t i = 0; i < 4; i++)
-        m_state.om.blendFactor[i] = BlendFactor[i];
-      
-      ApplyBlendFactor();
+      if (std::memcmp(m_state.om.blendFactor, BlendFactor, sizeof(FLOAT) * 4)) {
+        for (uint32_t i = 0; i < 4; i++)
+          m_state.om.blendFactor[i] = BlendFactor[i];
+        
+        ApplyBlendFactor();
+      } else {
+        CountRedundantCall(D3D11StateCall::BlendFactor);
+      }
     }
   }
   
@@ -2009,16 +2282,22 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeviceContext::OMSetDepthStencilState(
           ID3D11DepthStencilState*          pDepthStencilState,
           UINT                              StencilRef) {
+    D3D11_CS_TAG("OMSetDepthStencilState");
+    
     auto depthStencilState = static_cast<D3D11DepthStencilState*>(pDepthStencilState);
     
     if (m_state.om.dsState != depthStencilState) {
       m_state.om.dsState = depthStencilState;
       ApplyDepthStencilState();
+    } else {
+      CountRedundantCall(D3D11StateCall::DepthStencilState);
     }
     
     if (m_state.om.stencilRef != StencilRef) {
       m_state.om.stencilRef = StencilRef;
       ApplyStencilRef();
+    } else {
+      CountRedundantCall(D3D11StateCall::StencilRef);
     }
   }
   
@@ -2080,6 +2359,8 @@ namespace dxvk {
   
   
   void STDMETHODCALLTYPE D3D11DeviceContext::RSSetState(ID3D11RasterizerState* pRasterizerState) {
+    D3D11_CS_TAG("RSSetState");
+    
     auto rasterizerState = static_cast<D3D11RasterizerState*>(pRasterizerState);
     
     if (m_state.rs.state != rasterizerState) {
@@ -2090,6 +2371,8 @@ namespace dxvk {
       // scissor rectangles as well.
       ApplyRasterizerState();
       ApplyViewportState();
+    } else {
+      CountRedundantCall(D3D11StateCall::RasterizerState);
     }
   }
   
@@ -2097,6 +2380,14 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeviceContext::RSSetViewports(
           UINT                              NumViewports,
     const D3D11_VIEWPORT*                   pViewports) {
+    D3D11_CS_TAG("RSSetViewports");
+    
+    if (m_state.rs.numViewports == NumViewports
+     && !std::memcmp(m_state.rs.viewports.data(), pViewports, sizeof(D3D11_VIEWPORT) * NumViewports)) {
+      CountRedundantCall(D3D11StateCall::Viewports);
+      return;
+    }
+    
     m_state.rs.numViewports = NumViewports;
     
     for (uint32_t i = 0; i < NumViewports; i++)
@@ -2109,6 +2400,14 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeviceContext::RSSetScissorRects(
           UINT                              NumRects,
     const D3D11_RECT*                       pRects) {
+    D3D11_CS_TAG("RSSetScissorRects");
+    
+    if (m_state.rs.numScissors == NumRects
+     && !std::memcmp(m_state.rs.scissors.data(), pRects, sizeof(D3D11_RECT) * NumRects)) {
+      CountRedundantCall(D3D11StateCall::ScissorRects);
+      return;
+    }
+    
     m_state.rs.numScissors = NumRects;
     
     for (uint32_t i = 0; i < NumRects; i++)
@@ -2415,17 +2714,44 @@ namespace dxvk {
   }
   
   
-  void D3D11DeviceContext::BindVertexBuffer(
-          UINT                              Slot,
-          D3D11Buffer*                      pBuffer,
-          UINT                              Offset,
-          UINT                              Stride) {
+  void D3D11DeviceContext::DiscardImage(
+    const Rc<DxvkImage>&                    Image,
+    const VkImageSubresourceRange&          Subresources) {
     EmitCs([
-      cSlotId       = Slot,
-      cBufferSlice  = pBuffer != nullptr ? pBuffer->GetBufferSlice(Offset) : DxvkBufferSlice(),
-      cStride       = pBuffer != nullptr ? Stride                          : 0
+      cImage        = Image,
+      cSubresources = Subresources
     ] (DxvkContext* ctx) {
-      ctx->bindVertexBuffer(cSlotId, cBufferSlice, cStride);
+      ctx->discardImage(cImage, cSubresources);
+    });
+  }
+  
+  
+  void D3D11DeviceContext::BindVertexBuffers(
+          UINT                              StartSlot,
+          UINT                              NumBuffers,
+    const D3D11VertexBufferBinding*         pBindings) {
+    EmitCsBatch(NumBuffers, [=] (auto batchSize) {
+      std::array<DxvkBufferSlice, decltype(batchSize)::value> bufferSlices;
+      std::array<uint32_t,        decltype(batchSize)::value> strides;
+      
+      for (uint32_t i = 0; i < NumBuffers; i++) {
+        const D3D11VertexBufferBinding& binding = pBindings[i];
+        
+        bufferSlices[i] = binding.buffer != nullptr
+          ? binding.buffer->GetBufferSlice(binding.offset)
+          : DxvkBufferSlice();
+        strides[i] = binding.buffer != nullptr ? binding.stride : 0;
+      }
+      
+      return [
+        cSlotId       = StartSlot,
+        cCount        = NumBuffers,
+        cBufferSlices = std::move(bufferSlices),
+        cStrides      = strides
+      ] (DxvkContext* ctx) {
+        ctx->bindVertexBuffers(cSlotId, cCount,
+          cBufferSlices.data(), cStrides.data());
+      };
     });
   }
   
@@ -2455,60 +2781,114 @@ namespace dxvk {
   }
   
   
-  void D3D11DeviceContext::BindConstantBuffer(
+  void D3D11DeviceContext::BindConstantBuffers(
           UINT                              Slot,
-    const D3D11ConstantBufferBinding*       pBufferBinding) {
-    EmitCs([
-      cSlotId      = Slot,
-      cBufferSlice = pBufferBinding->buffer != nullptr
-        ? pBufferBinding->buffer->GetBufferSlice(
-            pBufferBinding->constantOffset * 16,
-            pBufferBinding->constantCount  * 16)
-        : DxvkBufferSlice()
-    ] (DxvkContext* ctx) {
-      ctx->bindResourceBuffer(cSlotId, cBufferSlice);
+          UINT                              NumBuffers,
+    const D3D11ConstantBufferBinding*       pBindings) {
+    EmitCsBatch(NumBuffers, [=] (auto batchSize) {
+      std::array<DxvkBufferSlice, decltype(batchSize)::value> bufferSlices;
+      
+      for (uint32_t i = 0; i < NumBuffers; i++) {
+        const D3D11ConstantBufferBinding& binding = pBindings[i];
+        
+        if (binding.buffer != nullptr) {
+          bufferSlices[i] = binding.buffer->GetBufferSlice(
+            binding.constantOffset * 16,
+            binding.constantCount  * 16);
+        }
+      }
+      
+      return [
+        cSlotId       = Slot,
+        cCount        = NumBuffers,
+        cBufferSlices = std::move(bufferSlices)
+      ] (DxvkContext* ctx) {
+        ctx->bindResourceBuffers(cSlotId, cCount, cBufferSlices.data());
+      };
     });
   }
   
   
-  void D3D11DeviceContext::BindSampler(
+  void D3D11DeviceContext::BindSamplers(
           UINT                              Slot,
-          D3D11SamplerState*                pSampler) {
-    EmitCs([
-      cSlotId   = Slot,
-      cSampler  = pSampler != nullptr ? pSampler->GetDXVKSampler() : nullptr
-    ] (DxvkContext* ctx) {
-      ctx->bindResourceSampler(cSlotId, cSampler);
+          UINT                              NumSamplers,
+    const Com<D3D11SamplerState>*           ppSamplers) {
+    EmitCsBatch(NumSamplers, [=] (auto batchSize) {
+      std::array<Rc<DxvkSampler>, decltype(batchSize)::value> samplers;
+      
+      for (uint32_t i = 0; i < NumSamplers; i++) {
+        if (ppSamplers[i] != nullptr)
+          samplers[i] = ppSamplers[i]->GetDXVKSampler();
+      }
+      
+      return [
+        cSlotId   = Slot,
+        cCount    = NumSamplers,
+        cSamplers = std::move(samplers)
+      ] (DxvkContext* ctx) {
+        ctx->bindResourceSamplers(cSlotId, cCount, cSamplers.data());
+      };
     });
   }
   
   
-  void D3D11DeviceContext::BindShaderResource(
+  void D3D11DeviceContext::BindShaderResources(
           UINT                              Slot,
-          D3D11ShaderResourceView*          pResource) {
-    EmitCs([
-      cSlotId     = Slot,
-      cImageView  = pResource != nullptr ? pResource->GetImageView()  : nullptr,
-      cBufferView = pResource != nullptr ? pResource->GetBufferView() : nullptr
-    ] (DxvkContext* ctx) {
-      ctx->bindResourceView(cSlotId, cImageView, cBufferView);
+          UINT                              NumResources,
+    const Com<D3D11ShaderResourceView>*     ppResources) {
+    EmitCsBatch(NumResources, [=] (auto batchSize) {
+      std::array<Rc<DxvkImageView>,  decltype(batchSize)::value> imageViews;
+      std::array<Rc<DxvkBufferView>, decltype(batchSize)::value> bufferViews;
+      
+      for (uint32_t i = 0; i < NumResources; i++) {
+        if (ppResources[i] != nullptr) {
+          imageViews [i] = ppResources[i]->GetImageView();
+          bufferViews[i] = ppResources[i]->GetBufferView();
+        }
+      }
+      
+      return [
+        cSlotId      = Slot,
+        cCount       = NumResources,
+        cImageViews  = std::move(imageViews),
+        cBufferViews = std::move(bufferViews)
+      ] (DxvkContext* ctx) {
+        ctx->bindResourceViews(cSlotId, cCount,
+          cImageViews.data(), cBufferViews.data());
+      };
     });
   }
   
   
-  void D3D11DeviceContext::BindUnorderedAccessView(
+  void D3D11DeviceContext::BindUnorderedAccessViews(
           UINT                              UavSlot,
           UINT                              CtrSlot,
-          D3D11UnorderedAccessView*         pUav) {
-    EmitCs([
-      cUavSlotId    = UavSlot,
-      cCtrSlotId    = CtrSlot,
-      cImageView    = pUav != nullptr ? pUav->GetImageView()    : nullptr,
-      cBufferView   = pUav != nullptr ? pUav->GetBufferView()   : nullptr,
-      cCounterSlice = pUav != nullptr ? pUav->GetCounterSlice() : DxvkBufferSlice()
-    ] (DxvkContext* ctx) {
-      ctx->bindResourceView   (cUavSlotId, cImageView, cBufferView);
-      ctx->bindResourceBuffer (cCtrSlotId, cCounterSlice);
+          UINT                              NumUAVs,
+    const Com<D3D11UnorderedAccessView>*    ppUavs) {
+    EmitCsBatch(NumUAVs, [=] (auto batchSize) {
+      std::array<Rc<DxvkImageView>,  decltype(batchSize)::value> imageViews;
+      std::array<Rc<DxvkBufferView>, decltype(batchSize)::value> bufferViews;
+      std::array<DxvkBufferSlice,    decltype(batchSize)::value> counterSlices;
+      
+      for (uint32_t i = 0; i < NumUAVs; i++) {
+        if (ppUavs[i] != nullptr) {
+          imageViews   [i] = ppUavs[i]->GetImageView();
+          bufferViews  [i] = ppUavs[i]->GetBufferView();
+          counterSlices[i] = ppUavs[i]->GetCounterSlice();
+        }
+      }
+      
+      return [
+        cUavSlotId     = UavSlot,
+        cCtrSlotId     = CtrSlot,
+        cCount         = NumUAVs,
+        cImageViews    = std::move(imageViews),
+        cBufferViews   = std::move(bufferViews),
+        cCounterSlices = std::move(counterSlices)
+      ] (DxvkContext* ctx) {
+        ctx->bindResourceViews  (cUavSlotId, cCount, cImageViews.data(), cBufferViews.data());
+        ctx->bindResourceBuffers(cCtrSlotId, cCount, cCounterSlices.data());
+      };
     });
   }
   
@@ -2522,8 +2902,10 @@ namespace dxvk {
     const UINT*                             pFirstConstant,
     const UINT*                             pNumConstants) {
     const uint32_t slotId = computeResourceSlotId(
-      ShaderStage, DxbcBindingType::ConstantBuffer,
-      StartSlot);
+      ShaderStage, DxbcBindingType::ConstantBuffer, 0);
+    
+    uint32_t firstChanged = NumBuffers;
+    uint32_t lastChanged  = 0;
     
     for (uint32_t i = 0; i < NumBuffers; i++) {
       auto newBuffer = static_cast<D3D11Buffer*>(ppConstantBuffers[i]);
@@ -2545,9 +2927,17 @@ namespace dxvk {
         Bindings[StartSlot + i].constantOffset = constantOffset;
         Bindings[StartSlot + i].constantCount  = constantCount;
         
-        BindConstantBuffer(slotId + i, &Bindings[StartSlot + i]);
+        firstChanged = std::min(firstChanged, i);
+        lastChanged  = i;
       }
     }
+    
+    if (firstChanged <= lastChanged) {
+      BindConstantBuffers(slotId + StartSlot + firstChanged,
+        lastChanged - firstChanged + 1, &Bindings[StartSlot + firstChanged]);
+    } else {
+      CountRedundantCall(D3D11StateCall::ConstantBuffers);
+    }
   }
   
   
@@ -2558,17 +2948,28 @@ namespace dxvk {
           UINT                              NumSamplers,
           ID3D11SamplerState* const*        ppSamplers) {
     const uint32_t slotId = computeResourceSlotId(
-      ShaderStage, DxbcBindingType::ImageSampler,
-      StartSlot);
+      ShaderStage, DxbcBindingType::ImageSampler, 0);
+    
+    uint32_t firstChanged = NumSamplers;
+    uint32_t lastChanged  = 0;
     
     for (uint32_t i = 0; i < NumSamplers; i++) {
       auto sampler = static_cast<D3D11SamplerState*>(ppSamplers[i]);
       
       if (Bindings[StartSlot + i] != sampler) {
         Bindings[StartSlot + i] = sampler;
-        BindSampler(slotId + i, sampler);
+        
+        firstChanged = std::min(firstChanged, i);
+        lastChanged  = i;
       }
     }
+    
+    if (firstChanged <= lastChanged) {
+      BindSamplers(slotId + StartSlot + firstChanged,
+        lastChanged - firstChanged + 1, &Bindings[StartSlot + firstChanged]);
+    } else {
+      CountRedundantCall(D3D11StateCall::Samplers);
+    }
   }
   
   
@@ -2579,17 +2980,28 @@ namespace dxvk {
           UINT                              NumResources,
           ID3D11ShaderResourceView* const*  ppResources) {
     const uint32_t slotId = computeResourceSlotId(
-      ShaderStage, DxbcBindingType::ShaderResource,
-      StartSlot);
+      ShaderStage, DxbcBindingType::ShaderResource, 0);
+    
+    uint32_t firstChanged = NumResources;
+    uint32_t lastChanged  = 0;
     
     for (uint32_t i = 0; i < NumResources; i++) {
       auto resView = static_cast<D3D11ShaderResourceView*>(ppResources[i]);
       
       if (Bindings[StartSlot + i] != resView) {
         Bindings[StartSlot + i] = resView;
-        BindShaderResource(slotId + i, resView);
+        
+        firstChanged = std::min(firstChanged, i);
+        lastChanged  = i;
       }
     }
+    
+    if (firstChanged <= lastChanged) {
+      BindShaderResources(slotId + StartSlot + firstChanged,
+        lastChanged - firstChanged + 1, &Bindings[StartSlot + firstChanged]);
+    } else {
+      CountRedundantCall(D3D11StateCall::ShaderResources);
+    }
   }
   
   
@@ -2600,21 +3012,34 @@ namespace dxvk {
           UINT                              NumUAVs,
           ID3D11UnorderedAccessView* const* ppUnorderedAccessViews) {
     const uint32_t uavSlotId = computeResourceSlotId(
-      ShaderStage, DxbcBindingType::UnorderedAccessView,
-      StartSlot);
+      ShaderStage, DxbcBindingType::UnorderedAccessView, 0);
     
     const uint32_t ctrSlotId = computeResourceSlotId(
-      ShaderStage, DxbcBindingType::UavCounter,
-      StartSlot);
+      ShaderStage, DxbcBindingType::UavCounter, 0);
+    
+    uint32_t firstChanged = NumUAVs;
+    uint32_t lastChanged  = 0;
     
     for (uint32_t i = 0; i < NumUAVs; i++) {
       auto uav = static_cast<D3D11UnorderedAccessView*>(ppUnorderedAccessViews[i]);
       
       if (Bindings[StartSlot + i] != uav) {
         Bindings[StartSlot + i] = uav;
-        BindUnorderedAccessView(uavSlotId + i, ctrSlotId + i, uav);
+        
+        firstChanged = std::min(firstChanged, i);
+        lastChanged  = i;
       }
     }
+    
+    if (firstChanged <= lastChanged) {
+      BindUnorderedAccessViews(
+        uavSlotId + StartSlot + firstChanged,
+        ctrSlotId + StartSlot + firstChanged,
+        lastChanged - firstChanged + 1,
+        &Bindings[StartSlot + firstChanged]);
+    } else {
+      CountRedundantCall(D3D11StateCall::UnorderedAccessViews);
+    }
   }
   
   
@@ -2688,12 +3113,9 @@ namespace dxvk {
       m_state.ia.indexBuffer.offset,
       m_state.ia.indexBuffer.format);
     
-    for (uint32_t i = 0; i < m_state.ia.vertexBuffers.size(); i++) {
-      BindVertexBuffer(i,
-        m_state.ia.vertexBuffers[i].buffer.ptr(),
-        m_state.ia.vertexBuffers[i].offset,
-        m_state.ia.vertexBuffers[i].stride);
-    }
+    BindVertexBuffers(0,
+      m_state.ia.vertexBuffers.size(),
+      m_state.ia.vertexBuffers.data());
     
     RestoreConstantBuffers(DxbcProgramType::VertexShader,   m_state.vs.constantBuffers);
     RestoreConstantBuffers(DxbcProgramType::HullShader,     m_state.hs.constantBuffers);
@@ -2727,8 +3149,7 @@ namespace dxvk {
     const uint32_t slotId = computeResourceSlotId(
       Stage, DxbcBindingType::ConstantBuffer, 0);
     
-    for (uint32_t i = 0; i < Bindings.size(); i++)
-      BindConstantBuffer(slotId + i, &Bindings[i]);
+    BindConstantBuffers(slotId, Bindings.size(), Bindings.data());
   }
   
   
@@ -2738,8 +3159,7 @@ namespace dxvk {
     const uint32_t slotId = computeResourceSlotId(
       Stage, DxbcBindingType::ImageSampler, 0);
     
-    for (uint32_t i = 0; i < Bindings.size(); i++)
-      BindSampler(slotId + i, Bindings[i].ptr());
+    BindSamplers(slotId, Bindings.size(), Bindings.data());
   }
   
   
@@ -2749,8 +3169,7 @@ namespace dxvk {
     const uint32_t slotId = computeResourceSlotId(
       Stage, DxbcBindingType::ShaderResource, 0);
     
-    for (uint32_t i = 0; i < Bindings.size(); i++)
-      BindShaderResource(slotId + i, Bindings[i].ptr());
+    BindShaderResources(slotId, Bindings.size(), Bindings.data());
   }
   
   
@@ -2763,11 +3182,8 @@ namespace dxvk {
     const uint32_t ctrSlotId = computeResourceSlotId(
       Stage, DxbcBindingType::UavCounter, 0);
     
-    for (uint32_t i = 0; i < Bindings.size(); i++) {
-      BindUnorderedAccessView(
-        uavSlotId + i, ctrSlotId + i,
-        Bindings[i].ptr());
-    }
+    BindUnorderedAccessViews(uavSlotId, ctrSlotId,
+      Bindings.size(), Bindings.data());
   }
   
   
@@ -2792,4 +3208,42 @@ namespace dxvk {
     }
   }
   
+  
+  void D3D11DeviceContext::LogRedundantCalls() const {
+    static const std::array<const char*, uint32_t(D3D11StateCall::Count)> names = {{
+      "Input layout",
+      "Primitive topology",
+      "Vertex buffers",
+      "Index buffer",
+      "Shaders",
+      "Constant buffers",
+      "Shader resources",
+      "Samplers",
+      "Unordered access views",
+      "Render targets",
+      "Blend state",
+      "Blend factor",
+      "Depth-stencil state",
+      "Stencil reference",
+      "Rasterizer state",
+      "Viewports",
+      "Scissor rects",
+    }};
+    
+    uint64_t total = 0;
+    
+    for (uint64_t count : m_redundantCalls)
+      total += count;
+    
+    if (total == 0)
+      return;
+    
+    Logger::debug(str::format("D3D11DeviceContext: ", total, " redundant state calls filtered"));
+    
+    for (uint32_t i = 0; i < m_redundantCalls.size(); i++) {
+      if (m_redundantCalls[i] != 0)
+        Logger::debug(str::format("  ", names[i], ": ", m_redundantCalls[i]));
+    }
+  }
+  
 }
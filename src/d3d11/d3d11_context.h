@@ -7,10 +7,50 @@
 #include "d3d11_context_state.h"
 #include "d3d11_device_child.h"
 
+/**
+ * \brief Tags CS commands with an API call
+ * 
+ * Used at the top of API entry points so that all
+ * commands emitted by the call, including the ones
+ * emitted by internal helpers, are attributed to it
+ * in the CS thread statistics.
+ */
+#define D3D11_CS_TAG(name) \
+  dxvk::D3D11CsTagScope d3d11CsTagScope(m_csTag, name)
+
 namespace dxvk {
   
   class D3D11Device;
   
+  /**
+   * \brief CS command tag scope
+   * 
+   * Sets the context's current command tag for the
+   * lifetime of the scope. If an outer API call has
+   * already set a tag, as is the case when an entry
+   * point calls another one, the outer tag is kept.
+   */
+  class D3D11CsTagScope {
+    
+  public:
+    
+    D3D11CsTagScope(const char*& tag, const char* name)
+    : m_tag(tag), m_prev(tag) {
+      if (m_prev == nullptr)
+        m_tag = name;
+    }
+    
+    ~D3D11CsTagScope() {
+      m_tag = m_prev;
+    }
+    
+  private:
+    
+    const char*& m_tag;
+    const char*  m_prev;
+    
+  };
+  
   class D3D11DeviceContext : public D3D11DeviceChild<ID3D11DeviceContext1> {
     
   public:
@@ -641,6 +681,7 @@ namespace dxvk {
     
     Rc<DxvkDevice>              m_device;
     Rc<DxvkCsChunk>             m_csChunk;
+    const char*                 m_csTag = nullptr;
     Rc<DxvkDataBuffer>          m_updateBuffer;
     
     Com<D3D11BlendState>        m_defaultBlendState;
@@ -650,6 +691,22 @@ namespace dxvk {
     D3D11ContextState           m_state;
     UINT                        m_drawCount = 0;
     
+    D3D11StateCallCounters      m_redundantCalls = { };
+    
+    /**
+     * \brief Counts a redundant state setter call
+     * 
+     * Called whenever a setter does not emit any
+     * commands because the new state is identical
+     * to the current state.
+     * \param [in] Call The state setter category
+     */
+    void CountRedundantCall(D3D11StateCall Call) {
+      m_redundantCalls[uint32_t(Call)] += 1;
+    }
+    
+    void LogRedundantCalls() const;
+    
     void ApplyInputLayout();
     
     void ApplyPrimitiveTopology();
@@ -668,6 +725,10 @@ namespace dxvk {
     
     void BindFramebuffer();
     
+    void DiscardImage(
+      const Rc<DxvkImage>&                    Image,
+      const VkImageSubresourceRange&          Subresources);
+    
     template<typename T>
     void BindShader(
             T*                                pShader,
@@ -680,33 +741,36 @@ namespace dxvk {
       });
     }
     
-    void BindVertexBuffer(
-            UINT                              Slot,
-            D3D11Buffer*                      pBuffer,
-            UINT                              Offset,
-            UINT                              Stride);
+    void BindVertexBuffers(
+            UINT                              StartSlot,
+            UINT                              NumBuffers,
+      const D3D11VertexBufferBinding*         pBindings);
     
     void BindIndexBuffer(
             D3D11Buffer*                      pBuffer,
             UINT                              Offset,
             DXGI_FORMAT                       Format);
     
-    void BindConstantBuffer(
+    void BindConstantBuffers(
             UINT                              Slot,
-      const D3D11ConstantBufferBinding*       pBufferBinding);
+            UINT                              NumBuffers,
+      const D3D11ConstantBufferBinding*       pBindings);
     
-    void BindSampler(
+    void BindSamplers(
             UINT                              Slot,
-            D3D11SamplerState*                pSampler);
+            UINT                              NumSamplers,
+      const Com<D3D11SamplerState>*           ppSamplers);
     
-    void BindShaderResource(
+    void BindShaderResources(
             UINT                              Slot,
-            D3D11ShaderResourceView*          pResource);
+            UINT                              NumResources,
+      const Com<D3D11ShaderResourceView>*     ppResources);
     
-    void BindUnorderedAccessView(
+    void BindUnorderedAccessViews(
             UINT                              UavSlot,
             UINT                              CtrSlot,
-            D3D11UnorderedAccessView*         pUav);
+            UINT                              NumUAVs,
+      const Com<D3D11UnorderedAccessView>*    ppUavs);
     
     void SetConstantBuffers(
             DxbcProgramType                   ShaderStage,
@@ -773,14 +837,33 @@ namespace dxvk {
     
     template<typename Cmd>
     void EmitCs(Cmd&& command) {
-      if (!m_csChunk->push(command)) {
+      if (!m_csChunk->push(command, m_csTag)) {
         EmitCsChunk(std::move(m_csChunk));
         
         m_csChunk = new DxvkCsChunk();
-        m_csChunk->push(command);
+        m_csChunk->push(command, m_csTag);
       }
     }
     
+    /**
+     * \brief Emits a command with a variable-size payload
+     * 
+     * CS commands have a fixed size, so the builder is
+     * invoked with the smallest supported batch size
+     * that can hold \c Count entries as a compile-time
+     * constant, and must return the command to emit.
+     * This allows binding a range of slots with a single
+     * command without wasting chunk memory on small ranges.
+     */
+    template<typename Builder>
+    void EmitCsBatch(uint32_t Count, Builder&& builder) {
+      if      (Count <=  1) EmitCs(builder(std::integral_constant<uint32_t,   1>()));
+      else if (Count <=  4) EmitCs(builder(std::integral_constant<uint32_t,   4>()));
+      else if (Count <= 16) EmitCs(builder(std::integral_constant<uint32_t,  16>()));
+      else if (Count <= 64) EmitCs(builder(std::integral_constant<uint32_t,  64>()));
+      else                  EmitCs(builder(std::integral_constant<uint32_t, 128>()));
+    }
+    
     void FlushCsChunk() {
       if (m_csChunk->commandCount() != 0) {
         EmitCsChunk(std::move(m_csChunk));
@@ -31,6 +31,8 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeferredContext::ExecuteCommandList(
           ID3D11CommandList*  pCommandList,
           BOOL                RestoreContextState) {
+    D3D11_CS_TAG("ExecuteCommandList");
+    
     FlushCsChunk();
     
     static_cast<D3D11CommandList*>(pCommandList)->EmitToCommandList(m_commandList.ptr());
@@ -45,10 +47,15 @@ namespace dxvk {
   HRESULT STDMETHODCALLTYPE D3D11DeferredContext::FinishCommandList(
           BOOL                RestoreDeferredContextState,
           ID3D11CommandList   **ppCommandList) {
+    D3D11_CS_TAG("FinishCommandList");
+    
     FlushCsChunk();
     
-    if (ppCommandList != nullptr)
+    if (ppCommandList != nullptr) {
+      m_commandList->RecordCommands(m_parent->GetCsRecorder());
       *ppCommandList = m_commandList.ref();
+    }
+    
     m_commandList = CreateCommandList();
     
     if (RestoreDeferredContextState)
@@ -67,6 +74,8 @@ namespace dxvk {
           D3D11_MAP                   MapType,
           UINT                        MapFlags,
           D3D11_MAPPED_SUBRESOURCE*   pMappedResource) {
+    D3D11_CS_TAG("Map");
+    
     D3D11_RESOURCE_DIMENSION resourceDim = D3D11_RESOURCE_DIMENSION_UNKNOWN;
     pResource->GetType(&resourceDim);
     
@@ -121,6 +130,8 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeferredContext::Unmap(
           ID3D11Resource*             pResource,
           UINT                        Subresource) {
+    D3D11_CS_TAG("Unmap");
+    
     D3D11_RESOURCE_DIMENSION resourceDim = D3D11_RESOURCE_DIMENSION_UNKNOWN;
     pResource->GetType(&resourceDim);
     
@@ -9,7 +9,8 @@ namespace dxvk {
     D3D11Device*    pParent,
     Rc<DxvkDevice>  Device)
   : D3D11DeviceContext(pParent, Device),
-    m_csThread(Device->createContext()) {
+    m_csThread(Device, Device->createContext()),
+    m_csRecorder(Device, GetCsWorkerCount()) {
     EmitCs([cDevice = m_device] (DxvkContext* ctx) {
       ctx->beginRecording(cDevice->createCommandList());
     });
@@ -46,8 +47,15 @@ namespace dxvk {
   
   
   void STDMETHODCALLTYPE D3D11ImmediateContext::Flush() {
+    DXVK_PROFILE_ZONE("Flush");
+    D3D11_CS_TAG("Flush");
+    
     m_parent->FlushInitContext();
     
+    // Submission must happen on the CS thread's own
+    // context, so it cannot be part of a segment
+    EndCsSegment(true);
+    
     if (m_csIsBusy || m_csChunk->commandCount() != 0) {
       // Add commands to flush the threaded
       // context, then flush the command list
@@ -72,10 +80,14 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11ImmediateContext::ExecuteCommandList(
           ID3D11CommandList*  pCommandList,
           BOOL                RestoreContextState) {
+    DXVK_PROFILE_ZONE("ExecuteCommandList");
+    D3D11_CS_TAG("ExecuteCommandList");
+    
     auto commandList = static_cast<D3D11CommandList*>(pCommandList);
     
     // Flush any outstanding commands so that
     // we don't mess up the execution order
+    EndCsSegment(false);
     FlushCsChunk();
     
     // As an optimization, flush everything if the
@@ -115,6 +127,9 @@ namespace dxvk {
           D3D11_MAP                   MapType,
           UINT                        MapFlags,
           D3D11_MAPPED_SUBRESOURCE*   pMappedResource) {
+    DXVK_PROFILE_ZONE("Map");
+    D3D11_CS_TAG("Map");
+    
     if (pResource == nullptr) {
       Logger::warn("D3D11ImmediateContext::Map() application tried to map a nullptr resource");
       return DXGI_ERROR_INVALID_CALL;
@@ -145,6 +160,9 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11ImmediateContext::Unmap(
           ID3D11Resource*             pResource,
           UINT                        Subresource) {
+    DXVK_PROFILE_ZONE("Unmap");
+    D3D11_CS_TAG("Unmap");
+    
     D3D11_RESOURCE_DIMENSION resourceDim = D3D11_RESOURCE_DIMENSION_UNKNOWN;
     pResource->GetType(&resourceDim);
     
@@ -171,6 +189,7 @@ namespace dxvk {
       // only way to invalidate a buffer is by mapping it.
       auto physicalSlice = buffer->allocPhysicalSlice();
       pResource->GetBufferInfo()->mappedSlice = physicalSlice;
+      pResource->GetBufferInfo()->copyPending = false;
       
       EmitCs([
         cBuffer        = buffer,
@@ -178,8 +197,26 @@ namespace dxvk {
       ] (DxvkContext* ctx) {
         ctx->invalidateBuffer(cBuffer, cPhysicalSlice);
       });
-    } else if (MapType != D3D11_MAP_WRITE_NO_OVERWRITE) {
-      if (!WaitForResource(buffer->resource(), MapFlags))
+      
+      // Keep track of buffers that use the uniform ring so
+      // that they can leave it once they go idle. Buffers
+      // released by the application go idle as well, so
+      // they will not be kept alive indefinitely.
+      if (!pResource->GetBufferInfo()->ringTracked && buffer->usesUniformRing()) {
+        pResource->GetBufferInfo()->ringTracked = true;
+        m_ringBuffers.push_back(pResource);
+      }
+    } else {
+      // The buffer may have just left the uniform ring, in
+      // which case the CS thread has to copy the contents to
+      // the new slice before the application can write to it
+      if (pResource->GetBufferInfo()->copyPending) {
+        SynchronizeCsThread();
+        pResource->GetBufferInfo()->copyPending = false;
+      }
+      
+      if (MapType != D3D11_MAP_WRITE_NO_OVERWRITE
+       && !WaitForResource(buffer->resource(), MapFlags))
         return DXGI_ERROR_WAS_STILL_DRAWING;
     }
     
@@ -200,6 +237,8 @@ namespace dxvk {
           UINT                              NumViews,
           ID3D11RenderTargetView* const*    ppRenderTargetViews,
           ID3D11DepthStencilView*           pDepthStencilView) {
+    D3D11_CS_TAG("OMSetRenderTargets");
+    
     // Optimization: If the number of draw and dispatch calls issued
     // prior to the previous context flush is above a certain threshold,
     // submit the current command buffer in order to keep the GPU busy.
@@ -207,6 +246,17 @@ namespace dxvk {
     if (m_drawCount >= MaxPendingDraws)
       Flush();
     
+    // Split the command stream at render pass boundaries so that
+    // worker threads can record the segments in parallel. Tiny
+    // segments are not worth the cost of restoring all state.
+    if (m_csRecorder.enabled()) {
+      if (m_csSegmentOpen && m_drawCount - m_csSegmentDraws >= MinSegmentDraws)
+        EndCsSegment(false);
+      
+      if (!m_csSegmentOpen)
+        BeginCsSegment();
+    }
+    
     D3D11DeviceContext::OMSetRenderTargets(
       NumViews, ppRenderTargetViews, pDepthStencilView);
   }
@@ -345,12 +395,58 @@ namespace dxvk {
   void D3D11ImmediateContext::SynchronizeCsThread() {
     // Dispatch current chunk so that all commands
     // recorded prior to this function will be run
+    EndCsSegment(true);
     FlushCsChunk();
     
     m_csThread.synchronize();
   }
   
   
+  void D3D11ImmediateContext::QueuePresent(
+          std::function<void()>&& Callback) {
+    this->Flush();
+    this->MoveIdleBuffersOffRing();
+    
+    EmitCs([cCallback = std::move(Callback)] (DxvkContext* ctx) {
+      cCallback();
+    });
+    
+    FlushCsChunk();
+  }
+  
+  
+  void D3D11ImmediateContext::MoveIdleBuffersOffRing() {
+    for (auto iter = m_ringBuffers.begin(); iter != m_ringBuffers.end(); ) {
+      D3D11Buffer*   buffer     = iter->ptr();
+      Rc<DxvkBuffer> dxvkBuffer = buffer->GetBuffer();
+      
+      if (!dxvkBuffer->leaveUniformRing()) {
+        iter++;
+        continue;
+      }
+      
+      // Rename the buffer once more so that its current ring
+      // slice gets released. The data is copied on the CS
+      // thread since the buffer may have been updated from
+      // a command list, which does not touch the map slice.
+      auto physicalSlice = dxvkBuffer->allocPhysicalSlice();
+      buffer->GetBufferInfo()->mappedSlice = physicalSlice;
+      buffer->GetBufferInfo()->copyPending = true;
+      
+      EmitCs([
+        cBuffer        = std::move(dxvkBuffer),
+        cPhysicalSlice = physicalSlice
+      ] (DxvkContext* ctx) {
+        std::memcpy(cPhysicalSlice.mapPtr(0),
+          cBuffer->mapPtr(0), cPhysicalSlice.length());
+        ctx->invalidateBuffer(cBuffer, cPhysicalSlice);
+      });
+      
+      iter = m_ringBuffers.erase(iter);
+    }
+  }
+  
+  
   void D3D11ImmediateContext::SynchronizeDevice() {
     m_device->waitForIdle();
   }
@@ -383,9 +479,79 @@ namespace dxvk {
   }
   
   
+  void D3D11ImmediateContext::BeginCsSegment() {
+    // Commands recorded so far have to be
+    // executed on the CS thread's context
+    FlushCsChunk();
+    
+    m_csSegmentOpen  = true;
+    m_csSegmentDraws = m_drawCount;
+    
+    // Segments are recorded on a fresh context,
+    // so all state has to be set up again
+    RestoreState();
+  }
+  
+  
+  void D3D11ImmediateContext::EndCsSegment(
+          bool                              RestoreContextState) {
+    if (!m_csSegmentOpen)
+      return;
+    
+    FlushCsChunk();
+    
+    m_csSegmentOpen = false;
+    
+    // Executes the secondary command buffers once the worker
+    // is done with them, or replays the chunks if they cannot
+    // be used. This keeps segments in submission order.
+    Rc<DxvkCsRecording> recording = m_csRecorder.record(m_csSegmentChunks);
+    m_csSegmentChunks.clear();
+    
+    Rc<DxvkCsChunk> chunk = new DxvkCsChunk();
+    
+    auto command = [cRecording = std::move(recording)] (DxvkContext* ctx) {
+      cRecording->execute(ctx);
+    };
+    
+    chunk->push(command, m_csTag);
+    EmitCsChunk(std::move(chunk));
+    
+    // State changes made by the segment are not visible to
+    // the CS thread's context if the commands were recorded,
+    // which matters if any commands follow outside a segment
+    if (RestoreContextState)
+      RestoreState();
+  }
+  
+  
   void D3D11ImmediateContext::EmitCsChunk(Rc<DxvkCsChunk>&& chunk) {
+    if (m_csSegmentOpen) {
+      m_csSegmentChunks.push_back(std::move(chunk));
+      return;
+    }
+    
     m_csThread.dispatchChunk(std::move(chunk));
     m_csIsBusy = true;
   }
   
+  
+  uint32_t D3D11ImmediateContext::GetCsWorkerCount() {
+#ifdef DXVK_NO_CS_WORKERS
+    return 0;
+#else
+    const std::string workerCount = env::getEnvVar(L"DXVK_CS_WORKERS");
+    
+    if (workerCount.empty())
+      return 0;
+    
+    // More workers than CPU cores would only compete
+    // with the CS thread and the application
+    uint32_t count = std::strtoul(workerCount.c_str(), nullptr, 10);
+    uint32_t limit = std::thread::hardware_concurrency();
+    
+    return limit != 0 ? std::min(count, limit) : count;
+#endif
+  }
+  
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "d3d11_context.h"
 
+#include "../dxvk/dxvk_cs_recorder.h"
+
 namespace dxvk {
   
   class D3D11Buffer;
@@ -9,6 +11,7 @@ namespace dxvk {
   
   class D3D11ImmediateContext : public D3D11DeviceContext {
     constexpr static UINT MaxPendingDraws = 500;
+    constexpr static UINT MinSegmentDraws = 100;
   public:
     
     D3D11ImmediateContext(
@@ -52,11 +55,30 @@ namespace dxvk {
     
     void SynchronizeCsThread();
     
+    /**
+     * \brief Queues a present operation
+     * 
+     * Flushes the context and runs the given function
+     * on the CS thread after all previously recorded
+     * commands, so that presentation stays in order
+     * with rendering without blocking the caller.
+     * \param [in] Callback Presentation function
+     */
+    void QueuePresent(
+            std::function<void()>&& Callback);
+    
   private:
     
     DxvkCsThread m_csThread;
     bool         m_csIsBusy = false;
     
+    DxvkCsRecorder               m_csRecorder;
+    bool                         m_csSegmentOpen  = false;
+    UINT                         m_csSegmentDraws = 0;
+    std::vector<Rc<DxvkCsChunk>> m_csSegmentChunks;
+    
+    std::vector<Com<D3D11Buffer>> m_ringBuffers;
+    
     HRESULT MapBuffer(
             D3D11Buffer*                pResource,
             D3D11_MAP                   MapType,
@@ -74,14 +96,23 @@ namespace dxvk {
             D3D11CommonTexture*         pResource,
             UINT                        Subresource);
     
+    void MoveIdleBuffersOffRing();
+    
     void SynchronizeDevice();
     
     bool WaitForResource(
       const Rc<DxvkResource>&                 Resource,
             UINT                              MapFlags);
     
+    void BeginCsSegment();
+    
+    void EndCsSegment(
+            bool                              RestoreContextState);
+    
     void EmitCsChunk(Rc<DxvkCsChunk>&& chunk) final;
     
+    static uint32_t GetCsWorkerCount();
+    
   };
   
 }
\ No newline at end of file
@@ -134,6 +134,37 @@ namespace dxvk {
   };
   
   
+  /**
+   * \brief State setter categories
+   * 
+   * Used to count state setter calls that were
+   * dropped because they would not change the
+   * current context state.
+   */
+  enum class D3D11StateCall : uint32_t {
+    InputLayout,
+    PrimitiveTopology,
+    VertexBuffers,
+    IndexBuffer,
+    Shader,
+    ConstantBuffers,
+    ShaderResources,
+    Samplers,
+    UnorderedAccessViews,
+    RenderTargets,
+    BlendState,
+    BlendFactor,
+    DepthStencilState,
+    StencilRef,
+    RasterizerState,
+    Viewports,
+    ScissorRects,
+    Count,
+  };
+  
+  using D3D11StateCallCounters = std::array<uint64_t, uint32_t(D3D11StateCall::Count)>;
+  
+  
   struct D3D11ContextStateSO {
     std::array<Com<D3D11Buffer>, D3D11_SO_STREAM_COUNT> targets;
   };
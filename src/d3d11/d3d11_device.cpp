@@ -86,7 +86,8 @@ namespace dxvk {
     m_dxvkDevice    (pDxgiDevice->GetDXVKDevice()),
     m_dxvkAdapter   (m_dxvkDevice->adapter()),
     m_d3d11Options  (D3D11GetAppOptions(env::getExeName())),
-    m_dxbcOptions   (m_dxvkDevice) {
+    m_dxbcOptions   (m_dxvkDevice),
+    m_csRecorder    (m_dxvkDevice, GetDeferredRecordingWorkerCount()) {
     Com<IDXGIAdapter> adapter;
     
     if (FAILED(pDxgiDevice->GetAdapter(&adapter))
@@ -1768,6 +1769,10 @@ namespace dxvk {
     try {
       *pShaderModule = m_shaderModules.GetShaderModule(
         &m_dxbcOptions, pShaderBytecode, BytecodeLength, ProgramType);
+      
+      // Allows the state cache to compile pipelines
+      // that use this shader before the first draw
+      m_dxvkDevice->registerShader(pShaderModule->GetShader());
       return S_OK;
     } catch (const DxvkError& e) {
       Logger::err(e.message());
@@ -2059,4 +2064,12 @@ namespace dxvk {
       : D3D_FEATURE_LEVEL_11_0;
   }
   
+  
+  uint32_t D3D11Device::GetDeferredRecordingWorkerCount() {
+    if (env::getEnvVar(L"DXVK_DEFERRED_RECORDING") != "1")
+      return 0;
+    
+    return std::max(1u, std::thread::hardware_concurrency() / 2);
+  }
+  
 }
@@ -7,6 +7,8 @@
 
 #include "../dxgi/dxgi_object.h"
 
+#include "../dxvk/dxvk_cs_recorder.h"
+
 #include "../util/com/com_private_data.h"
 
 #include "d3d11_interfaces.h"
@@ -312,6 +314,10 @@ namespace dxvk {
       return m_dxvkDevice;
     }
     
+    DxvkCsRecorder* GetCsRecorder() {
+      return &m_csRecorder;
+    }
+    
     DxvkBufferSlice AllocateCounterSlice();
     
     void FreeCounterSlice(const DxvkBufferSlice& Slice);
@@ -350,6 +356,8 @@ namespace dxvk {
     const D3D11OptionSet            m_d3d11Options;
     const DxbcOptions               m_dxbcOptions;
     
+    DxvkCsRecorder                  m_csRecorder;
+    
     D3D11ImmediateContext*          m_context = nullptr;
     
     std::mutex                      m_counterMutex;
@@ -394,6 +402,8 @@ namespace dxvk {
     
     static D3D_FEATURE_LEVEL GetMaxFeatureLevel();
     
+    static uint32_t GetDeferredRecordingWorkerCount();
+    
   };
   
 }
@@ -8,7 +8,8 @@
 #include "d3d11_present.h"
 
 namespace dxvk {
-  Logger Logger::s_instance("d3d11.log");
+  Logger   Logger::s_instance("d3d11.log");
+  Profiler Profiler::s_instance("d3d11_trace.json");
 }
   
 extern "C" {
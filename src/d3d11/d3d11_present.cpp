@@ -77,8 +77,6 @@ namespace dxvk {
     Com<ID3D11DeviceContext> deviceContext = nullptr;
     m_device->GetImmediateContext(&deviceContext);
     
-    // The presentation code is run from the main rendering thread
-    // rather than the command stream thread, so we synchronize.
     auto immediateContext = static_cast<D3D11ImmediateContext*>(deviceContext.ptr());
     immediateContext->Flush();
     immediateContext->SynchronizeCsThread();
@@ -86,6 +84,21 @@ namespace dxvk {
   }
   
   
+  HRESULT STDMETHODCALLTYPE D3D11Presenter::QueuePresent(
+          std::function<void()>&& Callback) {
+    Com<ID3D11DeviceContext> deviceContext = nullptr;
+    m_device->GetImmediateContext(&deviceContext);
+    
+    auto immediateContext = static_cast<D3D11ImmediateContext*>(deviceContext.ptr());
+    immediateContext->QueuePresent(std::move(Callback));
+    
+    // Presentation itself is recorded by the DXGI
+    // profiler, so we only mark the frame boundary
+    Profiler::endFrame();
+    return S_OK;
+  }
+  
+  
   HRESULT STDMETHODCALLTYPE D3D11Presenter::GetDevice(REFGUID riid, void** ppvDevice) {
     return m_device->QueryInterface(riid, ppvDevice);
   }
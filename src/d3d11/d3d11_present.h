@@ -59,6 +59,9 @@ namespace dxvk {
     
     HRESULT STDMETHODCALLTYPE FlushRenderingCommands();
     
+    HRESULT STDMETHODCALLTYPE QueuePresent(
+            std::function<void()>&& Callback);
+    
     HRESULT STDMETHODCALLTYPE GetDevice(
             REFGUID                 riid,
             void**                  ppvDevice);
@@ -121,13 +121,14 @@ namespace dxvk {
   
   
   uint32_t D3D11Query::Reset() {
+    // The revision is tracked on the calling thread since
+    // commands may be executed on more than one thread
     if (m_query != nullptr)
-      return m_query->reset();
+      m_revision = m_query->reset();
+    else if (m_event != nullptr)
+      m_revision = m_event->reset();
     
-    if (m_event != nullptr)
-      return m_event->reset();
-    
-    return 0;
+    return m_revision;
   }
   
   
@@ -139,8 +140,6 @@ namespace dxvk {
   
   
   void D3D11Query::Begin(DxvkContext* ctx, uint32_t revision) {
-    m_revision = revision;
-    
     if (m_query != nullptr) {
       DxvkQueryRevision rev = { m_query, revision };
       ctx->beginQuery(rev);
@@ -148,9 +147,9 @@ namespace dxvk {
   }
   
   
-  void D3D11Query::End(DxvkContext* ctx) {
+  void D3D11Query::End(DxvkContext* ctx, uint32_t revision) {
     if (m_query != nullptr) {
-      DxvkQueryRevision rev = { m_query, m_revision };
+      DxvkQueryRevision rev = { m_query, revision };
       ctx->endQuery(rev);
     }
   }
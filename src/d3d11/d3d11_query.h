@@ -31,11 +31,15 @@ namespace dxvk {
     
     uint32_t Reset();
     
+    uint32_t GetRevision() const {
+      return m_revision;
+    }
+    
     bool HasBeginEnabled() const;
     
     void Begin(DxvkContext* ctx, uint32_t revision);
     
-    void End(DxvkContext* ctx);
+    void End(DxvkContext* ctx, uint32_t revision);
     
     void Signal(DxvkContext* ctx, uint32_t revision);
     
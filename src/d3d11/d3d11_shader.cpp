@@ -50,7 +50,8 @@ namespace dxvk {
     const void*           pShaderBytecode,
           size_t          BytecodeLength)
   : m_name(pShaderKey->GetName()) {
-    Logger::debug(str::format("Compiling shader ", m_name));
+    if (Logger::logLevel() <= LogLevel::Debug)
+      Logger::debug(str::format("Compiling shader ", m_name));
     
     DxbcReader reader(
       reinterpret_cast<const char*>(pShaderBytecode),
@@ -70,6 +71,7 @@ namespace dxvk {
     
     m_shader = module.compile(*pDxbcOptions);
     m_shader->setDebugName(m_name);
+    m_shader->setShaderKey(pShaderKey->GetSha1());
     
     if (dumpPath.size() != 0) {
       std::ofstream dumpStream(
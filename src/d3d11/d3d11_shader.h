@@ -37,6 +37,10 @@ namespace dxvk {
     
     size_t GetHash() const;
     
+    const Sha1Hash& GetSha1() const {
+      return m_hash;
+    }
+    
     bool operator == (const D3D11ShaderKey& other) const {
       return m_type == other.m_type
           && m_hash == other.m_hash;
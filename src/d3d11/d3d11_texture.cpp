@@ -103,6 +103,23 @@ namespace dxvk {
     if (imageInfo.tiling == VK_IMAGE_TILING_OPTIMAL)
       imageInfo.layout = OptimizeLayout(imageInfo.usage);
     
+    // Mip maps can be generated with a compute shader if the
+    // format supports storage image access. This is done after
+    // selecting the layout since the app itself will never use
+    // the image as a storage image.
+    if ((m_desc.MiscFlags & D3D11_RESOURCE_MISC_GENERATE_MIPS)
+     && (imageInfo.tiling == VK_IMAGE_TILING_OPTIMAL)) {
+      DxvkImageCreateInfo storageInfo = imageInfo;
+      storageInfo.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+      
+      if (CheckImageSupport(&storageInfo, VK_IMAGE_TILING_OPTIMAL)) {
+        imageInfo.usage  |= VK_IMAGE_USAGE_STORAGE_BIT;
+        imageInfo.stages |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        imageInfo.access |= VK_ACCESS_SHADER_READ_BIT
+                         |  VK_ACCESS_SHADER_WRITE_BIT;
+      }
+    }
+    
     // If necessary, create the mapped linear buffer
     if (m_mapMode == D3D11_COMMON_TEXTURE_MAP_MODE_BUFFER)
       m_buffer = CreateMappedBuffer();
@@ -231,6 +248,9 @@ namespace dxvk {
     info.access = VK_ACCESS_TRANSFER_READ_BIT
                 | VK_ACCESS_TRANSFER_WRITE_BIT;
     
+    if (m_desc.Usage == D3D11_USAGE_DYNAMIC)
+      info.renameHint = DxvkBufferRenameHint::Dynamic;
+    
     return m_device->GetDXVKDevice()->createBuffer(info,
       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
       VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
@@ -182,13 +182,29 @@ namespace dxvk {
       m_entryPointInterfaces.data());
     m_module.setDebugName(m_entryPointId, "main");
     
+    SpirvCodeBuffer code = m_module.compile();
+    
+    if (m_options.optimizeSpirv) {
+      SpirvOptimizer optimizer(code);
+      optimizer.run();
+      
+      SpirvCodeBuffer optimized = optimizer.getCode();
+      
+      if (Logger::logLevel() <= LogLevel::Debug) {
+        Logger::debug(str::format("DxbcCompiler: Optimized SPIR-V from ",
+          code.size(), " to ", optimized.size(), " bytes"));
+      }
+      
+      code = optimized;
+    }
+    
     // Create the shader module object
     return new DxvkShader(
       m_version.shaderStage(),
       m_resourceSlots.size(),
       m_resourceSlots.data(),
       m_interfaceSlots,
-      m_module.compile());
+      code);
   }
   
   
@@ -20,6 +20,11 @@ namespace dxvk {
     
     // Enable certain features if they are supported by the device
     this->useStorageImageReadWithoutFormat = devFeatures.shaderStorageImageReadWithoutFormat;
+    
+    // The optimizer is opt-in until it has been validated
+    // against a larger set of shaders
+    if (env::getEnvVar(L"DXVK_SHADER_OPTIMIZE") == "1")
+      this->optimizeSpirv = true;
   }
   
 }
\ No newline at end of file
@@ -24,6 +24,9 @@ namespace dxvk {
     /// If \c false, image read operations can only be performed
     /// on storage images with a scalar 32-bit image formats.
     bool useStorageImageReadWithoutFormat = false;
+    
+    /// Run the SPIR-V optimizer on generated code
+    bool optimizeSpirv = false;
   };
   
 }
\ No newline at end of file
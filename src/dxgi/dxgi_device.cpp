@@ -8,8 +8,12 @@ namespace dxvk {
           IDXGIVkAdapter*           pAdapter,
     const VkPhysicalDeviceFeatures* pFeatures)
   : m_container (pContainer),
-    m_adapter   (pAdapter) {
+    m_adapter   (pAdapter),
+    m_options   (DxgiGetAppOptions(env::getExeName())) {
     m_device = m_adapter->GetDXVKAdapter()->createDevice(*pFeatures);
+    
+    for (uint32_t i = 0; i < m_frameEvents.size(); i++)
+      m_frameEvents[i] = new DxvkEvent();
   }
   
   
@@ -107,15 +111,24 @@ namespace dxvk {
   
   HRESULT STDMETHODCALLTYPE DxgiDevice::GetMaximumFrameLatency(
           UINT*                 pMaxLatency) {
-    Logger::warn("DxgiDevice::GetMaximumFrameLatency: Stub");
-    *pMaxLatency = 1;
+    if (pMaxLatency == nullptr)
+      return DXGI_ERROR_INVALID_CALL;
+    
+    *pMaxLatency = m_frameLatency.load();
     return S_OK;
   }
   
   
   HRESULT STDMETHODCALLTYPE DxgiDevice::SetMaximumFrameLatency(
           UINT                  MaxLatency) {
-    Logger::warn("DxgiDevice::SetMaximumFrameLatency: Stub");
+    if (MaxLatency > MaxFrameLatency)
+      return DXGI_ERROR_INVALID_CALL;
+    
+    // Zero resets the latency to the default
+    if (MaxLatency == 0)
+      MaxLatency = DefaultFrameLatency;
+    
+    m_frameLatency.store(MaxLatency);
     return S_OK;
   }
   
@@ -149,4 +162,14 @@ namespace dxvk {
     return m_device;
   }
   
+  
+  Rc<DxvkEvent> DxgiDevice::GetFrameSyncEvent() {
+    uint32_t frameLatency = m_frameLatency.load();
+    
+    if (m_options.maxFrameLatency != 0)
+      frameLatency = std::min<uint32_t>(m_options.maxFrameLatency, MaxFrameLatency);
+    
+    return m_frameEvents[m_frameId++ % frameLatency];
+  }
+  
 }
@@ -1,14 +1,29 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+
 #include <dxvk_device.h>
 
 #include "dxgi_adapter.h"
 #include "dxgi_interfaces.h"
+#include "dxgi_options.h"
 
 namespace dxvk {
   
   class DxgiFactory;
   
+  /**
+   * \brief Frame latency limits
+   * 
+   * The default matches what D3D11 uses if the
+   * application does not set a frame latency.
+   */
+  enum DxgiFrameLatency : uint32_t {
+    DefaultFrameLatency = 3,
+    MaxFrameLatency     = 16,
+  };
+  
   class DxgiDevice : public IDXGIVkDevice {
     
   public:
@@ -87,6 +102,26 @@ namespace dxvk {
     
     Rc<DxvkDevice> STDMETHODCALLTYPE GetDXVKDevice() final;
     
+    /**
+     * \brief Retrieves the event for the next frame
+     * 
+     * Used by swap chains to limit the number of frames
+     * in flight. The caller must wait for the event to be
+     * signaled, reset it, and signal it once the frame has
+     * been presented. Events are reused once the maximum
+     * frame latency is exceeded.
+     * \returns Frame synchronization event
+     */
+    Rc<DxvkEvent> GetFrameSyncEvent();
+    
+    /**
+     * \brief Per-app DXGI options
+     * \returns DXGI options
+     */
+    const DxgiOptions& GetOptions() const {
+      return m_options;
+    }
+    
   private:
     
     IDXGIObject*        m_container;
@@ -94,6 +129,13 @@ namespace dxvk {
     Com<IDXGIVkAdapter> m_adapter;
     Rc<DxvkDevice>      m_device;
     
+    DxgiOptions         m_options;
+    
+    std::atomic<uint32_t> m_frameLatency = { DefaultFrameLatency };
+    std::atomic<uint64_t> m_frameId      = { 0ull };
+    
+    std::array<Rc<DxvkEvent>, MaxFrameLatency> m_frameEvents;
+    
   };
 
 }
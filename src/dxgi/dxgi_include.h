@@ -14,6 +14,8 @@
 #include "../util/log/log.h"
 #include "../util/log/log_debug.h"
 
+#include "../util/prof/prof.h"
+
 #include "../util/rc/util_rc.h"
 #include "../util/rc/util_rc_ptr.h"
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include "../dxvk/dxvk_include.h"
 
 #include "dxgi_include.h"
@@ -151,13 +153,27 @@ IDXGIVkPresenter : public IUnknown {
   /**
    * \brief Flushes the immediate context
    * 
-   * Used by the swap chain's \c Present method to
-   * ensure that all rendering commands get dispatched
-   * before presenting the swap chain's back buffer.
+   * Dispatches all rendering commands and waits for
+   * them to be processed by the command stream thread.
+   * Used by the swap chain to ensure that no presentation
+   * work is pending before it modifies presenter state.
    * \returns \c S_OK on success
    */
   virtual HRESULT STDMETHODCALLTYPE FlushRenderingCommands() = 0;
   
+  /**
+   * \brief Queues presentation
+   * 
+   * Flushes the immediate context and executes the given
+   * function on its command stream thread once all prior
+   * rendering commands have been processed. Returns as
+   * soon as the function has been queued.
+   * \param [in] Callback Function that presents the image
+   * \returns \c S_OK on success
+   */
+  virtual HRESULT STDMETHODCALLTYPE QueuePresent(
+          std::function<void()>&& Callback) = 0;
+  
   /**
    * \brief Underlying DXVK device
    * 
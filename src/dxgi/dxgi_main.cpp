@@ -3,7 +3,8 @@
 
 namespace dxvk {
   
-  Logger Logger::s_instance("dxgi.log");
+  Logger   Logger::s_instance("dxgi.log");
+  Profiler Profiler::s_instance("dxgi_trace.json");
   
   HRESULT createDxgiFactory(REFIID riid, void **ppFactory) {
     if (riid != __uuidof(IDXGIFactory)
@@ -0,0 +1,38 @@
+#include <cstdlib>
+#include <unordered_map>
+
+#include "../util/util_env.h"
+
+#include "dxgi_options.h"
+
+namespace dxvk {
+  
+  const static std::unordered_map<std::string, DxgiOptions> g_dxgiAppOptions = { };
+  
+  
+  DxgiOptions DxgiGetAppOptions(const std::string& AppName) {
+    auto appOptions = g_dxgiAppOptions.find(AppName);
+    
+    DxgiOptions options = appOptions != g_dxgiAppOptions.end()
+      ? appOptions->second
+      : DxgiOptions();
+    
+    const std::string maxFrameLatency = env::getEnvVar(L"DXVK_MAX_FRAME_LATENCY");
+    
+    if (!maxFrameLatency.empty())
+      options.maxFrameLatency = std::strtoul(maxFrameLatency.c_str(), nullptr, 10);
+    
+    const std::string maxFrameRate = env::getEnvVar(L"DXVK_FRAME_RATE");
+    
+    if (!maxFrameRate.empty())
+      options.maxFrameRate = std::strtod(maxFrameRate.c_str(), nullptr);
+    
+    const std::string directPresent = env::getEnvVar(L"DXVK_DIRECT_PRESENT");
+    
+    if (!directPresent.empty())
+      options.directPresent = directPresent == "1";
+    
+    return options;
+  }
+  
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "dxgi_include.h"
+
+namespace dxvk {
+  
+  /**
+   * \brief DXGI options
+   * 
+   * Per-app settings that override the
+   * behaviour requested by the application.
+   */
+  struct DxgiOptions {
+    /// Maximum number of frames that may be in flight.
+    /// If zero, the value set by the application is used.
+    uint32_t maxFrameLatency = 0;
+    
+    /// Limits the frame rate to the given number of
+    /// frames per second. If zero, no limit is applied.
+    double maxFrameRate = 0.0;
+    
+    /// Copies the back buffer to the swap image instead of
+    /// rendering it if formats and sizes match, gamma is not
+    /// used and the HUD is disabled. Saves a full-screen pass.
+    bool directPresent = false;
+  };
+  
+  
+  /**
+   * \brief Retrieves per-app options
+   * 
+   * Options can be overridden with environment variables, i.e.
+   * \c DXVK_MAX_FRAME_LATENCY, \c DXVK_FRAME_RATE and
+   * \c DXVK_DIRECT_PRESENT.
+   * \param [in] AppName Executable name
+   * \returns DXGI options
+   */
+  DxgiOptions DxgiGetAppOptions(const std::string& AppName);
+  
+}
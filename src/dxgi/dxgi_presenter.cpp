@@ -9,9 +9,11 @@ namespace dxvk {
   
   DxgiPresenter::DxgiPresenter(
     const Rc<DxvkDevice>&         device,
-          HWND                    window)
-  : m_device  (device),
-    m_context (device->createContext()) {
+          HWND                    window,
+          bool                    directPresent)
+  : m_device        (device),
+    m_context       (device->createContext()),
+    m_directPresent (directPresent) {
     
     // Create Vulkan surface for the window
     HINSTANCE instance = reinterpret_cast<HINSTANCE>(
@@ -163,7 +165,22 @@ namespace dxvk {
   }
   
   
-  void DxgiPresenter::presentImage() {
+  void DxgiPresenter::presentImage(
+    const DxvkEventRevision& frameEvent) {
+    DXVK_PROFILE_ZONE("Present image");
+    
+    try {
+      this->presentFrame(frameEvent);
+    } catch (...) {
+      // The signal command may never be submitted
+      frameEvent.event->signal(frameEvent.revision);
+      throw;
+    }
+  }
+  
+  
+  void DxgiPresenter::presentFrame(
+    const DxvkEventRevision& frameEvent) {
     if (m_hud != nullptr) {
       m_hud->render({
         m_options.preferredBufferSize.width,
@@ -184,6 +201,22 @@ namespace dxvk {
     resolveSubresources.baseArrayLayer  = 0;
     resolveSubresources.layerCount      = 1;
     
+    const DxvkSwapSemaphores sem = m_swapchain->getSemaphorePair();
+    
+    auto framebuffer     = m_swapchain->getFramebuffer(sem.acquireSync);
+    auto framebufferSize = framebuffer->size();
+    
+    if (this->presentDirect(framebuffer)) {
+      m_context->signalEvent(frameEvent);
+      
+      m_device->submitCommandList(
+        m_context->endRecording(),
+        sem.acquireSync, sem.presentSync);
+      
+      m_swapchain->present(sem.presentSync);
+      return;
+    }
+    
     if (m_backBufferResolve != nullptr) {
       m_context->resolveImage(
         m_backBufferResolve, resolveSubresources,
@@ -191,11 +224,6 @@ namespace dxvk {
         VK_FORMAT_UNDEFINED);
     }
     
-    const DxvkSwapSemaphores sem = m_swapchain->getSemaphorePair();
-    
-    auto framebuffer     = m_swapchain->getFramebuffer(sem.acquireSync);
-    auto framebufferSize = framebuffer->size();
-    
     m_context->bindFramebuffer(framebuffer);
     
     VkViewport viewport;
@@ -233,6 +261,8 @@ namespace dxvk {
       m_context->draw(4, 1, 0, 0);
     }
     
+    m_context->signalEvent(frameEvent);
+    
     m_device->submitCommandList(
       m_context->endRecording(),
       sem.acquireSync, sem.presentSync);
@@ -241,6 +271,44 @@ namespace dxvk {
   }
   
   
+  bool DxgiPresenter::presentDirect(
+    const Rc<DxvkFramebuffer>& framebuffer) {
+    if (!m_directPresent || m_hud != nullptr || !m_gammaIsIdentity)
+      return false;
+    
+    // The back buffer must be bit-compatible with
+    // the swap image, since we skip the draw that
+    // would otherwise convert and scale it.
+    const Rc<DxvkImage> swapImage = framebuffer->renderTargets()
+      .getColorTarget(0).view->image();
+    
+    if (!(swapImage->info().usage & VK_IMAGE_USAGE_TRANSFER_DST_BIT)
+     || swapImage->info().format != m_backBuffer->info().format
+     || swapImage->info().extent != m_backBuffer->info().extent)
+      return false;
+    
+    VkImageSubresourceLayers subresources;
+    subresources.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    subresources.mipLevel       = 0;
+    subresources.baseArrayLayer = 0;
+    subresources.layerCount     = 1;
+    
+    if (m_backBuffer->info().sampleCount != VK_SAMPLE_COUNT_1_BIT) {
+      m_context->resolveImage(
+        swapImage,    subresources,
+        m_backBuffer, subresources,
+        VK_FORMAT_UNDEFINED);
+    } else {
+      m_context->copyImage(
+        swapImage,    subresources, VkOffset3D { 0, 0, 0 },
+        m_backBuffer, subresources, VkOffset3D { 0, 0, 0 },
+        m_backBuffer->info().extent);
+    }
+    
+    return true;
+  }
+  
+  
   void DxgiPresenter::updateBackBuffer(const Rc<DxvkImage>& image) {
     // Explicitly destroy the old stuff
     m_backBuffer        = image;
@@ -360,6 +428,21 @@ namespace dxvk {
   
   
   void DxgiPresenter::setGammaRamp(const DxgiPresenterGammaRamp& data) {
+    m_gammaIsIdentity = true;
+    
+    for (uint32_t i = 0; i < 3; i++) {
+      m_gammaIsIdentity &= data.in_factor[i] == 1.0f
+                        && data.in_offset[i] == 0.0f;
+    }
+    
+    for (uint32_t i = 0; i < DxgiPresenterGammaRamp::CpCount; i++) {
+      const float value = DxgiPresenterGammaRamp::cpLocation(i);
+      
+      m_gammaIsIdentity &= data.cp_values[4 * i + 0] == value
+                        && data.cp_values[4 * i + 1] == value
+                        && data.cp_values[4 * i + 2] == value;
+    }
+    
     m_context->beginRecording(
       m_device->createCommandList());
     
@@ -44,7 +44,8 @@ namespace dxvk {
     
     DxgiPresenter(
       const Rc<DxvkDevice>&         device,
-            HWND                    window);
+            HWND                    window,
+            bool                    directPresent);
     
     ~DxgiPresenter();
       
@@ -57,8 +58,15 @@ namespace dxvk {
     
     /**
      * \brief Renders back buffer to the screen
+     * 
+     * The frame event is signaled immediately if
+     * presentation fails, so that later presents
+     * do not wait for a frame that never completes.
+     * \param [in] frameEvent Event to signal once
+     *        the presentation commands have completed
      */
-    void presentImage();
+    void presentImage(
+      const DxvkEventRevision& frameEvent);
     
     /**
      * \brief Sets new back buffer
@@ -130,9 +138,18 @@ namespace dxvk {
     
     Rc<hud::Hud>        m_hud;
     
+    bool                m_directPresent;
+    bool                m_gammaIsIdentity = true;
+    
     DxvkBlendMode           m_blendMode;
     DxvkSwapchainProperties m_options;
     
+    void presentFrame(
+      const DxvkEventRevision& frameEvent);
+    
+    bool presentDirect(
+      const Rc<DxvkFramebuffer>& framebuffer);
+    
     Rc<DxvkShader> createVertexShader();
     Rc<DxvkShader> createFragmentShader();
     
@@ -9,8 +9,9 @@ namespace dxvk {
           DxgiFactory*          factory,
           IUnknown*             pDevice,
           DXGI_SWAP_CHAIN_DESC* pDesc)
-  : m_factory (factory),
-    m_desc    (*pDesc) {
+  : m_factory     (factory),
+    m_desc        (*pDesc),
+    m_frameLimiter(&m_frameClock) {
     
     // Retrieve a device pointer that allows us to
     // communicate with the underlying D3D device
@@ -32,6 +33,22 @@ namespace dxvk {
     m_device  = static_cast<DxgiDevice*>(device.ptr());
     m_adapter = static_cast<DxgiAdapter*>(adapter.ptr());
     
+    // Set up frame rate limit and frame time logging
+    m_frameLimiter.setTargetFrameRate(
+      m_device->GetOptions().maxFrameRate);
+    
+    if (env::getEnvVar(L"DXVK_FRAME_TIME_LOG") == "1") {
+      std::string exeName = env::getExeName();
+      auto extp = exeName.find_last_of('.');
+      
+      if (extp != std::string::npos && exeName.substr(extp + 1) == "exe")
+        exeName.erase(extp);
+      
+      m_frameTimeLog = std::make_unique<DxvkFrameTimeLog>(
+        exeName + "_frametimes.csv", m_frameClock.now(),
+        std::chrono::seconds(1));
+    }
+    
     // Initialize frame statistics
     m_stats.PresentCount         = 0;
     m_stats.PresentRefreshCount  = 0;
@@ -59,7 +76,9 @@ namespace dxvk {
   
   
   DxgiSwapChain::~DxgiSwapChain() {
-    
+    // Queued presents may still reference the
+    // window, so make sure they have completed
+    m_presentDevice->FlushRenderingCommands();
   }
   
   
@@ -176,11 +195,9 @@ namespace dxvk {
     if (Flags & DXGI_PRESENT_TEST)
       return S_OK;
     
+    DXVK_PROFILE_ZONE("Present");
+    
     try {
-      // Submit pending rendering commands
-      // before recording the present code.
-      m_presentDevice->FlushRenderingCommands();
-      
       // Update swap chain properties. This will not only set
       // up vertical synchronization properly, but also apply
       // changes that were made to the window size even if the
@@ -193,8 +210,44 @@ namespace dxvk {
         : m_presenter->pickPresentMode(VK_PRESENT_MODE_FIFO_KHR);
       swapchainProps.preferredBufferSize = GetWindowSize();
       
-      m_presenter->recreateSwapchain(swapchainProps);
-      m_presenter->presentImage();
+      // Limit the number of frames in flight. The event was
+      // last used by the frame that is as many frames behind
+      // as the maximum frame latency allows.
+      Rc<DxvkEvent> frameEvent = m_device->GetFrameSyncEvent();
+      
+      { DXVK_PROFILE_ZONE("Wait for frame");
+        frameEvent->wait();
+      }
+      
+      { DXVK_PROFILE_ZONE("Frame limiter");
+        m_frameLimiter.delay();
+      }
+      
+      // The presenter is only used from the command stream
+      // thread from here on, so that presentation happens in
+      // order with rendering commands and the application
+      // does not have to wait for image acquisition.
+      const DxvkEventRevision frameRevision = { frameEvent, frameEvent->reset() };
+      
+      m_presentDevice->QueuePresent(
+        [cPresenter = m_presenter, cProps = swapchainProps, cFrameRevision = frameRevision] () {
+          try {
+            cPresenter->recreateSwapchain(cProps);
+            cPresenter->presentImage(cFrameRevision);
+          } catch (const DxvkError& err) {
+            Logger::err(err.message());
+            
+            // The presenter signals the event itself if
+            // presentImage fails, but the swap chain may
+            // already have failed to be recreated
+            cFrameRevision.event->signal(cFrameRevision.revision);
+          }
+        });
+      
+      if (m_frameTimeLog != nullptr)
+        m_frameTimeLog->addFrame(m_frameClock.now());
+      
+      Profiler::endFrame();
       return S_OK;
     } catch (const DxvkError& err) {
       Logger::err(err.message());
@@ -309,6 +362,7 @@ namespace dxvk {
       m_gammaControl.cp_values[4 * i + 2] = pGammaControl->GammaCurve[i].Blue;
     }
     
+    m_presentDevice->FlushRenderingCommands();
     m_presenter->setGammaRamp(m_gammaControl);
     return S_OK;
   }
@@ -331,6 +385,7 @@ namespace dxvk {
       m_gammaControl.cp_values[4 * i + 3] = value;
     }
     
+    m_presentDevice->FlushRenderingCommands();
     m_presenter->setGammaRamp(m_gammaControl);
     return S_OK;
   }
@@ -340,7 +395,8 @@ namespace dxvk {
     try {
       m_presenter = new DxgiPresenter(
         m_device->GetDXVKDevice(),
-        m_desc.OutputWindow);
+        m_desc.OutputWindow,
+        m_device->GetOptions().directPresent);
       return S_OK;
     } catch (const DxvkError& e) {
       Logger::err(e.message());
@@ -358,6 +414,10 @@ namespace dxvk {
       return E_INVALIDARG;
     }
     
+    // Wait for queued presents to finish, since
+    // those may still access the old back buffer
+    m_presentDevice->FlushRenderingCommands();
+    
     // Destroy previous back buffer before creating a new one
     m_backBuffer = nullptr;
     
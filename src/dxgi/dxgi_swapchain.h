@@ -3,6 +3,7 @@
 #include <memory>
 #include <mutex>
 
+#include <dxvk_frame_stats.h>
 #include <dxvk_surface.h>
 #include <dxvk_swapchain.h>
 
@@ -114,6 +115,11 @@ namespace dxvk {
     
     DxgiPresenterGammaRamp          m_gammaControl;
     
+    DxvkSystemClock                 m_frameClock;
+    DxvkFrameLimiter                m_frameLimiter;
+    
+    std::unique_ptr<DxvkFrameTimeLog> m_frameTimeLog;
+    
     HRESULT CreatePresenter();
     HRESULT CreateBackBuffer();
     
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "dxvk_buffer.h"
 #include "dxvk_device.h"
 
@@ -15,13 +17,57 @@ namespace dxvk {
     m_physSliceLength = createInfo.size;
     m_physSliceStride = align(createInfo.size, 256);
     
-    // Allocate a single buffer slice
-    m_physSlice = this->allocPhysicalBuffer(1)
-      ->slice(0, m_physSliceStride);
+    // Buffers that are expected to be invalidated frequently
+    // start out with a larger pool so that they don't have
+    // to go through several small allocations first. Large
+    // buffers are grown in smaller steps to save memory.
+    switch (createInfo.renameHint) {
+      case DxvkBufferRenameHint::Static:    m_physSliceMin =  2; break;
+      case DxvkBufferRenameHint::Dynamic:   m_physSliceMin =  4; break;
+      case DxvkBufferRenameHint::Streaming: m_physSliceMin = 16; break;
+    }
+    
+    m_physSliceMax   = std::max<VkDeviceSize>(1, MaxPhysBufferSize / m_physSliceStride);
+    m_physSliceMin   = std::min(m_physSliceMin, m_physSliceMax);
+    m_physSliceCount = m_physSliceMin;
+    
+    // Small streaming uniform buffers are sub-allocated from
+    // the device's uniform ring so that all of them share a
+    // small number of Vulkan buffers.
+    if (device->uniformRing()->isCompatible(createInfo, memoryType)) {
+      m_ring       = device->uniformRing().ptr();
+      m_ringActive = true;
+    }
+    
+    // Allocate a single buffer slice. Buffers that use the ring
+    // only allocate from it once renamed, so that buffers which
+    // never get renamed do not keep a ring chunk alive.
+    Rc<DxvkPhysicalBuffer> buffer = this->allocPhysicalBuffer(1);
+    m_physSlice = buffer->slice(0, m_physSliceStride);
+    m_physBuffers.push_back({ buffer, 1 });
+    
+    m_physSliceTotal = 1;
+    m_physSlicePeak  = 1;
+    
+    m_slicesInUse = 1;
+    
+    m_createTime  = Clock::now();
+    m_windowStart = m_createTime;
+  }
+  
+  
+  DxvkBuffer::~DxvkBuffer() {
+    if (m_tracked)
+      m_device->untrackRenamedBuffer(this);
+    
+    if (m_ring != nullptr)
+      m_ring->free(m_physSlice);
   }
   
   
   DxvkPhysicalBufferSlice DxvkBuffer::rename(const DxvkPhysicalBufferSlice& slice) {
+    std::lock_guard<sync::Spinlock> lock(m_sliceLock);
+    
     DxvkPhysicalBufferSlice prevSlice = std::move(m_physSlice);
     
     m_physSlice = slice;
@@ -31,8 +77,22 @@ namespace dxvk {
   
   
   DxvkPhysicalBufferSlice DxvkBuffer::allocPhysicalSlice() {
+    // Let the device know about the buffer so that its
+    // pool can shrink even if it is not renamed anymore
+    if (!m_tracked.exchange(true))
+      m_device->trackRenamedBuffer(this);
+    
     std::unique_lock<std::mutex> freeLock(m_freeMutex);
     
+    m_renameCount   += 1;
+    m_windowRenames += 1;
+    
+    if (m_ringActive) {
+      DxvkPhysicalBufferSlice result = m_ring->alloc(m_physSliceLength);
+      this->updateRenameWindow(++m_slicesInUse);
+      return result;
+    }
+    
     // If no slices are available, swap the two free lists.
     if (m_freeSlices.size() == 0) {
       std::unique_lock<std::mutex> swapLock(m_swapMutex);
@@ -51,20 +111,83 @@ namespace dxvk {
           m_physSliceLength));
       }
       
-      m_physSliceCount *= 2;
+      { std::unique_lock<std::mutex> swapLock(m_swapMutex);
+        m_physBuffers.push_back({ buffer, m_physSliceCount });
+      }
+      
+      m_physSliceTotal += m_physSliceCount;
+      m_physSlicePeak   = std::max(m_physSlicePeak, m_physSliceTotal);
+      m_physSliceCount  = std::min(m_physSliceCount * 2, m_physSliceMax);
     }
     
     // Take the first slice from the queue
     DxvkPhysicalBufferSlice result = std::move(m_freeSlices.back());
     m_freeSlices.pop_back();
+    
+    this->updateRenameWindow(++m_slicesInUse);
     return result;
   }
   
   
   void DxvkBuffer::freePhysicalSlice(const DxvkPhysicalBufferSlice& slice) {
     // Add slice to a separate free list to reduce lock contention.
-    std::unique_lock<std::mutex> swapLock(m_swapMutex);
-    m_nextSlices.push_back(slice);
+    // Slices of backing buffers that have been dropped from the
+    // pool are discarded so that the buffer can be destroyed.
+    { std::unique_lock<std::mutex> swapLock(m_swapMutex);
+      m_slicesInUse -= 1;
+      
+      if (this->isActiveBuffer(slice.handle())) {
+        m_nextSlices.push_back(slice);
+        return;
+      }
+    }
+    
+    // Ring slices go back to the ring, even if the
+    // buffer has stopped allocating from it since
+    if (m_ring != nullptr)
+      m_ring->free(slice);
+  }
+  
+  
+  void DxvkBuffer::updatePool() {
+    std::unique_lock<std::mutex> freeLock(m_freeMutex);
+    this->updateRenameWindow(m_slicesInUse.load());
+  }
+  
+  
+  bool DxvkBuffer::leaveUniformRing() {
+    if (!m_ringIdle.load())
+      return false;
+    
+    std::unique_lock<std::mutex> freeLock(m_freeMutex);
+    
+    if (!m_ringActive)
+      return false;
+    
+    m_ringActive = false;
+    
+    // The buffer is rarely renamed at this point, so
+    // there is no need to allocate a large pool for it
+    m_physSliceMin   = std::min<VkDeviceSize>(2, m_physSliceMax);
+    m_physSliceCount = m_physSliceMin;
+    return true;
+  }
+  
+  
+  DxvkBufferRenameStats DxvkBuffer::renameStats() const {
+    const auto lifetime = std::chrono::duration<float>(
+      Clock::now() - m_createTime).count();
+    
+    DxvkBufferRenameStats result;
+    result.hint         = m_info.renameHint;
+    result.sliceSize    = m_physSliceLength;
+    result.renameCount  = m_renameCount;
+    result.renameRate   = m_renameRate;
+    result.averageRate  = lifetime > 0.0f ? float(m_renameCount) / lifetime : 0.0f;
+    result.sliceCount   = m_physSliceTotal;
+    result.slicePeak    = m_physSlicePeak;
+    result.shrinkCount  = m_shrinkCount;
+    return result;
   }
   
   
@@ -76,6 +199,97 @@ namespace dxvk {
   }
   
   
+  void DxvkBuffer::updateRenameWindow(uint32_t slicesInUse) {
+    m_windowPeakUsage = std::max(m_windowPeakUsage, slicesInUse);
+    
+    const Clock::time_point now = Clock::now();
+    const Clock::duration elapsed = now - m_windowStart;
+    
+    if (elapsed < RenameWindowLength)
+      return;
+    
+    m_renameRate = float(m_windowRenames)
+      / std::chrono::duration<float>(elapsed).count();
+    
+    // The pool is considered oversized if less than a quarter
+    // of the slices were in use during the entire window. Only
+    // shrink after this has been the case for several windows
+    // in a row so that we don't reallocate on periodic spikes.
+    const bool lowUsage = m_physSliceTotal > m_physSliceMin
+      && 4 * m_windowPeakUsage <= m_physSliceTotal;
+    
+    m_lowUsageWindows = lowUsage ? m_lowUsageWindows + 1 : 0;
+    
+    // The current slice of a buffer that is no longer being
+    // renamed would keep its ring chunk alive indefinitely
+    if (m_ringActive) {
+      m_idleWindows = m_windowRenames == 0 ? m_idleWindows + 1 : 0;
+      
+      if (m_idleWindows >= RenameShrinkWindows)
+        m_ringIdle.store(true);
+    }
+    
+    if (m_lowUsageWindows >= RenameShrinkWindows) {
+      this->shrinkPool(m_windowPeakUsage);
+      m_lowUsageWindows = 0;
+    }
+    
+    m_windowStart     = now;
+    m_windowRenames   = 0;
+    m_windowPeakUsage = slicesInUse;
+  }
+  
+  
+  void DxvkBuffer::shrinkPool(uint32_t slicesInUse) {
+    std::unique_lock<std::mutex> swapLock(m_swapMutex);
+    
+    // Keep enough slices around to serve twice the peak
+    // usage, and release the largest backing buffers first.
+    const VkDeviceSize targetCount = std::max<VkDeviceSize>(
+      m_physSliceMin, 2 * slicesInUse);
+    
+    std::sort(m_physBuffers.begin(), m_physBuffers.end(),
+      [] (const PhysBuffer& a, const PhysBuffer& b) {
+        return a.sliceCount > b.sliceCount;
+      });
+    
+    for (auto i = m_physBuffers.begin(); i != m_physBuffers.end(); ) {
+      if (m_physSliceTotal - i->sliceCount < targetCount) {
+        i++; continue;
+      }
+      
+      // Remove all free slices that belong to the buffer. Any
+      // slices still in use will be dropped once they get freed,
+      // which will eventually destroy the backing buffer.
+      const VkBuffer handle = i->buffer->handle();
+      
+      auto isRetired = [handle] (const DxvkPhysicalBufferSlice& slice) {
+        return slice.handle() == handle;
+      };
+      
+      m_freeSlices.erase(std::remove_if(m_freeSlices.begin(), m_freeSlices.end(), isRetired), m_freeSlices.end());
+      m_nextSlices.erase(std::remove_if(m_nextSlices.begin(), m_nextSlices.end(), isRetired), m_nextSlices.end());
+      
+      m_physSliceTotal -= i->sliceCount;
+      i = m_physBuffers.erase(i);
+    }
+    
+    m_physSliceCount = std::max(m_physSliceMin,
+      std::min(m_physSliceTotal, m_physSliceMax));
+    m_shrinkCount += 1;
+  }
+  
+  
+  bool DxvkBuffer::isActiveBuffer(VkBuffer handle) const {
+    for (const auto& entry : m_physBuffers) {
+      if (entry.buffer->handle() == handle)
+        return true;
+    }
+    
+    return false;
+  }
+  
+  
   DxvkBufferView::DxvkBufferView(
     const Rc<vk::DeviceFn>&         vkd,
     const Rc<DxvkBuffer>&           buffer,
@@ -106,6 +320,82 @@ namespace dxvk {
   }
   
   
+  DxvkBufferRenameLog:: DxvkBufferRenameLog() { }
+  DxvkBufferRenameLog::~DxvkBufferRenameLog() { }
+  
+  
+  void DxvkBufferRenameLog::trackBuffer(
+          DxvkBuffer*            buffer) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffers.insert(buffer);
+  }
+  
+  
+  void DxvkBufferRenameLog::untrackBuffer(
+          DxvkBuffer*            buffer) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffers.erase(buffer);
+    
+    this->addEntry(buffer->renameStats());
+  }
+  
+  
+  void DxvkBufferRenameLog::updatePools() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    for (auto buffer : m_buffers)
+      buffer->updatePool();
+  }
+  
+  
+  void DxvkBufferRenameLog::addEntry(
+    const DxvkBufferRenameStats& stats) {
+    auto entry = std::find_if(m_entries.begin(), m_entries.end(),
+      [&stats] (const DxvkBufferRenameStats& e) {
+        return e.renameCount < stats.renameCount;
+      });
+    
+    if (entry == m_entries.end() && m_entries.size() >= MaxEntries)
+      return;
+    
+    m_entries.insert(entry, stats);
+    
+    if (m_entries.size() > MaxEntries)
+      m_entries.pop_back();
+  }
+  
+  
+  void DxvkBufferRenameLog::dump(LogLevel level) {
+    if (level < Logger::logLevel())
+      return;
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    // Include buffers that are still alive
+    for (auto buffer : m_buffers)
+      this->addEntry(buffer->renameStats());
+    
+    m_buffers.clear();
+    
+    if (m_entries.size() == 0)
+      return;
+    
+    Logger::log(level, "DxvkBuffer: Most frequently renamed buffers:");
+    
+    for (const auto& e : m_entries) {
+      Logger::log(level, str::format(
+        "  size: ", e.sliceSize,
+        ", hint: ", uint32_t(e.hint),
+        ", renames: ", e.renameCount,
+        ", rate: ", e.renameRate, "/s",
+        " (avg ", e.averageRate, "/s)",
+        ", slices: ", e.sliceCount,
+        " (peak ", e.slicePeak, ")",
+        ", shrunk: ", e.shrinkCount));
+    }
+  }
+  
+  
   DxvkBufferTracker:: DxvkBufferTracker() { }
   DxvkBufferTracker::~DxvkBufferTracker() { }
   
@@ -1,12 +1,35 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
+#include <unordered_set>
 #include <vector>
 
 #include "dxvk_buffer_res.h"
+#include "dxvk_uniform_ring.h"
 
 namespace dxvk {
   
+  /**
+   * \brief Buffer rename statistics
+   * 
+   * Describes how often a buffer has been
+   * invalidated and how large its pool of
+   * backing slices is.
+   */
+  struct DxvkBufferRenameStats {
+    DxvkBufferRenameHint  hint;         ///< Rename hint of the buffer
+    VkDeviceSize          sliceSize;    ///< Size of one slice, in bytes
+    uint64_t              renameCount;  ///< Total number of renames
+    float                 renameRate;   ///< Renames per second, last window
+    float                 averageRate;  ///< Renames per second, lifetime
+    uint32_t              sliceCount;   ///< Number of slices currently allocated
+    uint32_t              slicePeak;    ///< Highest number of slices ever allocated
+    uint32_t              shrinkCount;  ///< Number of times the pool was shrunk
+  };
+  
+  
   /**
    * \brief Virtual buffer resource
    * 
@@ -23,6 +46,8 @@ namespace dxvk {
       const DxvkBufferCreateInfo& createInfo,
             VkMemoryPropertyFlags memoryType);
     
+    ~DxvkBuffer();
+    
     /**
      * \brief Buffer properties
      * \returns Buffer properties
@@ -89,6 +114,18 @@ namespace dxvk {
       return m_physSlice;
     }
     
+    /**
+     * \brief Physical buffer slice, synchronized
+     * 
+     * Same as \ref slice, but can be called from threads
+     * other than the one that renames the buffer.
+     * \returns The backing slice
+     */
+    DxvkPhysicalBufferSlice lockedSlice() const {
+      std::lock_guard<sync::Spinlock> lock(m_sliceLock);
+      return m_physSlice;
+    }
+    
     /**
      * \brief Physical buffer sub slice
      * 
@@ -131,8 +168,67 @@ namespace dxvk {
     void freePhysicalSlice(
       const DxvkPhysicalBufferSlice& slice);
     
+    /**
+     * \brief Updates pool usage statistics
+     * 
+     * Called once per frame by the device so that the
+     * pool can shrink even if the buffer is no longer
+     * being renamed after a spike in usage.
+     */
+    void updatePool();
+    
+    /**
+     * \brief Checks whether the buffer uses the uniform ring
+     * \returns \c true if new slices are allocated from
+     *          the device's uniform ring
+     */
+    bool usesUniformRing() const {
+      return m_ringActive;
+    }
+    
+    /**
+     * \brief Stops allocating slices from the uniform ring
+     * 
+     * Only succeeds if the buffer has not been renamed for
+     * a while. Its current ring slice keeps an entire chunk
+     * of the ring alive, so the caller must rename the buffer
+     * once more, which will allocate from the buffer's own
+     * pool from now on. Must be called from the thread that
+     * allocates physical slices.
+     * \returns \c true if the buffer left the ring
+     */
+    bool leaveUniformRing();
+    
+    /**
+     * \brief Retrieves rename statistics
+     * 
+     * Only accurate when called from the thread
+     * that allocates physical slices, which is
+     * usually the one mapping the buffer.
+     * \returns Rename statistics for this buffer
+     */
+    DxvkBufferRenameStats renameStats() const;
+    
   private:
     
+    using Clock = std::chrono::high_resolution_clock;
+    
+    /// Time span over which slice usage is sampled
+    constexpr static auto RenameWindowLength = std::chrono::milliseconds(500);
+    
+    /// Number of consecutive windows with low slice
+    /// usage after which the pool will be shrunk
+    constexpr static uint32_t RenameShrinkWindows = 8;
+    
+    /// Maximum size of a backing buffer allocated
+    /// at once when the pool needs to grow
+    constexpr static VkDeviceSize MaxPhysBufferSize = 16 << 20;
+    
+    struct PhysBuffer {
+      Rc<DxvkPhysicalBuffer> buffer;
+      VkDeviceSize           sliceCount;
+    };
+    
     DxvkDevice*             m_device;
     DxvkBufferCreateInfo    m_info;
     VkMemoryPropertyFlags   m_memFlags;
@@ -140,19 +236,52 @@ namespace dxvk {
     DxvkPhysicalBufferSlice m_physSlice;
     uint32_t                m_revision = 0;
     
+    mutable sync::Spinlock  m_sliceLock;
+    
+    DxvkUniformRing*        m_ring       = nullptr;
+    bool                    m_ringActive = false;
+    
     std::mutex m_freeMutex;
     std::mutex m_swapMutex;
     
     std::vector<DxvkPhysicalBufferSlice> m_freeSlices;
     std::vector<DxvkPhysicalBufferSlice> m_nextSlices;
+    std::vector<PhysBuffer>              m_physBuffers;
     
     VkDeviceSize m_physSliceLength  = 0;
     VkDeviceSize m_physSliceStride  = 0;
     VkDeviceSize m_physSliceCount   = 2;
+    VkDeviceSize m_physSliceMin     = 2;
+    VkDeviceSize m_physSliceMax     = 2;
+    VkDeviceSize m_physSliceTotal   = 0;
+    VkDeviceSize m_physSlicePeak    = 0;
+    
+    std::atomic<uint32_t> m_slicesInUse = { 0u };
+    std::atomic<bool>     m_tracked     = { false };
+    std::atomic<bool>     m_ringIdle    = { false };
+    
+    Clock::time_point m_createTime;
+    Clock::time_point m_windowStart;
+    uint32_t          m_windowRenames   = 0;
+    uint32_t          m_windowPeakUsage = 0;
+    uint32_t          m_lowUsageWindows = 0;
+    uint32_t          m_idleWindows     = 0;
+    float             m_renameRate      = 0.0f;
+    uint64_t          m_renameCount     = 0;
+    uint32_t          m_shrinkCount     = 0;
     
     Rc<DxvkPhysicalBuffer> allocPhysicalBuffer(
             VkDeviceSize    sliceCount) const;
     
+    void updateRenameWindow(
+            uint32_t        slicesInUse);
+    
+    void shrinkPool(
+            uint32_t        slicesInUse);
+    
+    bool isActiveBuffer(
+            VkBuffer        handle) const;
+    
     void lock();
     void unlock();
     
@@ -389,6 +518,64 @@ namespace dxvk {
   };
   
   
+  /**
+   * \brief Buffer rename log
+   * 
+   * Keeps track of all buffers that have been renamed
+   * at least once, and collects rename statistics of
+   * the ones that were invalidated most often, so that
+   * they can be written to the log.
+   */
+  class DxvkBufferRenameLog {
+    constexpr static size_t MaxEntries = 16;
+  public:
+    
+    DxvkBufferRenameLog();
+    ~DxvkBufferRenameLog();
+    
+    /**
+     * \brief Starts tracking a buffer
+     * \param [in] buffer The buffer
+     */
+    void trackBuffer(
+            DxvkBuffer*            buffer);
+    
+    /**
+     * \brief Stops tracking a buffer
+     * 
+     * Called when the buffer gets destroyed. Records
+     * its statistics unless it has been renamed less
+     * often than the buffers already recorded.
+     * \param [in] buffer The buffer
+     */
+    void untrackBuffer(
+            DxvkBuffer*            buffer);
+    
+    /**
+     * \brief Updates pools of all tracked buffers
+     */
+    void updatePools();
+    
+    /**
+     * \brief Writes tracked buffers to the log
+     * 
+     * Includes buffers that are still alive.
+     * \param [in] level Log level to use
+     */
+    void dump(LogLevel level);
+    
+  private:
+    
+    std::mutex                          m_mutex;
+    std::unordered_set<DxvkBuffer*>     m_buffers;
+    std::vector<DxvkBufferRenameStats>  m_entries;
+    
+    void addEntry(
+      const DxvkBufferRenameStats& stats);
+    
+  };
+  
+  
   /**
    * \brief Buffer slice tracker
    * 
@@ -6,6 +6,21 @@
 
 namespace dxvk {
   
+  /**
+   * \brief Buffer rename hint
+   * 
+   * Tells the buffer how often it is expected to be
+   * invalidated, which determines how many backing
+   * slices are allocated at once when the buffer
+   * runs out of free slices.
+   */
+  enum class DxvkBufferRenameHint : uint32_t {
+    Static    = 0,  ///< Rarely or never invalidated
+    Dynamic   = 1,  ///< Invalidated about once per frame
+    Streaming = 2,  ///< Invalidated many times per frame
+  };
+  
+  
   /**
    * \brief Buffer create info
    * 
@@ -25,6 +40,9 @@ namespace dxvk {
     
     /// Allowed access patterns
     VkAccessFlags access;
+    
+    /// Expected invalidation frequency
+    DxvkBufferRenameHint renameHint = DxvkBufferRenameHint::Static;
   };
   
   
@@ -189,6 +207,19 @@ namespace dxvk {
       return m_buffer;
     }
     
+    /**
+     * \brief Checks whether two slices are identical
+     * 
+     * \param [in] other The slice to compare to
+     * \returns \c true if both slices refer to the
+     *          same range of the same physical buffer
+     */
+    bool matches(const DxvkPhysicalBufferSlice& other) const {
+      return m_buffer == other.m_buffer
+          && m_offset == other.m_offset
+          && m_length == other.m_length;
+    }
+    
   private:
     
     Rc<DxvkPhysicalBuffer> m_buffer = nullptr;
@@ -4,19 +4,25 @@
 namespace dxvk {
     
   DxvkCommandList::DxvkCommandList(
-    const Rc<vk::DeviceFn>& vkd,
-          DxvkDevice*       device,
-          uint32_t          queueFamily)
+    const Rc<vk::DeviceFn>&     vkd,
+          DxvkDevice*           device,
+          uint32_t              queueFamily,
+          VkCommandBufferLevel  level)
   : m_vkd         (vkd),
+    m_level       (level),
     m_descAlloc   (vkd),
     m_stagingAlloc(device) {
-    VkFenceCreateInfo fenceInfo;
-    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceInfo.pNext = nullptr;
-    fenceInfo.flags = 0;
-    
-    if (m_vkd->vkCreateFence(m_vkd->device(), &fenceInfo, nullptr, &m_fence) != VK_SUCCESS)
-      throw DxvkError("DxvkCommandList: Failed to create fence");
+    // Secondary command lists are never submitted
+    // on their own, so they do not need a fence
+    if (m_level == VK_COMMAND_BUFFER_LEVEL_PRIMARY) {
+      VkFenceCreateInfo fenceInfo;
+      fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+      fenceInfo.pNext = nullptr;
+      fenceInfo.flags = 0;
+      
+      if (m_vkd->vkCreateFence(m_vkd->device(), &fenceInfo, nullptr, &m_fence) != VK_SUCCESS)
+        throw DxvkError("DxvkCommandList: Failed to create fence");
+    }
     
     VkCommandPoolCreateInfo poolInfo;
     poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
@@ -31,7 +37,7 @@ namespace dxvk {
     cmdInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     cmdInfo.pNext             = nullptr;
     cmdInfo.commandPool       = m_pool;
-    cmdInfo.level             = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cmdInfo.level             = m_level;
     cmdInfo.commandBufferCount = 1;
     
     if (m_vkd->vkAllocateCommandBuffers(m_vkd->device(), &cmdInfo, &m_buffer) != VK_SUCCESS)
@@ -100,6 +106,31 @@ namespace dxvk {
   }
   
   
+  void DxvkCommandList::beginSecondaryRecording(
+          VkRenderPass    renderPass,
+          VkFramebuffer   framebuffer) {
+    VkCommandBufferInheritanceInfo inheritInfo;
+    inheritInfo.sType                 = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritInfo.pNext                 = nullptr;
+    inheritInfo.renderPass            = renderPass;
+    inheritInfo.subpass               = 0;
+    inheritInfo.framebuffer           = framebuffer;
+    inheritInfo.occlusionQueryEnable  = VK_FALSE;
+    inheritInfo.queryFlags            = 0;
+    inheritInfo.pipelineStatistics    = 0;
+    
+    VkCommandBufferBeginInfo info;
+    info.sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    info.pNext            = nullptr;
+    info.flags            = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT
+                          | VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+    info.pInheritanceInfo = &inheritInfo;
+    
+    if (m_vkd->vkBeginCommandBuffer(m_buffer, &info) != VK_SUCCESS)
+      Logger::err("DxvkCommandList: Failed to begin secondary command buffer");
+  }
+  
+  
   void DxvkCommandList::endRecording() {
     if (m_vkd->vkEndCommandBuffer(m_buffer) != VK_SUCCESS)
       Logger::err("DxvkCommandList::endRecording: Failed to record command buffer");
@@ -114,6 +145,19 @@ namespace dxvk {
     m_stagingAlloc.reset();
     m_descAlloc.reset();
     m_resources.reset();
+    
+    m_secondaryResources.clear();
+  }
+  
+  
+  void DxvkCommandList::cmdExecuteCommands(
+    const Rc<DxvkCommandList>&    cmdList) {
+    for (const auto& resource : cmdList->m_secondaryResources)
+      m_resources.trackResource(resource);
+    
+    m_statCounters.merge(cmdList->m_statCounters);
+    
+    m_vkd->vkCmdExecuteCommands(m_buffer, 1, &cmdList->m_buffer);
   }
   
   
@@ -24,17 +24,30 @@ namespace dxvk {
    * used by the recorded commands for automatic lifetime tracking.
    * When the command list has completed execution, resources that
    * are no longer used may get destroyed.
+   * 
+   * Secondary command lists are not submitted directly. Instead,
+   * they are executed by primary command lists, which then take
+   * over lifetime tracking for all resources used by them.
    */
   class DxvkCommandList : public RcObject {
     
   public:
     
     DxvkCommandList(
-      const Rc<vk::DeviceFn>& vkd,
-            DxvkDevice*       device,
-            uint32_t          queueFamily);
+      const Rc<vk::DeviceFn>&     vkd,
+            DxvkDevice*           device,
+            uint32_t              queueFamily,
+            VkCommandBufferLevel  level);
     ~DxvkCommandList();
     
+    /**
+     * \brief Command buffer level
+     * \returns Command buffer level
+     */
+    VkCommandBufferLevel level() const {
+      return m_level;
+    }
+    
     /**
      * \brief Submits command list
      * 
@@ -75,7 +88,7 @@ namespace dxvk {
      * \param [in] ctr The counter to increment
      * \param [in] val The value to add
      */
-    void addStatCtr(DxvkStatCounter ctr, uint32_t val) {
+    void addStatCtr(DxvkStatCounter ctr, uint64_t val) {
       m_statCounters.addCtr(ctr, val);
     }
     
@@ -87,6 +100,19 @@ namespace dxvk {
      */
     void beginRecording();
     
+    /**
+     * \brief Begins secondary command buffer recording
+     * 
+     * Secondary command buffers continue a render pass
+     * that is begun by the primary command buffer which
+     * executes them, and may be executed multiple times.
+     * \param [in] renderPass Compatible render pass
+     * \param [in] framebuffer The framebuffer
+     */
+    void beginSecondaryRecording(
+            VkRenderPass    renderPass,
+            VkFramebuffer   framebuffer);
+    
     /**
      * \brief Ends recording
      * 
@@ -117,10 +143,14 @@ namespace dxvk {
      * Adds a resource to the internal resource tracker.
      * Resources will be kept alive and "in use" until
      * the device can guarantee that the submission has
-     * completed.
+     * completed. Secondary command lists only keep the
+     * resource alive until it is used by a primary one.
      */
     void trackResource(const Rc<DxvkResource>& rc) {
-      m_resources.trackResource(rc);
+      if (m_level == VK_COMMAND_BUFFER_LEVEL_PRIMARY)
+        m_resources.trackResource(rc);
+      else
+        m_secondaryResources.push_back(rc);
     }
     
     /**
@@ -227,6 +257,18 @@ namespace dxvk {
     }
     
     
+    void cmdBindDescriptorSet(
+          VkPipelineBindPoint       pipeline,
+          VkPipelineLayout          pipelineLayout,
+          VkDescriptorSet           descriptorSet,
+          uint32_t                  dynamicOffsetCount,
+    const uint32_t*                 pDynamicOffsets) {
+      m_vkd->vkCmdBindDescriptorSets(m_buffer,
+        pipeline, pipelineLayout, 0, 1,
+        &descriptorSet, dynamicOffsetCount, pDynamicOffsets);
+    }
+    
+    
     void cmdBindIndexBuffer(
             VkBuffer                buffer,
             VkDeviceSize            offset,
@@ -425,6 +467,19 @@ namespace dxvk {
     }
     
     
+    /**
+     * \brief Executes a secondary command list
+     * 
+     * Takes over lifetime tracking for the resources used
+     * by the secondary command list. The caller must keep
+     * the command list itself alive until this command
+     * list is reset.
+     * \param [in] cmdList Secondary command list
+     */
+    void cmdExecuteCommands(
+      const Rc<DxvkCommandList>&    cmdList);
+    
+    
     void cmdFillBuffer(
             VkBuffer                dstBuffer,
             VkDeviceSize            dstOffset,
@@ -558,7 +613,8 @@ namespace dxvk {
     
     Rc<vk::DeviceFn>    m_vkd;
     
-    VkFence             m_fence;
+    VkCommandBufferLevel m_level;
+    VkFence             m_fence = VK_NULL_HANDLE;
     
     VkCommandPool       m_pool;
     VkCommandBuffer     m_buffer;
@@ -571,6 +627,8 @@ namespace dxvk {
     DxvkBufferTracker   m_bufferTracker;
     DxvkStatCounters    m_statCounters;
     
+    std::vector<Rc<DxvkResource>>     m_secondaryResources;
+    
   };
   
 }
\ No newline at end of file
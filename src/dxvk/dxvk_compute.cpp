@@ -25,12 +25,13 @@ namespace dxvk {
     DxvkDescriptorSlotMapping slotMapping;
     cs->defineResourceSlots(slotMapping);
     
-    m_layout = new DxvkPipelineLayout(m_vkd,
-      slotMapping.bindingCount(),
-      slotMapping.bindingInfos(),
-      VK_PIPELINE_BIND_POINT_COMPUTE);
+    slotMapping.makeUniformBuffersDynamic(device->adapter()
+      ->deviceProperties().limits.maxDescriptorSetUniformBuffersDynamic);
     
-    m_cs = cs->createShaderModule(m_vkd, slotMapping);
+    m_layout = device->createPipelineLayout(
+      slotMapping, VK_PIPELINE_BIND_POINT_COMPUTE);
+    
+    m_cs = cs->createShaderModule(m_vkd, m_device->shaderModuleCounters(), slotMapping);
   }
   
   
@@ -42,6 +43,8 @@ namespace dxvk {
   VkPipeline DxvkComputePipeline::getPipelineHandle(
     const DxvkComputePipelineStateInfo& state,
           DxvkStatCounters&             stats) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
     for (const PipelineStruct& pair : m_pipelines) {
       if (pair.stateVector == state)
         return pair.pipeline;
@@ -61,6 +64,8 @@ namespace dxvk {
   VkPipeline DxvkComputePipeline::compilePipeline(
     const DxvkComputePipelineStateInfo& state,
           VkPipeline                    baseHandle) const {
+    DXVK_PROFILE_ZONE("Compile compute pipeline");
+    
     std::vector<VkDescriptorSetLayoutBinding> bindings;
 
     if (Logger::logLevel() <= LogLevel::Debug) {
@@ -104,9 +109,12 @@ namespace dxvk {
       return VK_NULL_HANDLE;
     }
     
-    auto t1 = std::chrono::high_resolution_clock::now();
-    auto td = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
-    Logger::debug(str::format("DxvkComputePipeline: Finished in ", td.count(), " ms"));
+    if (Logger::logLevel() <= LogLevel::Debug) {
+      auto t1 = std::chrono::high_resolution_clock::now();
+      auto td = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+      Logger::debug(str::format("DxvkComputePipeline: Finished in ", td.count(), " ms"));
+    }
+    
     return pipeline;
   }
   
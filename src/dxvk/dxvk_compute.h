@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mutex>
+
 #include "dxvk_binding.h"
 #include "dxvk_pipecache.h"
 #include "dxvk_pipelayout.h"
@@ -55,6 +57,9 @@ namespace dxvk {
     /**
      * \brief Pipeline handle
      * 
+     * Compiles the pipeline if necessary. Pipeline
+     * objects are shared between contexts, so this
+     * method is thread-safe.
      * \param [in] state Pipeline state
      * \returns Pipeline handle
      */
@@ -76,6 +81,7 @@ namespace dxvk {
     Rc<DxvkPipelineLayout>  m_layout;
     Rc<DxvkShaderModule>    m_cs;
     
+    std::mutex                  m_mutex;
     std::vector<PipelineStruct> m_pipelines;
     
     VkPipeline m_basePipeline = VK_NULL_HANDLE;
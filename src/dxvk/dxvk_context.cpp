@@ -9,11 +9,14 @@ namespace dxvk {
   DxvkContext::DxvkContext(
     const Rc<DxvkDevice>&           device,
     const Rc<DxvkPipelineCache>&    pipelineCache,
-    const Rc<DxvkMetaClearObjects>& metaClearObjects)
+    const Rc<DxvkPipelineManager>&  pipelineManager,
+    const Rc<DxvkMetaClearObjects>& metaClearObjects,
+    const Rc<DxvkMetaMipGenObjects>& metaMipGenObjects)
   : m_device    (device),
     m_pipeCache (pipelineCache),
-    m_pipeMgr   (new DxvkPipelineManager(device.ptr())),
-    m_metaClear (metaClearObjects) { }
+    m_pipeMgr   (pipelineManager),
+    m_metaClear (metaClearObjects),
+    m_metaMipGen(metaMipGenObjects) { }
   
   
   DxvkContext::~DxvkContext() {
@@ -60,7 +63,99 @@ namespace dxvk {
   }
   
   
+  void DxvkContext::beginSecondaryRecording() {
+    m_secondary       = new DxvkSecondaryCommands(m_device);
+    m_secondaryFailed = false;
+    
+    // A secondary command list is only created once
+    // a render pass is begun, see renderPassBegin.
+    m_cmd = nullptr;
+    
+    m_flags.clr(
+      DxvkContextFlag::GpRenderPassBound);
+    
+    m_flags.set(
+      DxvkContextFlag::GpDirtyPipeline,
+      DxvkContextFlag::GpDirtyPipelineState,
+      DxvkContextFlag::GpDirtyResources,
+      DxvkContextFlag::GpDirtyVertexBuffers,
+      DxvkContextFlag::GpDirtyIndexBuffer,
+      DxvkContextFlag::CpDirtyPipeline,
+      DxvkContextFlag::CpDirtyPipelineState,
+      DxvkContextFlag::CpDirtyResources);
+  }
+  
+  
+  Rc<DxvkSecondaryCommands> DxvkContext::endSecondaryRecording() {
+    this->renderPassEnd();
+    
+    m_cmd = nullptr;
+    m_secondarySlices.clear();
+    
+    Rc<DxvkSecondaryCommands> commands = std::exchange(m_secondary, nullptr);
+    return m_secondaryFailed ? nullptr : commands;
+  }
+  
+  
+  bool DxvkContext::executeSecondaryCommands(
+    const Rc<DxvkSecondaryCommands>& commands) {
+    // Secondary command lists do not inherit queries, and
+    // buffer invalidations can only be applied once
+    if (!m_activeQueries.empty() || commands->renamesApplied)
+      return false;
+    
+    for (const auto& entry : commands->bufferSlices) {
+      if (!entry.buffer->slice().matches(entry.slice))
+        return false;
+    }
+    
+    if (!commands->segments.empty()) {
+      this->renderPassEnd();
+      
+      // Keeps the secondary command lists alive
+      // until this command list has completed
+      m_cmd->trackResource(commands);
+      
+      for (const auto& segment : commands->segments) {
+        this->renderPassBindFramebuffer(
+          segment.framebuffer,
+          segment.renderPassOps,
+          segment.colorClearValues.data(),
+          segment.depthClearValue,
+          VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        
+        m_cmd->cmdExecuteCommands(segment.cmdList);
+        
+        this->renderPassUnbindFramebuffer();
+      }
+      
+      // All command buffer state is undefined
+      // after executing secondary command buffers
+      m_flags.set(
+        DxvkContextFlag::GpDirtyPipeline,
+        DxvkContextFlag::GpDirtyPipelineState,
+        DxvkContextFlag::GpDirtyResources,
+        DxvkContextFlag::GpDirtyVertexBuffers,
+        DxvkContextFlag::GpDirtyIndexBuffer,
+        DxvkContextFlag::CpDirtyPipeline,
+        DxvkContextFlag::CpDirtyPipelineState,
+        DxvkContextFlag::CpDirtyResources);
+    }
+    
+    for (const auto& rename : commands->bufferRenames)
+      this->invalidateBuffer(rename.buffer, rename.slice);
+    
+    if (!commands->bufferRenames.empty())
+      commands->renamesApplied = true;
+    
+    return true;
+  }
+  
+  
   void DxvkContext::beginQuery(const DxvkQueryRevision& query) {
+    if (this->secondaryUnsupported())
+      return;
+    
     DxvkQueryHandle handle = this->allocQuery(query);
     
     m_cmd->cmdBeginQuery(
@@ -74,6 +169,9 @@ namespace dxvk {
   
   
   void DxvkContext::endQuery(const DxvkQueryRevision& query) {
+    if (this->secondaryUnsupported())
+      return;
+    
     DxvkQueryHandle handle = query.query->getHandle();
     
     m_cmd->cmdEndQuery(
@@ -88,7 +186,8 @@ namespace dxvk {
   void DxvkContext::bindFramebuffer(const Rc<DxvkFramebuffer>& fb) {
     if (m_state.om.framebuffer != fb) {
       this->renderPassEnd();
-      m_state.om.framebuffer = fb;
+      m_state.om.framebuffer   = fb;
+      m_state.om.renderPassOps = DxvkRenderPassOps();
       
       if (fb != nullptr) {
         m_state.gp.state.msSampleCount = fb->sampleCount();
@@ -128,6 +227,15 @@ namespace dxvk {
   }
   
   
+  void DxvkContext::bindResourceBuffers(
+          uint32_t              firstSlot,
+          uint32_t              count,
+    const DxvkBufferSlice*      buffers) {
+    for (uint32_t i = 0; i < count; i++)
+      this->bindResourceBuffer(firstSlot + i, buffers[i]);
+  }
+  
+  
   void DxvkContext::bindResourceView(
           uint32_t              slot,
     const Rc<DxvkImageView>&    imageView,
@@ -146,6 +254,16 @@ namespace dxvk {
   }
   
   
+  void DxvkContext::bindResourceViews(
+          uint32_t              firstSlot,
+          uint32_t              count,
+    const Rc<DxvkImageView>*    imageViews,
+    const Rc<DxvkBufferView>*   bufferViews) {
+    for (uint32_t i = 0; i < count; i++)
+      this->bindResourceView(firstSlot + i, imageViews[i], bufferViews[i]);
+  }
+  
+  
   void DxvkContext::bindResourceSampler(
           uint32_t              slot,
     const Rc<DxvkSampler>&      sampler) {
@@ -162,6 +280,15 @@ namespace dxvk {
   }
   
   
+  void DxvkContext::bindResourceSamplers(
+          uint32_t              firstSlot,
+          uint32_t              count,
+    const Rc<DxvkSampler>*      samplers) {
+    for (uint32_t i = 0; i < count; i++)
+      this->bindResourceSampler(firstSlot + i, samplers[i]);
+  }
+  
+  
   void DxvkContext::bindShader(
           VkShaderStageFlagBits stage,
     const Rc<DxvkShader>&       shader) {
@@ -180,16 +307,17 @@ namespace dxvk {
     if (shaderStage->shader != shader) {
       shaderStage->shader = shader;
       
+      // Resources only need to be rebound if the
+      // pipeline layout changes, which is checked
+      // when the new pipeline object is looked up.
       if (stage == VK_SHADER_STAGE_COMPUTE_BIT) {
         m_flags.set(
           DxvkContextFlag::CpDirtyPipeline,
-          DxvkContextFlag::CpDirtyPipelineState,
-          DxvkContextFlag::CpDirtyResources);
+          DxvkContextFlag::CpDirtyPipelineState);
       } else {
         m_flags.set(
           DxvkContextFlag::GpDirtyPipeline,
-          DxvkContextFlag::GpDirtyPipelineState,
-          DxvkContextFlag::GpDirtyResources);
+          DxvkContextFlag::GpDirtyPipelineState);
       }
     }
   }
@@ -211,11 +339,24 @@ namespace dxvk {
   }
   
   
+  void DxvkContext::bindVertexBuffers(
+          uint32_t              firstBinding,
+          uint32_t              count,
+    const DxvkBufferSlice*      buffers,
+    const uint32_t*             strides) {
+    for (uint32_t i = 0; i < count; i++)
+      this->bindVertexBuffer(firstBinding + i, buffers[i], strides[i]);
+  }
+  
+  
   void DxvkContext::clearBuffer(
     const Rc<DxvkBuffer>&       buffer,
           VkDeviceSize          offset,
           VkDeviceSize          length,
           uint32_t              value) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->renderPassEnd();
     
     auto slice = buffer->subSlice(offset, length);
@@ -242,6 +383,9 @@ namespace dxvk {
           VkDeviceSize          offset,
           VkDeviceSize          length,
           VkClearColorValue     value) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->renderPassEnd();
     this->unbindComputePipeline();
     
@@ -309,6 +453,9 @@ namespace dxvk {
     const Rc<DxvkImage>&            image,
     const VkClearColorValue&        value,
     const VkImageSubresourceRange&  subresources) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->renderPassEnd();
     
     m_barriers.accessImage(image, subresources,
@@ -341,6 +488,9 @@ namespace dxvk {
     const Rc<DxvkImage>&            image,
     const VkClearDepthStencilValue& value,
     const VkImageSubresourceRange&  subresources) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->renderPassEnd();
     
     m_barriers.accessImage(
@@ -385,6 +535,9 @@ namespace dxvk {
       attachmentIndex = m_state.om.framebuffer->findAttachment(imageView);
     
     if (attachmentIndex == MaxNumRenderTargets) {
+      if (this->secondaryUnsupported())
+        return;
+      
       this->renderPassEnd();
       
       // Set up and bind a temporary framebuffer
@@ -398,8 +551,57 @@ namespace dxvk {
           VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
       }
       
-      this->renderPassBindFramebuffer(
-        m_device->createFramebuffer(attachments));
+      Rc<DxvkFramebuffer> framebuffer = m_device->createFramebuffer(attachments);
+      
+      // If the entire view is cleared, let the render pass
+      // perform the clear and skip the clear command.
+      if (this->clearCoversFramebuffer(framebuffer, clearRect)) {
+        DxvkRenderPassOps ops;
+        std::array<VkClearValue, MaxNumRenderTargets> colorClearValues = { };
+        
+        if (clearAspects & VK_IMAGE_ASPECT_COLOR_BIT) {
+          ops.colorLoadOps[0] = VK_ATTACHMENT_LOAD_OP_CLEAR;
+          colorClearValues[0] = clearValue;
+        }
+        
+        if (clearAspects & VK_IMAGE_ASPECT_DEPTH_BIT)
+          ops.depthLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        
+        if (clearAspects & VK_IMAGE_ASPECT_STENCIL_BIT)
+          ops.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        
+        this->renderPassBindFramebuffer(framebuffer, ops,
+          colorClearValues.data(), clearValue,
+          VK_SUBPASS_CONTENTS_INLINE);
+        this->renderPassUnbindFramebuffer();
+        return;
+      }
+      
+      this->renderPassBindFramebuffer(framebuffer, DxvkRenderPassOps(),
+        m_state.om.colorClearValues.data(), m_state.om.depthClearValue,
+        VK_SUBPASS_CONTENTS_INLINE);
+    } else if (!m_flags.test(DxvkContextFlag::GpRenderPassBound)
+            && this->clearCoversFramebuffer(m_state.om.framebuffer, clearRect)) {
+      // The render pass has not started yet, so we can fold
+      // the clear into the load op of the attachment. Later
+      // clears to the same attachment replace earlier ones.
+      if (clearAspects & VK_IMAGE_ASPECT_COLOR_BIT) {
+        m_state.om.renderPassOps.colorLoadOps[attachmentIndex] = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        m_state.om.colorClearValues[attachmentIndex] = clearValue;
+      }
+      
+      if (clearAspects & VK_IMAGE_ASPECT_DEPTH_BIT) {
+        m_state.om.renderPassOps.depthLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        m_state.om.depthClearValue.depthStencil.depth = clearValue.depthStencil.depth;
+      }
+      
+      if (clearAspects & VK_IMAGE_ASPECT_STENCIL_BIT) {
+        m_state.om.renderPassOps.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        m_state.om.depthClearValue.depthStencil.stencil = clearValue.depthStencil.stencil;
+      }
+      
+      m_flags.set(DxvkContextFlag::GpClearRenderTargets);
+      return;
     } else {
       // Make sure that the currently bound
       // framebuffer can be rendered to
@@ -430,6 +632,9 @@ namespace dxvk {
           VkOffset3D            offset,
           VkExtent3D            extent,
           VkClearColorValue     value) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->renderPassEnd();
     this->unbindComputePipeline();
     
@@ -510,6 +715,9 @@ namespace dxvk {
     const Rc<DxvkBuffer>&       srcBuffer,
           VkDeviceSize          srcOffset,
           VkDeviceSize          numBytes) {
+    if (this->secondaryUnsupported())
+      return;
+    
     if (numBytes == 0)
       return;
     
@@ -555,6 +763,9 @@ namespace dxvk {
     const Rc<DxvkBuffer>&       srcBuffer,
           VkDeviceSize          srcOffset,
           VkExtent2D            srcExtent) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->renderPassEnd();
     
     auto srcSlice = srcBuffer->subSlice(srcOffset, 0);
@@ -619,6 +830,9 @@ namespace dxvk {
           VkImageSubresourceLayers srcSubresource,
           VkOffset3D            srcOffset,
           VkExtent3D            extent) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->renderPassEnd();
     
     VkImageSubresourceRange dstSubresourceRange = {
@@ -751,6 +965,9 @@ namespace dxvk {
           VkImageSubresourceLayers srcSubresource,
           VkOffset3D            srcOffset,
           VkExtent3D            srcExtent) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->renderPassEnd();
     
     auto dstSlice = dstBuffer->subSlice(dstOffset, 0);
@@ -805,10 +1022,84 @@ namespace dxvk {
   }
   
   
+  void DxvkContext::discardImage(
+    const Rc<DxvkImage>&            image,
+    const VkImageSubresourceRange&  subresources) {
+    // We cannot change the load ops of a render pass that has
+    // already started, and ending it would likely cost more
+    // than skipping the load could ever save.
+    if (m_flags.test(DxvkContextFlag::GpRenderPassBound))
+      return;
+    
+    DxvkRenderPassOps& ops = m_state.om.renderPassOps;
+    bool isAttachment = false;
+    
+    if (m_state.om.framebuffer != nullptr) {
+      const DxvkRenderTargets& renderTargets = m_state.om.framebuffer->renderTargets();
+      
+      if (this->discardCoversView(renderTargets.getDepthTarget().view, image, subresources)) {
+        ops.depthLoadOp   = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        ops.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        isAttachment = true;
+      }
+      
+      for (uint32_t i = 0; i < MaxNumRenderTargets; i++) {
+        if (this->discardCoversView(renderTargets.getColorTarget(i).view, image, subresources)) {
+          ops.colorLoadOps[i] = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+          isAttachment = true;
+        }
+      }
+    }
+    
+    if (isAttachment) {
+      // A discard may replace pending clears, in
+      // which case we don't need a clear-only pass
+      bool hasClears = ops.depthLoadOp   == VK_ATTACHMENT_LOAD_OP_CLEAR
+                    || ops.stencilLoadOp == VK_ATTACHMENT_LOAD_OP_CLEAR;
+      
+      for (uint32_t i = 0; i < MaxNumRenderTargets; i++)
+        hasClears |= ops.colorLoadOps[i] == VK_ATTACHMENT_LOAD_OP_CLEAR;
+      
+      if (!hasClears)
+        m_flags.clr(DxvkContextFlag::GpClearRenderTargets);
+      return;
+    }
+    
+    // Layout transitions must include all aspects of
+    // depth-stencil images, so partial discards of such
+    // images are ignored.
+    if ((subresources.aspectMask & image->formatInfo()->aspectMask)
+     != image->formatInfo()->aspectMask)
+      return;
+    
+    // Discards are only a hint, so secondary command
+    // lists can just keep the image contents intact
+    if (m_secondary != nullptr)
+      return;
+    
+    // Transitioning from an undefined layout allows the
+    // implementation to discard the previous contents.
+    m_barriers.accessImage(
+      image, subresources,
+      VK_IMAGE_LAYOUT_UNDEFINED,
+      image->info().stages,
+      image->info().access,
+      image->info().layout,
+      image->info().stages,
+      image->info().access);
+    m_barriers.recordCommands(m_cmd);
+    
+    m_cmd->trackResource(image);
+  }
+  
+  
   void DxvkContext::dispatch(
           uint32_t x,
           uint32_t y,
           uint32_t z) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->commitComputeState();
     
     if (this->validateComputeState()) {
@@ -823,6 +1114,9 @@ namespace dxvk {
   
   void DxvkContext::dispatchIndirect(
     const DxvkBufferSlice&  buffer) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->commitComputeState();
     
     auto physicalSlice = buffer.physicalSlice();
@@ -852,7 +1146,8 @@ namespace dxvk {
         firstVertex, firstInstance);
     }
     
-    m_cmd->addStatCtr(DxvkStatCounter::CmdDrawCalls, 1);
+    if (m_cmd != nullptr)
+      m_cmd->addStatCtr(DxvkStatCounter::CmdDrawCalls, 1);
   }
   
   
@@ -863,7 +1158,7 @@ namespace dxvk {
     this->commitGraphicsState();
     
     if (this->validateGraphicsState()) {
-      auto physicalSlice = buffer.physicalSlice();
+      auto physicalSlice = this->getPhysicalSlice(buffer);
       
       m_cmd->cmdDrawIndirect(
         physicalSlice.handle(),
@@ -871,7 +1166,8 @@ namespace dxvk {
         count, stride);
     }
     
-    m_cmd->addStatCtr(DxvkStatCounter::CmdDrawCalls, 1);
+    if (m_cmd != nullptr)
+      m_cmd->addStatCtr(DxvkStatCounter::CmdDrawCalls, 1);
   }
   
   
@@ -890,7 +1186,8 @@ namespace dxvk {
         firstInstance);
     }
     
-    m_cmd->addStatCtr(DxvkStatCounter::CmdDrawCalls, 1);
+    if (m_cmd != nullptr)
+      m_cmd->addStatCtr(DxvkStatCounter::CmdDrawCalls, 1);
   }
   
   
@@ -901,7 +1198,7 @@ namespace dxvk {
     this->commitGraphicsState();
     
     if (this->validateGraphicsState()) {
-      auto physicalSlice = buffer.physicalSlice();
+      auto physicalSlice = this->getPhysicalSlice(buffer);
       
       m_cmd->cmdDrawIndexedIndirect(
         physicalSlice.handle(),
@@ -909,13 +1206,17 @@ namespace dxvk {
         count, stride);
     }
     
-    m_cmd->addStatCtr(DxvkStatCounter::CmdDrawCalls, 1);
+    if (m_cmd != nullptr)
+      m_cmd->addStatCtr(DxvkStatCounter::CmdDrawCalls, 1);
   }
   
   
   void DxvkContext::initImage(
     const Rc<DxvkImage>&           image,
     const VkImageSubresourceRange& subresources) {
+    if (this->secondaryUnsupported())
+      return;
+    
     m_barriers.accessImage(image, subresources,
       VK_IMAGE_LAYOUT_UNDEFINED,
       VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0,
@@ -931,10 +1232,21 @@ namespace dxvk {
   void DxvkContext::generateMipmaps(
     const Rc<DxvkImage>&            image,
     const VkImageSubresourceRange&  subresources) {
+    if (this->secondaryUnsupported())
+      return;
+    
     if (subresources.levelCount <= 1)
       return;
     
     this->renderPassEnd();
+    
+    // Generating multiple levels per dispatch is much cheaper
+    // than a blit and a barrier per level, so use the compute
+    // path whenever the image supports it.
+    if (DxvkMetaMipGenObjects::supportsImage(image)) {
+      this->generateMipmapsCompute(image, subresources);
+      return;
+    }
 
     // The top-most level will only be read. We can
     // discard the contents of all the lower levels
@@ -1052,9 +1364,26 @@ namespace dxvk {
   void DxvkContext::invalidateBuffer(
     const Rc<DxvkBuffer>&           buffer,
     const DxvkPhysicalBufferSlice&  slice) {
-    // Allocate new backing resource
-    DxvkPhysicalBufferSlice prevSlice = buffer->rename(slice);
-    m_cmd->freePhysicalBufferSlice(buffer, prevSlice);
+    bool sameHandle = false;
+    
+    if (m_secondary != nullptr) {
+      // The buffer may still be in use by the primary command
+      // list, so the rename is deferred until the secondary
+      // command lists get executed.
+      auto entry = m_secondarySlices.find(buffer.ptr());
+      
+      if (entry != m_secondarySlices.end())
+        sameHandle = entry->second.handle() == slice.handle();
+      
+      m_secondary->bufferRenames.push_back({ buffer, slice });
+      m_secondarySlices[buffer.ptr()] = slice;
+    } else {
+      // Allocate new backing resource
+      DxvkPhysicalBufferSlice prevSlice = buffer->rename(slice);
+      m_cmd->freePhysicalBufferSlice(buffer, prevSlice);
+      
+      sameHandle = prevSlice.handle() == slice.handle();
+    }
     
     // We also need to update all bindings that the buffer
     // may be bound to either directly or through views.
@@ -1066,12 +1395,23 @@ namespace dxvk {
     if (usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
       m_flags.set(DxvkContextFlag::GpDirtyVertexBuffers);
     
-    if (usage & (VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT
-               | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+    if (usage & (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
                | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT
-               | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT))
+               | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT)) {
       m_flags.set(DxvkContextFlag::GpDirtyResources,
                   DxvkContextFlag::CpDirtyResources);
+    } else if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) {
+      // If the new slice is part of the same Vulkan buffer,
+      // only the dynamic offset of the binding has changed
+      // and we don't need to write new descriptors.
+      if (sameHandle) {
+        m_flags.set(DxvkContextFlag::GpDirtyDescriptorOffsets,
+                    DxvkContextFlag::CpDirtyDescriptorOffsets);
+      } else {
+        m_flags.set(DxvkContextFlag::GpDirtyResources,
+                    DxvkContextFlag::CpDirtyResources);
+      }
+    }
   }
   
   
@@ -1081,6 +1421,9 @@ namespace dxvk {
     const Rc<DxvkImage>&            srcImage,
     const VkImageSubresourceLayers& srcSubresources,
           VkFormat                  format) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->renderPassEnd();
     
     if (format == VK_FORMAT_UNDEFINED)
@@ -1188,6 +1531,9 @@ namespace dxvk {
           VkDeviceSize              offset,
           VkDeviceSize              size,
     const void*                     data) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->renderPassEnd();
     
     // Vulkan specifies that small amounts of data (up to 64kB) can
@@ -1234,6 +1580,9 @@ namespace dxvk {
     const void*                     data,
           VkDeviceSize              pitchPerRow,
           VkDeviceSize              pitchPerLayer) {
+    if (this->secondaryUnsupported())
+      return;
+    
     this->renderPassEnd();
     
     // Upload data through a staging buffer. Special care needs to
@@ -1331,15 +1680,19 @@ namespace dxvk {
       }
     }
     
-    m_cmd->cmdSetViewport(0, viewportCount, m_state.vp.viewports.data());
-    m_cmd->cmdSetScissor (0, viewportCount, m_state.vp.scissorRects.data());
+    if (m_secondary == nullptr || m_flags.test(DxvkContextFlag::GpRenderPassBound)) {
+      m_cmd->cmdSetViewport(0, viewportCount, m_state.vp.viewports.data());
+      m_cmd->cmdSetScissor (0, viewportCount, m_state.vp.scissorRects.data());
+    }
   }
   
   
   void DxvkContext::setBlendConstants(
     const DxvkBlendConstants&   blendConstants) {
     m_state.om.blendConstants = blendConstants;
-    m_cmd->cmdSetBlendConstants(&blendConstants.r);
+    
+    if (m_secondary == nullptr || m_flags.test(DxvkContextFlag::GpRenderPassBound))
+      m_cmd->cmdSetBlendConstants(&blendConstants.r);
   }
   
   
@@ -1347,9 +1700,11 @@ namespace dxvk {
     const uint32_t            reference) {
     m_state.om.stencilReference = reference;
     
-    m_cmd->cmdSetStencilReference(
-      VK_STENCIL_FRONT_AND_BACK,
-      reference);
+    if (m_secondary == nullptr || m_flags.test(DxvkContextFlag::GpRenderPassBound)) {
+      m_cmd->cmdSetStencilReference(
+        VK_STENCIL_FRONT_AND_BACK,
+        reference);
+    }
   }
   
   
@@ -1471,11 +1826,17 @@ namespace dxvk {
   
   
   void DxvkContext::signalEvent(const DxvkEventRevision& event) {
+    if (this->secondaryUnsupported())
+      return;
+    
     m_cmd->trackEvent(event);
   }
   
   
   void DxvkContext::writeTimestamp(const DxvkQueryRevision& query) {
+    if (this->secondaryUnsupported())
+      return;
+    
     DxvkQueryHandle handle = this->allocQuery(query);
     
     m_cmd->cmdWriteTimestamp(
@@ -1486,41 +1847,277 @@ namespace dxvk {
   }
   
   
+  void DxvkContext::generateMipmapsCompute(
+    const Rc<DxvkImage>&            image,
+    const VkImageSubresourceRange&  subresources) {
+    constexpr uint32_t MaxLevelsPerPass = DxvkMetaMipGenObjects::MaxLevelsPerPass;
+    
+    this->unbindComputePipeline();
+    
+    const DxvkMetaMipGenPipeline pipeInfo = m_metaMipGen->getPipeline();
+    
+    // All levels are accessed in the GENERAL layout. The top-most
+    // level will only be read, and the contents of all the lower
+    // levels can be discarded since they will be overwritten.
+    m_barriers.accessImage(image,
+      VkImageSubresourceRange {
+        subresources.aspectMask,
+        subresources.baseMipLevel, 1,
+        subresources.baseArrayLayer,
+        subresources.layerCount },
+      image->info().layout,
+      image->info().stages,
+      image->info().access,
+      VK_IMAGE_LAYOUT_GENERAL,
+      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      VK_ACCESS_SHADER_READ_BIT);
+    
+    m_barriers.accessImage(image,
+      VkImageSubresourceRange {
+        subresources.aspectMask,
+        subresources.baseMipLevel + 1,
+        subresources.levelCount - 1,
+        subresources.baseArrayLayer,
+        subresources.layerCount },
+      VK_IMAGE_LAYOUT_UNDEFINED,
+      image->info().stages,
+      image->info().access,
+      VK_IMAGE_LAYOUT_GENERAL,
+      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      VK_ACCESS_SHADER_WRITE_BIT);
+    
+    m_barriers.recordCommands(m_cmd);
+    
+    m_cmd->cmdBindPipeline(
+      VK_PIPELINE_BIND_POINT_COMPUTE,
+      pipeInfo.pipeline);
+    
+    DxvkImageViewCreateInfo viewInfo;
+    viewInfo.type      = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+    viewInfo.format    = image->info().format;
+    viewInfo.aspect    = subresources.aspectMask;
+    viewInfo.numLevels = 1;
+    viewInfo.minLayer  = subresources.baseArrayLayer;
+    viewInfo.numLayers = subresources.layerCount;
+    
+    uint32_t srcLevel = subresources.baseMipLevel;
+    uint32_t endLevel = subresources.baseMipLevel + subresources.levelCount;
+    
+    while (srcLevel + 1 < endLevel) {
+      const uint32_t levelCount = DxvkMetaMipGenObjects::getLevelCount(
+        image, srcLevel, endLevel - srcLevel - 1);
+      
+      // Create views for the source level and each destination
+      // level. Unused destination descriptors point to the last
+      // level that is written, but will never be accessed.
+      std::array<Rc<DxvkImageView>,     MaxLevelsPerPass + 1> views;
+      std::array<VkDescriptorImageInfo, MaxLevelsPerPass + 1> viewInfos;
+      
+      for (uint32_t i = 0; i <= MaxLevelsPerPass; i++) {
+        if (i <= levelCount) {
+          viewInfo.minLevel = srcLevel + i;
+          views[i] = m_device->createImageView(image, viewInfo);
+          m_cmd->trackResource(views[i]);
+        }
+        
+        viewInfos[i].sampler     = VK_NULL_HANDLE;
+        viewInfos[i].imageView   = views[std::min(i, levelCount)]->handle();
+        viewInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+      }
+      
+      VkDescriptorSet descriptorSet =
+        m_cmd->allocateDescriptorSet(pipeInfo.dsetLayout);
+      
+      std::array<VkWriteDescriptorSet, 2> descriptorWrites;
+      
+      for (uint32_t i = 0; i < descriptorWrites.size(); i++) {
+        descriptorWrites[i].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[i].pNext            = nullptr;
+        descriptorWrites[i].dstSet           = descriptorSet;
+        descriptorWrites[i].dstBinding       = i;
+        descriptorWrites[i].dstArrayElement  = 0;
+        descriptorWrites[i].pBufferInfo      = nullptr;
+        descriptorWrites[i].pTexelBufferView = nullptr;
+      }
+      
+      descriptorWrites[0].descriptorCount  = 1;
+      descriptorWrites[0].descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+      descriptorWrites[0].pImageInfo       = &viewInfos[0];
+      
+      descriptorWrites[1].descriptorCount  = MaxLevelsPerPass;
+      descriptorWrites[1].descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+      descriptorWrites[1].pImageInfo       = &viewInfos[1];
+      
+      m_cmd->updateDescriptorSets(
+        descriptorWrites.size(),
+        descriptorWrites.data());
+      
+      // Prepare shader arguments
+      const VkExtent3D srcExtent = image->mipLevelExtent(srcLevel);
+      const VkExtent3D dstExtent = image->mipLevelExtent(srcLevel + 1);
+      
+      DxvkMetaMipGenArgs pushArgs;
+      pushArgs.srcExtent  = VkExtent2D { srcExtent.width, srcExtent.height };
+      pushArgs.levelCount = levelCount;
+      
+      VkExtent3D workgroups = util::computeBlockCount(
+        VkExtent3D { dstExtent.width, dstExtent.height, 1 },
+        pipeInfo.workgroupSize);
+      workgroups.depth = subresources.layerCount;
+      
+      m_cmd->cmdBindDescriptorSet(
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        pipeInfo.pipeLayout, descriptorSet);
+      m_cmd->cmdPushConstants(
+        pipeInfo.pipeLayout,
+        VK_SHADER_STAGE_COMPUTE_BIT,
+        0, sizeof(pushArgs), &pushArgs);
+      m_cmd->cmdDispatch(
+        workgroups.width,
+        workgroups.height,
+        workgroups.depth);
+      
+      srcLevel += levelCount;
+      
+      // The last level written by this pass is
+      // the source level of the next pass
+      if (srcLevel + 1 < endLevel) {
+        m_barriers.accessImage(image,
+          VkImageSubresourceRange {
+            subresources.aspectMask, srcLevel, 1,
+            subresources.baseArrayLayer,
+            subresources.layerCount },
+          VK_IMAGE_LAYOUT_GENERAL,
+          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+          VK_ACCESS_SHADER_WRITE_BIT,
+          VK_IMAGE_LAYOUT_GENERAL,
+          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+          VK_ACCESS_SHADER_READ_BIT);
+        m_barriers.recordCommands(m_cmd);
+      }
+    }
+    
+    // Transform mip levels back into their original layout
+    m_barriers.accessImage(image, subresources,
+      VK_IMAGE_LAYOUT_GENERAL,
+      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      VK_ACCESS_SHADER_READ_BIT |
+      VK_ACCESS_SHADER_WRITE_BIT,
+      image->info().layout,
+      image->info().stages,
+      image->info().access);
+    m_barriers.recordCommands(m_cmd);
+    
+    m_cmd->trackResource(image);
+  }
+  
+  
   void DxvkContext::renderPassBegin() {
     if (!m_flags.test(DxvkContextFlag::GpRenderPassBound)
      && (m_state.om.framebuffer != nullptr)) {
       m_flags.set(DxvkContextFlag::GpRenderPassBound);
-      this->renderPassBindFramebuffer(m_state.om.framebuffer);
+      m_flags.clr(DxvkContextFlag::GpClearRenderTargets);
+      
+      if (m_secondary != nullptr) {
+        // The render pass will be started by the primary
+        // command list, we only record its contents here
+        DxvkSecondarySegment segment;
+        segment.framebuffer      = m_state.om.framebuffer;
+        segment.renderPassOps    = m_state.om.renderPassOps;
+        segment.colorClearValues = m_state.om.colorClearValues;
+        segment.depthClearValue  = m_state.om.depthClearValue;
+        m_secondary->segments.push_back(std::move(segment));
+        
+        m_cmd = m_device->createSecondaryCommandList();
+        m_cmd->beginSecondaryRecording(
+          m_state.om.framebuffer->renderPass(),
+          m_state.om.framebuffer->handle());
+        m_cmd->trackResource(m_state.om.framebuffer);
+        
+        // Secondary command buffers do not inherit any state
+        m_flags.set(
+          DxvkContextFlag::GpDirtyPipeline,
+          DxvkContextFlag::GpDirtyPipelineState,
+          DxvkContextFlag::GpDirtyResources,
+          DxvkContextFlag::GpDirtyVertexBuffers,
+          DxvkContextFlag::GpDirtyIndexBuffer);
+      } else {
+        this->renderPassBindFramebuffer(
+          m_state.om.framebuffer,
+          m_state.om.renderPassOps,
+          m_state.om.colorClearValues.data(),
+          m_state.om.depthClearValue,
+          VK_SUBPASS_CONTENTS_INLINE);
+      }
+      
+      // Clears only apply to the first render pass
+      m_state.om.renderPassOps = DxvkRenderPassOps();
     }
   }
   
   
   void DxvkContext::renderPassEnd() {
+    // Render passes are only started when something is drawn,
+    // but pending clears still need to be executed. In that
+    // case, we emit a render pass that only performs clears.
+    if (m_flags.test(DxvkContextFlag::GpClearRenderTargets))
+      this->renderPassBegin();
+    
     if (m_flags.test(DxvkContextFlag::GpRenderPassBound)) {
       m_flags.clr(DxvkContextFlag::GpRenderPassBound);
-      this->renderPassUnbindFramebuffer();
+      
+      if (m_secondary != nullptr) {
+        m_cmd->endRecording();
+        m_secondary->segments.back().cmdList = std::exchange(m_cmd, nullptr);
+      } else {
+        this->renderPassUnbindFramebuffer();
+      }
+    } else {
+      // Discarded attachments may be written outside of
+      // a render pass now, e.g. by a copy, so the next
+      // render pass must load their contents again.
+      m_state.om.renderPassOps = DxvkRenderPassOps();
     }
   }
   
   
-  void DxvkContext::renderPassBindFramebuffer(const Rc<DxvkFramebuffer>& framebuffer) {
+  void DxvkContext::renderPassBindFramebuffer(
+    const Rc<DxvkFramebuffer>&  framebuffer,
+    const DxvkRenderPassOps&    ops,
+    const VkClearValue*         colorClearValues,
+    const VkClearValue&         depthClearValue,
+          VkSubpassContents     contents) {
     const DxvkFramebufferSize fbSize = framebuffer->size();
     
     VkRect2D renderArea;
     renderArea.offset = VkOffset2D { 0, 0 };
     renderArea.extent = VkExtent2D { fbSize.width, fbSize.height };
     
+    // Clear values are indexed by attachment index, which
+    // uses the same order as the framebuffer attachments
+    const DxvkRenderTargets& renderTargets = framebuffer->renderTargets();
+    
+    std::array<VkClearValue, MaxNumRenderTargets + 1> clearValues;
+    uint32_t clearValueCount = 0;
+    
+    if (renderTargets.getDepthTarget().view != nullptr)
+      clearValues[clearValueCount++] = depthClearValue;
+    
+    for (uint32_t i = 0; i < MaxNumRenderTargets; i++) {
+      if (renderTargets.getColorTarget(i).view != nullptr)
+        clearValues[clearValueCount++] = colorClearValues[i];
+    }
+    
     VkRenderPassBeginInfo info;
     info.sType                = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     info.pNext                = nullptr;
-    info.renderPass           = framebuffer->renderPass();
+    info.renderPass           = framebuffer->renderPass(ops);
     info.framebuffer          = framebuffer->handle();
     info.renderArea           = renderArea;
-    info.clearValueCount      = 0;
-    info.pClearValues         = nullptr;
+    info.clearValueCount      = clearValueCount;
+    info.pClearValues         = clearValues.data();
     
-    m_cmd->cmdBeginRenderPass(&info,
-      VK_SUBPASS_CONTENTS_INLINE);
+    m_cmd->cmdBeginRenderPass(&info, contents);
     m_cmd->trackResource(framebuffer);
     m_cmd->addStatCtr(DxvkStatCounter::CmdRenderPassCount, 1);
   }
@@ -1531,6 +2128,39 @@ namespace dxvk {
   }
   
   
+  bool DxvkContext::clearCoversFramebuffer(
+    const Rc<DxvkFramebuffer>&  framebuffer,
+    const VkClearRect&          clearRect) const {
+    const DxvkFramebufferSize fbSize = framebuffer->size();
+    
+    return clearRect.rect.offset.x      == 0
+        && clearRect.rect.offset.y      == 0
+        && clearRect.rect.extent.width  == fbSize.width
+        && clearRect.rect.extent.height == fbSize.height
+        && clearRect.baseArrayLayer     == 0
+        && clearRect.layerCount         == fbSize.layers;
+  }
+  
+  
+  bool DxvkContext::discardCoversView(
+    const Rc<DxvkImageView>&        view,
+    const Rc<DxvkImage>&            image,
+    const VkImageSubresourceRange&  subresources) const {
+    if (view == nullptr || view->image() != image)
+      return false;
+    
+    const VkImageSubresourceRange viewSubresources = view->subresources();
+    
+    return (viewSubresources.aspectMask & subresources.aspectMask) == viewSubresources.aspectMask
+        && viewSubresources.baseMipLevel   >= subresources.baseMipLevel
+        && viewSubresources.baseMipLevel   +  viewSubresources.levelCount
+        <= subresources.baseMipLevel       +  subresources.levelCount
+        && viewSubresources.baseArrayLayer >= subresources.baseArrayLayer
+        && viewSubresources.baseArrayLayer +  viewSubresources.layerCount
+        <= subresources.baseArrayLayer     +  subresources.layerCount;
+  }
+  
+  
   void DxvkContext::unbindComputePipeline() {
     m_flags.set(
       DxvkContextFlag::CpDirtyPipeline,
@@ -1545,12 +2175,22 @@ namespace dxvk {
     if (m_flags.test(DxvkContextFlag::CpDirtyPipeline)) {
       m_flags.clr(DxvkContextFlag::CpDirtyPipeline);
       
-      m_state.cp.state.bsBindingState.clear();
+      Rc<DxvkComputePipeline> oldPipeline = m_state.cp.pipeline;
+      
       m_state.cp.pipeline = m_pipeMgr->createComputePipeline(
         m_pipeCache, m_state.cp.cs.shader);
       
       if (m_state.cp.pipeline != nullptr)
         m_cmd->trackResource(m_state.cp.pipeline);
+      
+      // Pipeline layouts are unique, so if the layout did not
+      // change, the currently bound descriptor set is still
+      // compatible with the new pipeline and can be kept.
+      if (oldPipeline == nullptr || m_state.cp.pipeline == nullptr
+       || oldPipeline->layout() != m_state.cp.pipeline->layout()) {
+        m_state.cp.state.bsBindingState.clear();
+        m_flags.set(DxvkContextFlag::CpDirtyResources);
+      }
     }
   }
   
@@ -1576,7 +2216,8 @@ namespace dxvk {
     if (m_flags.test(DxvkContextFlag::GpDirtyPipeline)) {
       m_flags.clr(DxvkContextFlag::GpDirtyPipeline);
       
-      m_state.gp.state.bsBindingState.clear();
+      Rc<DxvkGraphicsPipeline> oldPipeline = m_state.gp.pipeline;
+      
       m_state.gp.pipeline = m_pipeMgr->createGraphicsPipeline(
         m_pipeCache, m_state.gp.vs.shader,
         m_state.gp.tcs.shader, m_state.gp.tes.shader,
@@ -1584,6 +2225,12 @@ namespace dxvk {
       
       if (m_state.gp.pipeline != nullptr)
         m_cmd->trackResource(m_state.gp.pipeline);
+      
+      if (oldPipeline == nullptr || m_state.gp.pipeline == nullptr
+       || oldPipeline->layout() != m_state.gp.pipeline->layout()) {
+        m_state.gp.state.bsBindingState.clear();
+        m_flags.set(DxvkContextFlag::GpDirtyResources);
+      }
     }
   }
   
@@ -1628,6 +2275,13 @@ namespace dxvk {
   
   
   void DxvkContext::updateComputeShaderResources() {
+    // Offset-only updates are not possible if some uniform
+    // buffers could not be made dynamic for this pipeline
+    if (m_flags.test(DxvkContextFlag::CpDirtyDescriptorOffsets)
+     && m_state.cp.pipeline != nullptr
+     && m_state.cp.pipeline->layout()->hasStaticUniformBuffers())
+      m_flags.set(DxvkContextFlag::CpDirtyResources);
+    
     if (m_flags.test(DxvkContextFlag::CpDirtyResources)) {
       if (m_state.cp.pipeline != nullptr) {
         this->updateShaderResources(
@@ -1640,7 +2294,8 @@ namespace dxvk {
   
   void DxvkContext::updateComputeShaderDescriptors() {
     if (m_flags.test(DxvkContextFlag::CpDirtyResources)) {
-      m_flags.clr(DxvkContextFlag::CpDirtyResources);
+      m_flags.clr(DxvkContextFlag::CpDirtyResources,
+                  DxvkContextFlag::CpDirtyDescriptorOffsets);
       
       if (m_state.cp.pipeline != nullptr) {
         this->updateShaderDescriptors(
@@ -1648,11 +2303,26 @@ namespace dxvk {
           m_state.cp.state.bsBindingState,
           m_state.cp.pipeline->layout());
       }
+    } else if (m_flags.test(DxvkContextFlag::CpDirtyDescriptorOffsets)) {
+      m_flags.clr(DxvkContextFlag::CpDirtyDescriptorOffsets);
+      
+      if (m_state.cp.pipeline != nullptr) {
+        this->updateShaderDescriptorOffsets(
+          VK_PIPELINE_BIND_POINT_COMPUTE,
+          m_state.cp.pipeline->layout());
+      }
     }
   }
   
   
   void DxvkContext::updateGraphicsShaderResources() {
+    // Offset-only updates are not possible if some uniform
+    // buffers could not be made dynamic for this pipeline
+    if (m_flags.test(DxvkContextFlag::GpDirtyDescriptorOffsets)
+     && m_state.gp.pipeline != nullptr
+     && m_state.gp.pipeline->layout()->hasStaticUniformBuffers())
+      m_flags.set(DxvkContextFlag::GpDirtyResources);
+    
     if (m_flags.test(DxvkContextFlag::GpDirtyResources)) {
       if (m_state.gp.pipeline != nullptr) {
         this->updateShaderResources(
@@ -1665,7 +2335,8 @@ namespace dxvk {
   
   void DxvkContext::updateGraphicsShaderDescriptors() {
     if (m_flags.test(DxvkContextFlag::GpDirtyResources)) {
-      m_flags.clr(DxvkContextFlag::GpDirtyResources);
+      m_flags.clr(DxvkContextFlag::GpDirtyResources,
+                  DxvkContextFlag::GpDirtyDescriptorOffsets);
       
       if (m_state.gp.pipeline != nullptr) {
         this->updateShaderDescriptors(
@@ -1673,6 +2344,14 @@ namespace dxvk {
           m_state.gp.state.bsBindingState,
           m_state.gp.pipeline->layout());
       }
+    } else if (m_flags.test(DxvkContextFlag::GpDirtyDescriptorOffsets)) {
+      m_flags.clr(DxvkContextFlag::GpDirtyDescriptorOffsets);
+      
+      if (m_state.gp.pipeline != nullptr) {
+        this->updateShaderDescriptorOffsets(
+          VK_PIPELINE_BIND_POINT_GRAPHICS,
+          m_state.gp.pipeline->layout());
+      }
     }
   }
   
@@ -1680,6 +2359,8 @@ namespace dxvk {
   void DxvkContext::updateShaderResources(
           VkPipelineBindPoint     bindPoint,
     const Rc<DxvkPipelineLayout>& layout) {
+    DXVK_PROFILE_ZONE("Update shader resources");
+    
     DxvkBindingState& bindingState =
       bindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS
         ? m_state.gp.state.bsBindingState
@@ -1733,7 +2414,9 @@ namespace dxvk {
         
         case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
         case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
-          if (res.bufferView != nullptr) {
+          // Buffer views are recreated when the buffer is
+          // renamed, which secondary command lists cannot do
+          if (res.bufferView != nullptr && !this->secondaryUnsupported()) {
             updatePipelineState |= bindingState.setBound(i);
             
             res.bufferView->updateView();
@@ -1746,12 +2429,30 @@ namespace dxvk {
             m_descInfos[i].texelBuffer = m_device->dummyBufferViewDescriptor();
           } break;
         
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+          // The offset is passed in as a dynamic offset when
+          // binding the descriptor set, so that the descriptor
+          // remains valid as long as the buffer handle does.
+          if (res.bufferSlice.defined()) {
+            updatePipelineState |= bindingState.setBound(i);
+            
+            auto physicalSlice = this->getPhysicalSlice(res.bufferSlice);
+            m_descInfos[i].buffer.buffer = physicalSlice.handle();
+            m_descInfos[i].buffer.offset = 0;
+            m_descInfos[i].buffer.range  = physicalSlice.length();
+            
+            m_cmd->trackResource(physicalSlice.resource());
+          } else {
+            updatePipelineState |= bindingState.setUnbound(i);
+            m_descInfos[i].buffer = m_device->dummyBufferDescriptor();
+          } break;
+        
         case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
         case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
           if (res.bufferSlice.defined()) {
             updatePipelineState |= bindingState.setBound(i);
             
-            auto physicalSlice = res.bufferSlice.physicalSlice();
+            auto physicalSlice = this->getPhysicalSlice(res.bufferSlice);
             m_descInfos[i].buffer.buffer = physicalSlice.handle();
             m_descInfos[i].buffer.offset = physicalSlice.offset();
             m_descInfos[i].buffer.range  = physicalSlice.length();
@@ -1779,6 +2480,8 @@ namespace dxvk {
           VkPipelineBindPoint     bindPoint,
     const DxvkBindingState&       bindingState,
     const Rc<DxvkPipelineLayout>& layout) {
+    DXVK_PROFILE_ZONE("Update descriptor set");
+    
     if (layout->bindingCount() != 0) {
       const VkDescriptorSet dset =
         m_cmd->allocateDescriptorSet(
@@ -1788,9 +2491,49 @@ namespace dxvk {
         dset, layout->descriptorTemplate(),
         m_descInfos.data());
       
-      m_cmd->cmdBindDescriptorSet(bindPoint,
-        layout->pipelineLayout(), dset);
+      this->bindShaderDescriptorSet(
+        bindPoint, layout, dset);
+      
+      if (bindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS)
+        m_gpActiveDescriptorSet = dset;
+      else
+        m_cpActiveDescriptorSet = dset;
+    }
+  }
+  
+  
+  void DxvkContext::updateShaderDescriptorOffsets(
+          VkPipelineBindPoint     bindPoint,
+    const Rc<DxvkPipelineLayout>& layout) {
+    const VkDescriptorSet dset = bindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS
+      ? m_gpActiveDescriptorSet
+      : m_cpActiveDescriptorSet;
+    
+    // Re-binding the current set with new dynamic offsets
+    // is sufficient since no descriptor has been changed
+    if (layout->dynamicBindingCount() != 0 && dset != VK_NULL_HANDLE)
+      this->bindShaderDescriptorSet(bindPoint, layout, dset);
+  }
+  
+  
+  void DxvkContext::bindShaderDescriptorSet(
+          VkPipelineBindPoint     bindPoint,
+    const Rc<DxvkPipelineLayout>& layout,
+          VkDescriptorSet         descriptorSet) {
+    std::array<uint32_t, MaxNumActiveBindings> offsets;
+    
+    for (uint32_t i = 0; i < layout->dynamicBindingCount(); i++) {
+      const auto& binding = layout->binding(layout->dynamicBinding(i));
+      const auto& res     = m_rc[binding.slot];
+      
+      offsets[i] = res.bufferSlice.defined()
+        ? this->getPhysicalSlice(res.bufferSlice).offset()
+        : 0;
     }
+    
+    m_cmd->cmdBindDescriptorSet(bindPoint,
+      layout->pipelineLayout(), descriptorSet,
+      layout->dynamicBindingCount(), offsets.data());
   }
   
   
@@ -1799,7 +2542,7 @@ namespace dxvk {
       m_flags.clr(DxvkContextFlag::GpDirtyIndexBuffer);
       
       if (m_state.vi.indexBuffer.defined()) {
-        auto physicalSlice = m_state.vi.indexBuffer.physicalSlice();
+        auto physicalSlice = this->getPhysicalSlice(m_state.vi.indexBuffer);
         
         m_cmd->cmdBindIndexBuffer(
           physicalSlice.handle(),
@@ -1826,7 +2569,7 @@ namespace dxvk {
         const uint32_t binding = m_state.gp.state.ilBindings[i].binding;
         
         if (m_state.vi.vertexBuffers[binding].defined()) {
-          auto vbo = m_state.vi.vertexBuffers[binding].physicalSlice();
+          auto vbo = this->getPhysicalSlice(m_state.vi.vertexBuffers[binding]);
           
           const VkBuffer     handle = vbo.handle();
           const VkDeviceSize offset = vbo.offset();
@@ -1878,6 +2621,12 @@ namespace dxvk {
   
   void DxvkContext::commitGraphicsState() {
     this->renderPassBegin();
+    
+    // Secondary command lists only exist inside render passes,
+    // so draws outside of them have nothing to be recorded to
+    if (m_secondary != nullptr && !m_flags.test(DxvkContextFlag::GpRenderPassBound))
+      return;
+    
     this->updateGraphicsPipeline();
     this->updateIndexBufferBinding();
     this->updateVertexBufferBindings();
@@ -2013,4 +2762,40 @@ namespace dxvk {
     }
   }
   
+  
+  bool DxvkContext::secondaryUnsupported() {
+    if (m_secondary == nullptr)
+      return false;
+    
+    m_secondaryFailed = true;
+    return true;
+  }
+  
+  
+  DxvkPhysicalBufferSlice DxvkContext::getPhysicalSlice(
+    const DxvkBufferSlice&  slice) {
+    if (m_secondary == nullptr)
+      return slice.physicalSlice();
+    
+    return this->getSecondaryBufferSlice(slice.buffer())
+      .subSlice(slice.offset(), slice.length());
+  }
+  
+  
+  DxvkPhysicalBufferSlice DxvkContext::getSecondaryBufferSlice(
+    const Rc<DxvkBuffer>&   buffer) {
+    auto entry = m_secondarySlices.find(buffer.ptr());
+    
+    if (entry != m_secondarySlices.end())
+      return entry->second;
+    
+    // The buffer may be renamed by the thread executing
+    // the primary command list, so we need to remember
+    // which slice was used and validate it later.
+    DxvkPhysicalBufferSlice slice = buffer->lockedSlice();
+    m_secondary->bufferSlices.push_back({ buffer, slice });
+    m_secondarySlices.insert({ buffer.ptr(), slice });
+    return slice;
+  }
+  
 }
\ No newline at end of file
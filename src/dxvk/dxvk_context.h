@@ -1,5 +1,7 @@
 #pragma once
 
+#include <unordered_map>
+
 #include "dxvk_barrier.h"
 #include "dxvk_binding.h"
 #include "dxvk_cmdlist.h"
@@ -7,11 +9,13 @@
 #include "dxvk_data.h"
 #include "dxvk_event.h"
 #include "dxvk_meta_clear.h"
+#include "dxvk_meta_mipgen.h"
 #include "dxvk_meta_resolve.h"
 #include "dxvk_pipecache.h"
 #include "dxvk_pipemanager.h"
 #include "dxvk_query.h"
 #include "dxvk_query_pool.h"
+#include "dxvk_secondary.h"
 #include "dxvk_util.h"
 
 namespace dxvk {
@@ -30,7 +34,9 @@ namespace dxvk {
     DxvkContext(
       const Rc<DxvkDevice>&           device,
       const Rc<DxvkPipelineCache>&    pipelineCache,
-      const Rc<DxvkMetaClearObjects>& metaClearObjects);
+      const Rc<DxvkPipelineManager>&  pipelineManager,
+      const Rc<DxvkMetaClearObjects>& metaClearObjects,
+      const Rc<DxvkMetaMipGenObjects>& metaMipGenObjects);
     ~DxvkContext();
     
     /**
@@ -57,6 +63,50 @@ namespace dxvk {
      */
     Rc<DxvkCommandList> endRecording();
     
+    /**
+     * \brief Begins secondary command recording
+     * 
+     * Records subsequent commands into secondary command
+     * lists, one per render pass instance. Commands that
+     * cannot be recorded this way, such as copies, queries
+     * or dispatches, will cause the recording to fail.
+     * The context does not need a primary command list.
+     */
+    void beginSecondaryRecording();
+    
+    /**
+     * \brief Ends secondary command recording
+     * 
+     * \returns The recorded commands, or \c nullptr
+     *          if any unsupported command was used
+     */
+    Rc<DxvkSecondaryCommands> endSecondaryRecording();
+    
+    /**
+     * \brief Checks whether secondary recording failed
+     * 
+     * Any further commands recorded into the current
+     * secondary recording will be discarded anyway.
+     * \returns \c true if an unsupported command was used
+     */
+    bool secondaryFailed() const {
+      return m_secondaryFailed;
+    }
+    
+    /**
+     * \brief Executes secondary commands
+     * 
+     * Begins the render passes of the given commands and
+     * executes the secondary command lists within them,
+     * then applies recorded buffer invalidations. Fails
+     * if the commands reference buffer slices that are
+     * no longer current, or if any queries are active.
+     * \param [in] commands Recorded secondary commands
+     * \returns \c true if the commands were executed
+     */
+    bool executeSecondaryCommands(
+      const Rc<DxvkSecondaryCommands>& commands);
+    
     /**
      * \brief Begins generating query data
      * \param [in] query The query to end
@@ -101,6 +151,20 @@ namespace dxvk {
             uint32_t              slot,
       const DxvkBufferSlice&      buffer);
     
+    /**
+     * \brief Binds a range of buffers
+     * 
+     * Equivalent to calling \ref bindResourceBuffer
+     * for \c count consecutive slots.
+     * \param [in] firstSlot First resource binding slot
+     * \param [in] count Number of slots to bind
+     * \param [in] buffers Buffers to bind
+     */
+    void bindResourceBuffers(
+            uint32_t              firstSlot,
+            uint32_t              count,
+      const DxvkBufferSlice*      buffers);
+    
     /**
      * \brief Binds image or buffer view
      * 
@@ -116,6 +180,22 @@ namespace dxvk {
       const Rc<DxvkImageView>&    imageView,
       const Rc<DxvkBufferView>&   bufferView);
     
+    /**
+     * \brief Binds a range of image or buffer views
+     * 
+     * Equivalent to calling \ref bindResourceView
+     * for \c count consecutive slots.
+     * \param [in] firstSlot First resource binding slot
+     * \param [in] count Number of slots to bind
+     * \param [in] imageViews Image views to bind
+     * \param [in] bufferViews Buffer views to bind
+     */
+    void bindResourceViews(
+            uint32_t              firstSlot,
+            uint32_t              count,
+      const Rc<DxvkImageView>*    imageViews,
+      const Rc<DxvkBufferView>*   bufferViews);
+    
     /**
      * \brief Binds image sampler
      * 
@@ -128,6 +208,20 @@ namespace dxvk {
             uint32_t              slot,
       const Rc<DxvkSampler>&      sampler);
     
+    /**
+     * \brief Binds a range of samplers
+     * 
+     * Equivalent to calling \ref bindResourceSampler
+     * for \c count consecutive slots.
+     * \param [in] firstSlot First resource binding slot
+     * \param [in] count Number of slots to bind
+     * \param [in] samplers Samplers to bind
+     */
+    void bindResourceSamplers(
+            uint32_t              firstSlot,
+            uint32_t              count,
+      const Rc<DxvkSampler>*      samplers);
+    
     /**
      * \brief Binds a shader to a given state
      * 
@@ -150,6 +244,20 @@ namespace dxvk {
       const DxvkBufferSlice&      buffer,
             uint32_t              stride);
     
+    /**
+     * \brief Binds a range of vertex buffers
+     * 
+     * \param [in] firstBinding First vertex buffer binding
+     * \param [in] count Number of bindings to update
+     * \param [in] buffers New vertex buffers
+     * \param [in] strides Strides between vertices
+     */
+    void bindVertexBuffers(
+            uint32_t              firstBinding,
+            uint32_t              count,
+      const DxvkBufferSlice*      buffers,
+      const uint32_t*             strides);
+    
     /**
      * \brief Clears a buffer with a fixed value
      * 
@@ -314,6 +422,23 @@ namespace dxvk {
             VkOffset3D            srcOffset,
             VkExtent3D            srcExtent);
     
+    /**
+     * \brief Discards image contents
+     * 
+     * Tells the context that the current contents of the
+     * given subresources are no longer needed. If the image
+     * is an attachment of the next render pass, it will not
+     * be loaded, unless a command that may write to it gets
+     * recorded first. Otherwise, the image is transitioned
+     * from an undefined layout. This is only a hint and may
+     * be ignored, e.g. while a render pass is active.
+     * \param [in] image The image to discard
+     * \param [in] subresources Image subresources
+     */
+    void discardImage(
+      const Rc<DxvkImage>&            image,
+      const VkImageSubresourceRange&  subresources);
+    
     /**
      * \brief Starts compute jobs
      * 
@@ -604,6 +729,7 @@ namespace dxvk {
     const Rc<DxvkPipelineCache>     m_pipeCache;
     const Rc<DxvkPipelineManager>   m_pipeMgr;
     const Rc<DxvkMetaClearObjects>  m_metaClear;
+    const Rc<DxvkMetaMipGenObjects> m_metaMipGen;
     
     Rc<DxvkCommandList> m_cmd;
     DxvkContextFlags    m_flags;
@@ -616,18 +742,44 @@ namespace dxvk {
     VkPipeline m_gpActivePipeline = VK_NULL_HANDLE;
     VkPipeline m_cpActivePipeline = VK_NULL_HANDLE;
     
+    VkDescriptorSet m_gpActiveDescriptorSet = VK_NULL_HANDLE;
+    VkDescriptorSet m_cpActiveDescriptorSet = VK_NULL_HANDLE;
+    
     std::vector<DxvkQueryRevision> m_activeQueries;
     
     std::array<DxvkShaderResourceSlot, MaxNumResourceSlots>  m_rc;
     std::array<DxvkDescriptorInfo,     MaxNumActiveBindings> m_descInfos;
     
+    Rc<DxvkSecondaryCommands> m_secondary;
+    bool                      m_secondaryFailed = false;
+    
+    std::unordered_map<DxvkBuffer*,
+      DxvkPhysicalBufferSlice> m_secondarySlices;
+    
+    void generateMipmapsCompute(
+      const Rc<DxvkImage>&            image,
+      const VkImageSubresourceRange&  subresources);
+    
     void renderPassBegin();
     void renderPassEnd();
     
     void renderPassBindFramebuffer(
-      const Rc<DxvkFramebuffer>& framebuffer);
+      const Rc<DxvkFramebuffer>&  framebuffer,
+      const DxvkRenderPassOps&    ops,
+      const VkClearValue*         colorClearValues,
+      const VkClearValue&         depthClearValue,
+            VkSubpassContents     contents);
     void renderPassUnbindFramebuffer();
     
+    bool clearCoversFramebuffer(
+      const Rc<DxvkFramebuffer>&  framebuffer,
+      const VkClearRect&          clearRect) const;
+    
+    bool discardCoversView(
+      const Rc<DxvkImageView>&        view,
+      const Rc<DxvkImage>&            image,
+      const VkImageSubresourceRange&  subresources) const;
+    
     void unbindComputePipeline();
     
     void updateComputePipeline();
@@ -651,6 +803,15 @@ namespace dxvk {
       const DxvkBindingState&       bindingState,
       const Rc<DxvkPipelineLayout>& layout);
     
+    void updateShaderDescriptorOffsets(
+            VkPipelineBindPoint     bindPoint,
+      const Rc<DxvkPipelineLayout>& layout);
+    
+    void bindShaderDescriptorSet(
+            VkPipelineBindPoint     bindPoint,
+      const Rc<DxvkPipelineLayout>& layout,
+            VkDescriptorSet         descriptorSet);
+    
     void updateViewports();
     void updateBlendConstants();
     void updateStencilReference();
@@ -687,6 +848,14 @@ namespace dxvk {
     
     Rc<DxvkBuffer> getTransferBuffer(VkDeviceSize size);
     
+    bool secondaryUnsupported();
+    
+    DxvkPhysicalBufferSlice getPhysicalSlice(
+      const DxvkBufferSlice&  slice);
+    
+    DxvkPhysicalBufferSlice getSecondaryBufferSlice(
+      const Rc<DxvkBuffer>&   buffer);
+    
   };
   
 }
\ No newline at end of file
@@ -22,9 +22,11 @@ namespace dxvk {
    */
   enum class DxvkContextFlag : uint64_t  {
     GpRenderPassBound,          ///< Render pass is currently bound
+    GpClearRenderTargets,       ///< Render pass has pending attachment clears
     GpDirtyPipeline,            ///< Graphics pipeline binding is out of date
     GpDirtyPipelineState,       ///< Graphics pipeline needs to be recompiled
     GpDirtyResources,           ///< Graphics pipeline resource bindings are out of date
+    GpDirtyDescriptorOffsets,   ///< Graphics pipeline dynamic buffer offsets are out of date
     GpDirtyVertexBuffers,       ///< Vertex buffer bindings are out of date
     GpDirtyIndexBuffer,         ///< Index buffer binding are out of date
     GpEmulateInstanceFetchRate, ///< The current input layout uses fetch rates != 1
@@ -32,6 +34,7 @@ namespace dxvk {
     CpDirtyPipeline,            ///< Compute pipeline binding are out of date
     CpDirtyPipelineState,       ///< Compute pipeline needs to be recompiled
     CpDirtyResources,           ///< Compute pipeline resource bindings are out of date
+    CpDirtyDescriptorOffsets,   ///< Compute pipeline dynamic buffer offsets are out of date
   };
   
   using DxvkContextFlags = Flags<DxvkContextFlag>;
@@ -60,6 +63,11 @@ namespace dxvk {
   struct DxvkOutputMergerState {
     Rc<DxvkFramebuffer> framebuffer       = nullptr;
     
+    DxvkRenderPassOps   renderPassOps;
+    
+    std::array<VkClearValue, MaxNumRenderTargets> colorClearValues = { };
+    VkClearValue                                  depthClearValue  = { };
+    
     DxvkBlendConstants  blendConstants    = { 0.0f, 0.0f, 0.0f, 0.0f };
     uint32_t            stencilReference  = 0;
   };
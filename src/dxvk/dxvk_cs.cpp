@@ -1,4 +1,7 @@
+#include <chrono>
+
 #include "dxvk_cs.h"
+#include "dxvk_device.h"
 
 namespace dxvk {
   
@@ -18,12 +21,28 @@ namespace dxvk {
   }
   
   
-  void DxvkCsChunk::executeAll(DxvkContext* ctx) {
+  void DxvkCsChunk::executeAll(
+          DxvkContext*        ctx,
+          DxvkCsCmdStatsMap*  stats) {
+    using Clock = std::chrono::high_resolution_clock;
+    
     auto cmd = m_head;
     
     while (cmd != nullptr) {
       auto next = cmd->next();
-      cmd->exec(ctx);
+      
+      if (stats != nullptr) {
+        auto t0 = Clock::now();
+        cmd->exec(ctx);
+        auto t1 = Clock::now();
+        
+        DxvkCsCmdStats& entry = (*stats)[cmd->tag()];
+        entry.count += 1;
+        entry.time  += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+      } else {
+        cmd->exec(ctx);
+      }
+      
       cmd->~DxvkCsCmd();
       cmd = next;
     }
@@ -36,8 +55,18 @@ namespace dxvk {
   }
   
   
-  DxvkCsThread::DxvkCsThread(const Rc<DxvkContext>& context)
-  : m_context(context), m_thread([this] { threadFunc(); }) {
+  void DxvkCsChunk::replay(
+          DxvkContext*        ctx) const {
+    for (auto cmd = m_head; cmd != nullptr && !ctx->secondaryFailed(); cmd = cmd->next())
+      cmd->exec(ctx);
+  }
+  
+  
+  DxvkCsThread::DxvkCsThread(
+    const Rc<DxvkDevice>&   device,
+    const Rc<DxvkContext>&  context)
+  : m_device(device), m_context(context),
+    m_thread([this] { threadFunc(); }) {
     
   }
   
@@ -63,15 +92,32 @@ namespace dxvk {
   
   
   void DxvkCsThread::synchronize() {
-    std::unique_lock<std::mutex> lock(m_mutex);
+    DxvkCsStats* stats = m_device->csStats();
+    
+    auto t0 = stats->enabled()
+      ? std::chrono::high_resolution_clock::now()
+      : std::chrono::high_resolution_clock::time_point();
     
-    m_condOnSync.wait(lock, [this] {
-      return m_chunksPending == 0;
-    });
+    { std::unique_lock<std::mutex> lock(m_mutex);
+      
+      m_condOnSync.wait(lock, [this] {
+        return m_chunksPending == 0;
+      });
+    }
+    
+    if (stats->enabled()) {
+      auto t1 = std::chrono::high_resolution_clock::now();
+      stats->addStallTime(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    }
   }
   
   
   void DxvkCsThread::threadFunc() {
+    Profiler::setThreadName("dxvk-cs");
+    
+    DxvkCsStats*      stats = m_device->csStats();
+    DxvkCsCmdStatsMap cmdStats;
+    
     Rc<DxvkCsChunk> chunk;
     
     while (!m_stopped.load()) {
@@ -96,8 +142,26 @@ namespace dxvk {
         }
       }
       
-      if (chunk != nullptr)
-        chunk->executeAll(m_context.ptr());
+      if (chunk != nullptr) {
+        DXVK_PROFILE_ZONE("Execute CS chunk");
+        
+        if (stats->enabled()) {
+          const size_t commandCount = chunk->commandCount();
+          const size_t memoryUsed   = chunk->memoryUsed();
+          
+          auto t0 = std::chrono::high_resolution_clock::now();
+          chunk->executeAll(m_context.ptr(), &cmdStats);
+          auto t1 = std::chrono::high_resolution_clock::now();
+          
+          stats->addChunk(commandCount, memoryUsed,
+            DxvkCsChunk::MaxBlockSize,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count(),
+            cmdStats);
+          cmdStats.clear();
+        } else {
+          chunk->executeAll(m_context.ptr());
+        }
+      }
     }
   }
   
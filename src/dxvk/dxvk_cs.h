@@ -7,6 +7,7 @@
 #include <thread>
 
 #include "dxvk_context.h"
+#include "dxvk_cs_stats.h"
 
 namespace dxvk {
   
@@ -41,6 +42,25 @@ namespace dxvk {
       m_next = next;
     }
     
+    /**
+     * \brief Call site tag
+     * 
+     * Identifies the function that recorded
+     * the command. May be \c nullptr.
+     * \returns Tag of the command
+     */
+    const char* tag() const {
+      return m_tag;
+    }
+    
+    /**
+     * \brief Sets call site tag
+     * \param [in] tag Call site tag
+     */
+    void setTag(const char* tag) {
+      m_tag = tag;
+    }
+    
     /**
      * \brief Executes embedded commands
      * \param [in] ctx The target context
@@ -49,7 +69,8 @@ namespace dxvk {
     
   private:
     
-    DxvkCsCmd* m_next = nullptr;
+    DxvkCsCmd*  m_next = nullptr;
+    const char* m_tag  = nullptr;
     
   };
   
@@ -88,9 +109,10 @@ namespace dxvk {
    * Stores a list of commands.
    */
   class DxvkCsChunk : public RcObject {
-    constexpr static size_t MaxBlockSize = 16384;
   public:
     
+    constexpr static size_t MaxBlockSize = 16384;
+    
     DxvkCsChunk();
     ~DxvkCsChunk();
     
@@ -104,6 +126,14 @@ namespace dxvk {
       return m_commandCount;
     }
     
+    /**
+     * \brief Number of bytes used by commands
+     * \returns Used chunk memory, in bytes
+     */
+    size_t memoryUsed() const {
+      return m_commandOffset;
+    }
+    
     /**
      * \brief Tries to add a command to the chunk
      * 
@@ -111,11 +141,12 @@ namespace dxvk {
      * will be consumed. Otherwise, a new chunk must be
      * created which is large enough to hold the command.
      * \param [in] command The command to add
+     * \param [in] tag Call site tag
      * \returns \c true on success, \c false if
      *          a new chunk needs to be allocated
      */
     template<typename T>
-    bool push(T& command) {
+    bool push(T& command, const char* tag = nullptr) {
       using FuncType = DxvkCsTypedCmd<T>;
       
       if (m_commandOffset + sizeof(FuncType) > MaxBlockSize)
@@ -125,6 +156,7 @@ namespace dxvk {
       
       m_tail = new (m_data + m_commandOffset)
         FuncType(std::move(command));
+      m_tail->setTag(tag);
       
       if (tail != nullptr)
         tail->setNext(m_tail);
@@ -142,8 +174,25 @@ namespace dxvk {
      * This will also reset the chunk
      * so that it can be reused.
      * \param [in] ctx The context
+     * \param [out] stats Per-command statistics,
+     *        or \c nullptr to disable timing
+     */
+    void executeAll(
+            DxvkContext*        ctx,
+            DxvkCsCmdStatsMap*  stats = nullptr);
+    
+    /**
+     * \brief Executes all commands without resetting
+     * 
+     * Leaves the commands intact so that the chunk can
+     * be executed again, possibly on another context.
+     * Must not be called while the chunk is modified.
+     * Stops early if the context fails to record
+     * secondary commands.
+     * \param [in] ctx The context
      */
-    void executeAll(DxvkContext* ctx);
+    void replay(
+            DxvkContext*        ctx) const;
     
   private:
     
@@ -169,7 +218,9 @@ namespace dxvk {
     
   public:
     
-    DxvkCsThread(const Rc<DxvkContext>& context);
+    DxvkCsThread(
+      const Rc<DxvkDevice>&   device,
+      const Rc<DxvkContext>&  context);
     ~DxvkCsThread();
     
     /**
@@ -193,6 +244,7 @@ namespace dxvk {
     
   private:
     
+    const Rc<DxvkDevice>        m_device;
     const Rc<DxvkContext>       m_context;
     
     std::atomic<bool>           m_stopped = { false };
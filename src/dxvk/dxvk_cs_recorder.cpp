@@ -0,0 +1,168 @@
+#include "dxvk_cs_recorder.h"
+#include "dxvk_device.h"
+
+namespace dxvk {
+  
+  DxvkCsRecording::DxvkCsRecording(
+    const std::vector<Rc<DxvkCsChunk>>& chunks)
+  : m_chunks(chunks) { }
+  
+  
+  DxvkCsRecording::~DxvkCsRecording() {
+    
+  }
+  
+  
+  bool DxvkCsRecording::claim() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    if (m_state != State::Pending)
+      return false;
+    
+    m_state = State::Recording;
+    return true;
+  }
+  
+  
+  void DxvkCsRecording::record(
+    const Rc<DxvkContext>&  ctx) {
+    ctx->beginSecondaryRecording();
+    
+    // Once a command cannot be recorded, the
+    // chunks will be replayed anyway, so stop
+    for (const auto& chunk : m_chunks) {
+      if (ctx->secondaryFailed())
+        break;
+      
+      chunk->replay(ctx.ptr());
+    }
+    
+    this->finish(ctx->endSecondaryRecording());
+  }
+  
+  
+  void DxvkCsRecording::cancel() {
+    this->finish(nullptr);
+  }
+  
+  
+  void DxvkCsRecording::execute(
+          DxvkContext*      ctx) {
+    { std::unique_lock<std::mutex> lock(m_mutex);
+      
+      // If no worker has picked up the recording yet,
+      // replaying the chunks is faster than waiting
+      if (m_state == State::Pending)
+        m_state = State::Done;
+      
+      m_cond.wait(lock, [this] { return m_state == State::Done; });
+    }
+    
+    if (m_commands != nullptr && ctx->executeSecondaryCommands(m_commands))
+      return;
+    
+    // Replay the chunks without destroying the commands
+    // so that the command list can be executed again
+    for (const auto& chunk : m_chunks)
+      chunk->replay(ctx);
+  }
+  
+  
+  void DxvkCsRecording::finish(
+          Rc<DxvkSecondaryCommands>&& commands) {
+    { std::lock_guard<std::mutex> lock(m_mutex);
+      m_commands = std::move(commands);
+      m_state    = State::Done;
+    }
+    
+    m_cond.notify_all();
+  }
+  
+  
+  DxvkCsRecorder::DxvkCsRecorder(
+    const Rc<DxvkDevice>&   device,
+          uint32_t          workerCount)
+  : m_device  (device),
+    m_enabled (workerCount != 0) {
+    if (!m_enabled)
+      return;
+    
+    for (uint32_t i = 0; i < workerCount; i++)
+      m_threads.emplace_back([this] () { workerFunc(); });
+    
+    Logger::info(str::format("DxvkCsRecorder: Using ", workerCount, " worker threads"));
+  }
+  
+  
+  DxvkCsRecorder::~DxvkCsRecorder() {
+    if (!m_enabled)
+      return;
+    
+    { std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopThreads.store(true);
+    }
+    
+    m_cond.notify_all();
+    
+    for (auto& thread : m_threads)
+      thread.join();
+    
+    // Nobody should be waiting for pending recordings
+    // at this point, but make sure they can finish
+    while (!m_queue.empty()) {
+      m_queue.front()->cancel();
+      m_queue.pop();
+    }
+  }
+  
+  
+  Rc<DxvkCsRecording> DxvkCsRecorder::record(
+    const std::vector<Rc<DxvkCsChunk>>& chunks) {
+    if (!m_enabled)
+      return nullptr;
+    
+    Rc<DxvkCsRecording> recording = new DxvkCsRecording(chunks);
+    
+    { std::lock_guard<std::mutex> lock(m_mutex);
+      m_queue.push(recording);
+    }
+    
+    m_cond.notify_one();
+    return recording;
+  }
+  
+  
+  void DxvkCsRecorder::workerFunc() {
+    Profiler::setThreadName("dxvk-cs-recorder");
+    
+    while (!m_stopThreads.load()) {
+      Rc<DxvkCsRecording> recording;
+      
+      { std::unique_lock<std::mutex> lock(m_mutex);
+        
+        m_cond.wait(lock, [this] {
+          return m_stopThreads.load() || m_queue.size() != 0;
+        });
+        
+        if (m_stopThreads.load())
+          break;
+        
+        recording = std::move(m_queue.front());
+        m_queue.pop();
+      }
+      
+      if (!recording->claim())
+        continue;
+      
+      // Each recording starts with a clean context, the
+      // command list sets up all the state that it needs
+      try {
+        recording->record(m_device->createContext());
+      } catch (const DxvkError& e) {
+        Logger::err(e.message());
+        recording->cancel();
+      }
+    }
+  }
+  
+}
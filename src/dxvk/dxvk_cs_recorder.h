@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "dxvk_cs.h"
+#include "dxvk_secondary.h"
+
+namespace dxvk {
+  
+  /**
+   * \brief Command stream recording
+   * 
+   * Stores a list of command chunks along with the
+   * secondary command lists that a worker thread
+   * recorded from them. If recording failed, or if
+   * the recorded commands cannot be used anymore,
+   * the chunks are replayed on the executing context
+   * instead, so the result is always the same.
+   */
+  class DxvkCsRecording : public RcObject {
+    
+  public:
+    
+    DxvkCsRecording(
+      const std::vector<Rc<DxvkCsChunk>>& chunks);
+    ~DxvkCsRecording();
+    
+    /**
+     * \brief Claims the recording for a worker
+     * 
+     * Fails if \ref execute already took over the
+     * recording, in which case the worker must not
+     * record it anymore.
+     * \returns \c true if the worker may record
+     */
+    bool claim();
+    
+    /**
+     * \brief Records secondary commands
+     * 
+     * Called on a worker thread after a successful
+     * call to \ref claim. Replays the chunks on a
+     * context in secondary recording mode.
+     * \param [in] ctx Context to record with
+     */
+    void record(
+      const Rc<DxvkContext>&  ctx);
+    
+    /**
+     * \brief Cancels recording
+     * 
+     * Marks the recording as finished without any
+     * secondary commands, so that \ref execute
+     * will replay the chunks.
+     */
+    void cancel();
+    
+    /**
+     * \brief Executes the recorded commands
+     * 
+     * Replays the chunks directly if no worker has
+     * started recording yet, and otherwise waits for
+     * the recording to finish. Must be called from
+     * the thread that owns the context.
+     * \param [in] ctx The executing context
+     */
+    void execute(
+            DxvkContext*      ctx);
+    
+  private:
+    
+    enum class State : uint32_t {
+      Pending,
+      Recording,
+      Done,
+    };
+    
+    std::vector<Rc<DxvkCsChunk>> m_chunks;
+    
+    std::mutex                m_mutex;
+    std::condition_variable   m_cond;
+    State                     m_state = State::Pending;
+    
+    Rc<DxvkSecondaryCommands> m_commands;
+    
+    void finish(
+            Rc<DxvkSecondaryCommands>&& commands);
+    
+  };
+  
+  
+  /**
+   * \brief Command stream recorder
+   * 
+   * Records command lists of deferred contexts, or
+   * segments of the immediate context's command stream,
+   * into secondary command buffers on worker threads, so
+   * that the CS thread only needs to stitch together
+   * pre-recorded commands.
+   * 
+   * Recording is disabled if no worker threads are used,
+   * in which case the caller is expected to dispatch the
+   * chunks to the CS thread directly.
+   */
+  class DxvkCsRecorder {
+    
+  public:
+    
+    DxvkCsRecorder(
+      const Rc<DxvkDevice>&   device,
+            uint32_t          workerCount);
+    ~DxvkCsRecorder();
+    
+    /**
+     * \brief Checks whether recording is enabled
+     * \returns \c true if worker threads are used
+     */
+    bool enabled() const {
+      return m_enabled;
+    }
+    
+    /**
+     * \brief Starts recording a command list
+     * 
+     * The chunks must not be modified or executed
+     * destructively afterwards, since the worker
+     * threads will replay them concurrently.
+     * \param [in] chunks Command list chunks
+     * \returns The recording, or \c nullptr if
+     *          recording is disabled
+     */
+    Rc<DxvkCsRecording> record(
+      const std::vector<Rc<DxvkCsChunk>>& chunks);
+    
+  private:
+    
+    const Rc<DxvkDevice>            m_device;
+    
+    bool                            m_enabled;
+    
+    std::atomic<bool>               m_stopThreads = { false };
+    
+    std::mutex                      m_mutex;
+    std::condition_variable         m_cond;
+    std::queue<Rc<DxvkCsRecording>> m_queue;
+    std::vector<std::thread>        m_threads;
+    
+    void workerFunc();
+    
+  };
+  
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+
+#include "dxvk_cs_stats.h"
+
+#include "hud/dxvk_hud_config.h"
+
+namespace dxvk {
+  
+  DxvkCsStatsData DxvkCsStatsData::diff(const DxvkCsStatsData& other) const {
+    DxvkCsStatsData result;
+    result.chunkCount   = chunkCount   - other.chunkCount;
+    result.commandCount = commandCount - other.commandCount;
+    result.bytesUsed    = bytesUsed    - other.bytesUsed;
+    result.bytesTotal   = bytesTotal   - other.bytesTotal;
+    result.stallTime    = stallTime    - other.stallTime;
+    result.busyTime     = busyTime     - other.busyTime;
+    
+    for (const auto& cmd : commands) {
+      DxvkCsCmdStats entry = cmd.second;
+      
+      auto prev = other.commands.find(cmd.first);
+      
+      if (prev != other.commands.end()) {
+        entry.count -= prev->second.count;
+        entry.time  -= prev->second.time;
+      }
+      
+      if (entry.count != 0)
+        result.commands.insert({ cmd.first, entry });
+    }
+    
+    return result;
+  }
+  
+  
+  std::vector<std::pair<std::string, DxvkCsCmdStats>> DxvkCsStatsData::topCommands(
+          size_t                maxCount) const {
+    std::vector<std::pair<std::string, DxvkCsCmdStats>> result(
+      commands.begin(), commands.end());
+    
+    std::sort(result.begin(), result.end(), [] (const auto& a, const auto& b) {
+      return a.second.time > b.second.time;
+    });
+    
+    if (result.size() > maxCount)
+      result.resize(maxCount);
+    
+    return result;
+  }
+  
+  
+  DxvkCsStats::DxvkCsStats()
+  : m_enabled(isEnabled()) {
+    
+  }
+  
+  
+  DxvkCsStats::~DxvkCsStats() {
+    
+  }
+  
+  
+  void DxvkCsStats::addChunk(
+          size_t                commandCount,
+          size_t                bytesUsed,
+          size_t                bytesTotal,
+          uint64_t              busyTime,
+    const DxvkCsCmdStatsMap&    commands) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    m_data.chunkCount   += 1;
+    m_data.commandCount += commandCount;
+    m_data.bytesUsed    += bytesUsed;
+    m_data.bytesTotal   += bytesTotal;
+    m_data.busyTime     += busyTime;
+    
+    for (const auto& cmd : commands) {
+      DxvkCsCmdStats& entry = m_commands[cmd.first];
+      entry.count += cmd.second.count;
+      entry.time  += cmd.second.time;
+    }
+  }
+  
+  
+  void DxvkCsStats::addStallTime(
+          uint64_t              time) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_data.stallTime += time;
+  }
+  
+  
+  DxvkCsStatsData DxvkCsStats::getData() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    // Tags are only resolved to strings here since
+    // identical names may use different pointers
+    DxvkCsStatsData result = m_data;
+    
+    for (const auto& cmd : m_commands) {
+      DxvkCsCmdStats& entry = result.commands[
+        cmd.first != nullptr ? cmd.first : "Unknown"];
+      entry.count += cmd.second.count;
+      entry.time  += cmd.second.time;
+    }
+    
+    return result;
+  }
+  
+  
+  void DxvkCsStats::logStats() {
+    const DxvkCsStatsData data = this->getData();
+    
+    if (data.chunkCount == 0)
+      return;
+    
+    Logger::info(str::format("CS thread statistics:",
+      "\n  Chunks:             ", data.chunkCount,
+      "\n  Commands per chunk: ", data.commandCount / data.chunkCount,
+      "\n  Chunk fill ratio:   ", (100 * data.bytesUsed) / std::max<uint64_t>(data.bytesTotal, 1), "%",
+      "\n  Producer stalls:    ", data.stallTime / 1000000, " ms",
+      "\n  Busy time:          ", data.busyTime  / 1000000, " ms"));
+    
+    for (const auto& cmd : data.topCommands(data.commands.size())) {
+      Logger::info(str::format("  ", cmd.first,
+        ": ", cmd.second.count, " calls, ",
+        cmd.second.time / 1000, " us"));
+    }
+  }
+  
+  
+  bool DxvkCsStats::isEnabled() {
+    if (env::getEnvVar(L"DXVK_CS_STATS") == "1")
+      return true;
+    
+    hud::HudConfig config(env::getEnvVar(L"DXVK_HUD"));
+    return config.elements.test(hud::HudElement::StatCsThread)
+        || config.elements.test(hud::HudElement::Graphs);
+  }
+  
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include "dxvk_include.h"
+
+namespace dxvk {
+  
+  /**
+   * \brief Statistics for one command type
+   * 
+   * Number of times commands from a given
+   * call site were executed, as well as the
+   * total execution time in nanoseconds.
+   */
+  struct DxvkCsCmdStats {
+    uint64_t count = 0;
+    uint64_t time  = 0;
+  };
+  
+  /**
+   * \brief Per-tag command statistics
+   * 
+   * Keyed by the tag pointer so that the CS thread
+   * does not need to hash strings. Tags are string
+   * literals and thus valid for the lifetime of
+   * the module.
+   */
+  using DxvkCsCmdStatsMap = std::unordered_map<const char*, DxvkCsCmdStats>;
+  
+  
+  /**
+   * \brief CS thread statistics
+   * 
+   * Snapshot of the accumulated statistics. All
+   * times are in nanoseconds, and commands with
+   * the same name are merged.
+   */
+  struct DxvkCsStatsData {
+    uint64_t chunkCount   = 0;
+    uint64_t commandCount = 0;
+    uint64_t bytesUsed    = 0;
+    uint64_t bytesTotal   = 0;
+    uint64_t stallTime    = 0;
+    uint64_t busyTime     = 0;
+    
+    std::map<std::string, DxvkCsCmdStats> commands;
+    
+    /**
+     * \brief Computes difference
+     * 
+     * \param [in] other Statistics to subtract
+     * \returns Difference between the two snapshots
+     */
+    DxvkCsStatsData diff(const DxvkCsStatsData& other) const;
+    
+    /**
+     * \brief Command types sorted by execution time
+     * 
+     * \param [in] maxCount Maximum number of entries
+     * \returns Command names and statistics
+     */
+    std::vector<std::pair<std::string, DxvkCsCmdStats>> topCommands(
+            size_t                maxCount) const;
+  };
+  
+  
+  /**
+   * \brief CS thread statistics
+   * 
+   * Collects per-command timings, chunk usage and
+   * the time the application thread spends waiting
+   * for the CS thread. Collection is disabled unless
+   * \c DXVK_CS_STATS is set to \c 1 or the HUD is
+   * configured to display the statistics or graphs,
+   * since timing individual commands is not free.
+   */
+  class DxvkCsStats {
+    
+  public:
+    
+    DxvkCsStats();
+    ~DxvkCsStats();
+    
+    /**
+     * \brief Checks whether statistics are collected
+     * \returns \c true if statistics are enabled
+     */
+    bool enabled() const {
+      return m_enabled;
+    }
+    
+    /**
+     * \brief Records an executed chunk
+     * 
+     * \param [in] commandCount Number of commands in the chunk
+     * \param [in] bytesUsed Number of bytes used by commands
+     * \param [in] bytesTotal Chunk capacity, in bytes
+     * \param [in] busyTime Time spent executing the chunk
+     * \param [in] commands Per-command statistics
+     */
+    void addChunk(
+            size_t                commandCount,
+            size_t                bytesUsed,
+            size_t                bytesTotal,
+            uint64_t              busyTime,
+      const DxvkCsCmdStatsMap&    commands);
+    
+    /**
+     * \brief Records time spent waiting for the CS thread
+     * \param [in] time Stall time, in nanoseconds
+     */
+    void addStallTime(
+            uint64_t              time);
+    
+    /**
+     * \brief Retrieves current statistics
+     * \returns Statistics snapshot
+     */
+    DxvkCsStatsData getData();
+    
+    /**
+     * \brief Writes statistics to the log
+     */
+    void logStats();
+    
+  private:
+    
+    const bool        m_enabled;
+    
+    std::mutex        m_mutex;
+    DxvkCsCmdStatsMap m_commands;
+    DxvkCsStatsData   m_data;
+    
+    static bool isEnabled();
+    
+  };
+  
+}
@@ -15,7 +15,15 @@ namespace dxvk {
     m_memory          (new DxvkMemoryAllocator  (adapter, vkd)),
     m_renderPassPool  (new DxvkRenderPassPool   (vkd)),
     m_pipelineCache   (new DxvkPipelineCache    (vkd)),
+    m_pipelineLayoutPool(new DxvkPipelineLayoutPool(vkd)),
+    m_pipelineManager (new DxvkPipelineManager  (this)),
+    m_stateCache      (new DxvkStateCache       (
+      m_pipelineManager.ptr(), m_renderPassPool.ptr(), m_pipelineCache)),
     m_metaClearObjects(new DxvkMetaClearObjects (vkd)),
+    m_metaMipGenObjects(new DxvkMetaMipGenObjects(vkd)),
+    m_shaderModuleCounters(new DxvkShaderModuleCounters()),
+    m_uniformRing     (new DxvkUniformRing      (this,
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)),
     m_unboundResources(this),
     m_submissionQueue (this) {
     m_vkd->vkGetDeviceQueue(m_vkd->device(),
@@ -30,7 +38,12 @@ namespace dxvk {
   DxvkDevice::~DxvkDevice() {
     // Wait for all pending Vulkan commands to be
     // executed before we destroy any resources.
-    m_vkd->vkDeviceWaitIdle(m_vkd->device());
+    this->waitForIdle();
+    
+    m_bufferRenameLog.dump(LogLevel::Debug);
+    
+    if (m_csStats.enabled())
+      m_csStats.logStats();
   }
   
   
@@ -91,7 +104,21 @@ namespace dxvk {
     
     if (cmdList == nullptr) {
       cmdList = new DxvkCommandList(m_vkd,
-        this, m_adapter->graphicsQueueFamily());
+        this, m_adapter->graphicsQueueFamily(),
+        VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+    }
+    
+    return cmdList;
+  }
+  
+  
+  Rc<DxvkCommandList> DxvkDevice::createSecondaryCommandList() {
+    Rc<DxvkCommandList> cmdList = m_recycledSecondaryCmdLists.retrieveObject();
+    
+    if (cmdList == nullptr) {
+      cmdList = new DxvkCommandList(m_vkd,
+        this, m_adapter->graphicsQueueFamily(),
+        VK_COMMAND_BUFFER_LEVEL_SECONDARY);
     }
     
     return cmdList;
@@ -101,7 +128,15 @@ namespace dxvk {
   Rc<DxvkContext> DxvkDevice::createContext() {
     return new DxvkContext(this,
       m_pipelineCache,
-      m_metaClearObjects);
+      m_pipelineManager,
+      m_metaClearObjects,
+      m_metaMipGenObjects);
+  }
+  
+  
+  void DxvkDevice::registerShader(
+    const Rc<DxvkShader>&           shader) {
+    m_stateCache->registerShader(shader);
   }
   
   
@@ -113,6 +148,13 @@ namespace dxvk {
   }
   
   
+  Rc<DxvkPipelineLayout> DxvkDevice::createPipelineLayout(
+    const DxvkDescriptorSlotMapping&  slotMapping,
+          VkPipelineBindPoint         pipelineBindPoint) const {
+    return m_pipelineLayoutPool->getLayout(slotMapping, pipelineBindPoint);
+  }
+  
+  
   Rc<DxvkBuffer> DxvkDevice::createBuffer(
     const DxvkBufferCreateInfo& createInfo,
           VkMemoryPropertyFlags memoryType) {
@@ -179,10 +221,14 @@ namespace dxvk {
   
   DxvkStatCounters DxvkDevice::getStatCounters() {
     DxvkMemoryStats mem = m_memory->getMemoryStats();
+    DxvkShaderModuleStats modules = m_shaderModuleCounters->getStats();
     
     DxvkStatCounters result;
-    result.setCtr(DxvkStatCounter::MemoryAllocated, mem.memoryAllocated);
-    result.setCtr(DxvkStatCounter::MemoryUsed,      mem.memoryUsed);
+    result.setCtr(DxvkStatCounter::MemoryAllocated,    mem.memoryAllocated);
+    result.setCtr(DxvkStatCounter::MemoryUsed,         mem.memoryUsed);
+    result.setCtr(DxvkStatCounter::ShaderModuleCount,  modules.moduleCount);
+    result.setCtr(DxvkStatCounter::ShaderModuleMemory, modules.codeSize);
+    result.setCtr(DxvkStatCounter::QueueSubmitPending, m_submissionQueue.pendingSubmissions());
     
     std::lock_guard<sync::Spinlock> lock(m_statLock);
     result.merge(m_statCounters);
@@ -190,6 +236,18 @@ namespace dxvk {
   }
   
   
+  void DxvkDevice::trackRenamedBuffer(
+          DxvkBuffer*               buffer) {
+    m_bufferRenameLog.trackBuffer(buffer);
+  }
+  
+  
+  void DxvkDevice::untrackRenamedBuffer(
+          DxvkBuffer*               buffer) {
+    m_bufferRenameLog.untrackBuffer(buffer);
+  }
+  
+  
   void DxvkDevice::initResources() {
     m_unboundResources.clearResources(this);
   }
@@ -197,13 +255,27 @@ namespace dxvk {
   
   VkResult DxvkDevice::presentSwapImage(
     const VkPresentInfoKHR&         presentInfo) {
+    // The present operation waits on a semaphore that is
+    // signaled by a command list, which must be submitted
+    m_submissionQueue.synchronize();
+    
+    VkResult status;
+    
     { // Queue submissions are not thread safe
       std::lock_guard<std::mutex> queueLock(m_submissionLock);
       std::lock_guard<sync::Spinlock> statLock(m_statLock);
       
       m_statCounters.addCtr(DxvkStatCounter::QueuePresentCount, 1);
-      return m_vkd->vkQueuePresentKHR(m_presentQueue, &presentInfo);
+      status = m_vkd->vkQueuePresentKHR(m_presentQueue, &presentInfo);
     }
+    
+    if (m_statsExporter.enabled())
+      m_statsExporter.addFrame(this->getStatCounters());
+    
+    // Give buffers that are no longer being renamed
+    // a chance to release their oversized pools
+    m_bufferRenameLog.updatePools();
+    return status;
   }
   
   
@@ -211,51 +283,67 @@ namespace dxvk {
     const Rc<DxvkCommandList>&      commandList,
     const Rc<DxvkSemaphore>&        waitSync,
     const Rc<DxvkSemaphore>&        wakeSync) {
-    VkSemaphore waitSemaphore = VK_NULL_HANDLE;
-    VkSemaphore wakeSemaphore = VK_NULL_HANDLE;
+    DxvkSubmission submission;
+    submission.cmdList = commandList;
     
     if (waitSync != nullptr) {
-      waitSemaphore = waitSync->handle();
+      submission.waitSync = waitSync->handle();
       commandList->trackResource(waitSync);
     }
     
     if (wakeSync != nullptr) {
-      wakeSemaphore = wakeSync->handle();
+      submission.wakeSync = wakeSync->handle();
       commandList->trackResource(wakeSync);
     }
     
-    VkResult status;
-    
-    { // Queue submissions are not thread safe
-      std::lock_guard<std::mutex> queueLock(m_submissionLock);
-      std::lock_guard<sync::Spinlock> statLock(m_statLock);
-      
+    { std::lock_guard<sync::Spinlock> statLock(m_statLock);
       m_statCounters.merge(commandList->statCounters());
       m_statCounters.addCtr(DxvkStatCounter::QueueSubmitCount, 1);
-      
-      status = commandList->submit(
-        m_graphicsQueue, waitSemaphore, wakeSemaphore);
     }
     
-    if (status == VK_SUCCESS) {
-      // Add this to the set of running submissions
-      m_submissionQueue.submit(commandList);
-    } else {
-      Logger::err(str::format(
-        "DxvkDevice: Command buffer submission failed: ",
-        status));
-    }
+    // The actual vkQueueSubmit call happens
+    // on the submission queue's own thread
+    m_submissionQueue.submit(std::move(submission));
   }
   
   
   void DxvkDevice::waitForIdle() {
+    m_submissionQueue.synchronize();
+    
+    // vkDeviceWaitIdle requires access to all queues
+    // to be externally synchronized
+    std::lock_guard<std::mutex> queueLock(m_submissionLock);
+    
     if (m_vkd->vkDeviceWaitIdle(m_vkd->device()) != VK_SUCCESS)
       Logger::err("DxvkDevice: waitForIdle: Operation failed");
   }
   
   
+  VkResult DxvkDevice::submitToQueue(
+    const DxvkSubmission&           submission) {
+    // Queue submissions are not thread safe
+    std::lock_guard<std::mutex> queueLock(m_submissionLock);
+    
+    return submission.cmdList->submit(m_graphicsQueue,
+      submission.waitSync, submission.wakeSync);
+  }
+  
+  
+  void DxvkDevice::addStatCtr(
+          DxvkStatCounter           ctr,
+          uint64_t                  val) {
+    std::lock_guard<sync::Spinlock> statLock(m_statLock);
+    m_statCounters.addCtr(ctr, val);
+  }
+  
+  
   void DxvkDevice::recycleCommandList(const Rc<DxvkCommandList>& cmdList) {
     m_recycledCommandLists.returnObject(cmdList);
   }
   
+  
+  void DxvkDevice::recycleSecondaryCommandList(const Rc<DxvkCommandList>& cmdList) {
+    m_recycledSecondaryCmdLists.returnObject(cmdList);
+  }
+  
 }
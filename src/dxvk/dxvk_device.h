@@ -5,11 +5,13 @@
 #include "dxvk_compute.h"
 #include "dxvk_constant_state.h"
 #include "dxvk_context.h"
+#include "dxvk_cs_stats.h"
 #include "dxvk_extensions.h"
 #include "dxvk_framebuffer.h"
 #include "dxvk_image.h"
 #include "dxvk_memory.h"
 #include "dxvk_meta_clear.h"
+#include "dxvk_meta_mipgen.h"
 #include "dxvk_pipecache.h"
 #include "dxvk_pipemanager.h"
 #include "dxvk_queue.h"
@@ -18,7 +20,9 @@
 #include "dxvk_renderpass.h"
 #include "dxvk_sampler.h"
 #include "dxvk_shader.h"
+#include "dxvk_state_cache.h"
 #include "dxvk_stats.h"
+#include "dxvk_stats_export.h"
 #include "dxvk_swapchain.h"
 #include "dxvk_sync.h"
 #include "dxvk_unbound.h"
@@ -37,6 +41,7 @@ namespace dxvk {
    */
   class DxvkDevice : public RcObject {
     friend class DxvkContext;
+    friend class DxvkSecondaryCommands;
     friend class DxvkSubmissionQueue;
     
     constexpr static VkDeviceSize DefaultStagingBufferSize = 4 * 1024 * 1024;
@@ -93,6 +98,17 @@ namespace dxvk {
       return m_features;
     }
     
+    /**
+     * \brief Uniform buffer ring
+     * 
+     * Shared allocator for small uniform
+     * buffers that are invalidated often.
+     * \returns Uniform buffer ring
+     */
+    Rc<DxvkUniformRing> uniformRing() const {
+      return m_uniformRing;
+    }
+    
     /**
      * \brief Allocates a physical buffer
      * 
@@ -133,6 +149,15 @@ namespace dxvk {
      */
     Rc<DxvkCommandList> createCommandList();
     
+    /**
+     * \brief Creates a secondary command list
+     * 
+     * Secondary command lists are recycled once the
+     * secondary commands that own them are destroyed.
+     * \returns The command list
+     */
+    Rc<DxvkCommandList> createSecondaryCommandList();
+    
     /**
      * \brief Creates a context
      * 
@@ -153,6 +178,20 @@ namespace dxvk {
     Rc<DxvkFramebuffer> createFramebuffer(
       const DxvkRenderTargets& renderTargets);
     
+    /**
+     * \brief Retrieves a pipeline layout
+     * 
+     * Pipeline layouts are shared between all pipelines
+     * that use the same set of resource bindings, so the
+     * returned object may already be in use.
+     * \param [in] slotMapping Descriptor slot mapping
+     * \param [in] pipelineBindPoint Pipeline bind point
+     * \returns The pipeline layout object
+     */
+    Rc<DxvkPipelineLayout> createPipelineLayout(
+      const DxvkDescriptorSlotMapping&  slotMapping,
+            VkPipelineBindPoint         pipelineBindPoint) const;
+    
     /**
      * \brief Creates a buffer object
      * 
@@ -257,6 +296,83 @@ namespace dxvk {
      */
     DxvkStatCounters getStatCounters();
     
+    /**
+     * \brief Increments a stat counter
+     * 
+     * Used for counters that are not tied
+     * to a specific command list.
+     * \param [in] ctr The counter
+     * \param [in] val Value to add
+     */
+    void addStatCtr(
+            DxvkStatCounter           ctr,
+            uint64_t                  val);
+    
+    /**
+     * \brief CS thread statistics
+     * 
+     * Shared by all CS threads that
+     * execute commands on this device.
+     * \returns CS thread statistics
+     */
+    DxvkCsStats* csStats() {
+      return &m_csStats;
+    }
+    
+    /**
+     * \brief Shader module counters
+     * 
+     * Tracks the shader modules that are
+     * created for pipelines on this device.
+     * \returns Shader module counters
+     */
+    const Rc<DxvkShaderModuleCounters>& shaderModuleCounters() const {
+      return m_shaderModuleCounters;
+    }
+    
+    /**
+     * \brief State cache
+     * 
+     * Records compiled graphics pipelines so
+     * that they can be precompiled next time.
+     * \returns State cache
+     */
+    DxvkStateCache* stateCache() const {
+      return m_stateCache.ptr();
+    }
+    
+    /**
+     * \brief Registers a shader
+     * 
+     * Must be called for every shader created by the
+     * client API so that cached pipelines using the
+     * shader can be compiled ahead of time.
+     * \param [in] shader Newly created shader
+     */
+    void registerShader(
+      const Rc<DxvkShader>&           shader);
+    
+    /**
+     * \brief Tracks a renamed buffer
+     * 
+     * Called when a buffer gets renamed for the first
+     * time. The pools of tracked buffers are updated
+     * once per frame, and the most frequently renamed
+     * buffers are logged on device destruction.
+     * \param [in] buffer The buffer
+     */
+    void trackRenamedBuffer(
+            DxvkBuffer*               buffer);
+    
+    /**
+     * \brief Stops tracking a renamed buffer
+     * 
+     * Called when a tracked buffer gets destroyed.
+     * \param [in] buffer The buffer
+     */
+    void untrackRenamedBuffer(
+            DxvkBuffer*               buffer);
+    
     /**
      * \brief Initializes dummy resources
      * 
@@ -280,7 +396,9 @@ namespace dxvk {
     /**
      * \brief Submits a command list
      * 
-     * Synchronization arguments are optional. 
+     * Synchronization arguments are optional. The command
+     * list is submitted to the device asynchronously, but
+     * in the same order as it was passed to this method.
      * \param [in] commandList The command list to submit
      * \param [in] waitSync (Optional) Semaphore to wait on
      * \param [in] wakeSync (Optional) Semaphore to notify
@@ -315,18 +433,28 @@ namespace dxvk {
     Rc<DxvkMemoryAllocator>   m_memory;
     Rc<DxvkRenderPassPool>    m_renderPassPool;
     Rc<DxvkPipelineCache>     m_pipelineCache;
+    Rc<DxvkPipelineLayoutPool> m_pipelineLayoutPool;
+    Rc<DxvkPipelineManager>   m_pipelineManager;
+    Rc<DxvkStateCache>        m_stateCache;
     Rc<DxvkMetaClearObjects>  m_metaClearObjects;
+    Rc<DxvkMetaMipGenObjects> m_metaMipGenObjects;
+    Rc<DxvkShaderModuleCounters> m_shaderModuleCounters;
+    Rc<DxvkUniformRing>       m_uniformRing;
     
+    DxvkBufferRenameLog       m_bufferRenameLog;
     DxvkUnboundResources      m_unboundResources;
     
     sync::Spinlock            m_statLock;
     DxvkStatCounters          m_statCounters;
+    DxvkCsStats               m_csStats;
+    DxvkStatsExporter         m_statsExporter;
     
     std::mutex m_submissionLock;
     VkQueue m_graphicsQueue = VK_NULL_HANDLE;
     VkQueue m_presentQueue  = VK_NULL_HANDLE;
     
     DxvkRecycler<DxvkCommandList,  16> m_recycledCommandLists;
+    DxvkRecycler<DxvkCommandList,  64> m_recycledSecondaryCmdLists;
     DxvkRecycler<DxvkStagingBuffer, 4> m_recycledStagingBuffers;
     
     DxvkSubmissionQueue m_submissionQueue;
@@ -334,6 +462,12 @@ namespace dxvk {
     void recycleCommandList(
       const Rc<DxvkCommandList>& cmdList);
     
+    void recycleSecondaryCommandList(
+      const Rc<DxvkCommandList>& cmdList);
+    
+    VkResult submitToQueue(
+      const DxvkSubmission&           submission);
+    
     /**
      * \brief Dummy buffer handle
      * \returns Use for unbound vertex buffers.
@@ -17,8 +17,10 @@ namespace dxvk {
   void DxvkEvent::signal(uint32_t revision) {
     std::unique_lock<std::mutex> lock(m_mutex);
     
-    if (m_revision == revision)
+    if (m_revision == revision) {
       m_status = DxvkEventStatus::Signaled;
+      m_signal.notify_all();
+    }
   }
   
   
@@ -27,4 +29,13 @@ namespace dxvk {
     return m_status;
   }
   
+  
+  void DxvkEvent::wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    m_signal.wait(lock, [this] {
+      return m_status == DxvkEventStatus::Signaled;
+    });
+  }
+  
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <condition_variable>
 #include <mutex>
 
 #include "dxvk_include.h"
@@ -46,9 +47,18 @@ namespace dxvk {
      */
     DxvkEventStatus getStatus();
     
+    /**
+     * \brief Waits for the event to be signaled
+     * 
+     * Blocks the calling thread until the
+     * current revision has been signaled.
+     */
+    void wait();
+    
   private:
     
-    std::mutex m_mutex;
+    std::mutex              m_mutex;
+    std::condition_variable m_signal;
     
     DxvkEventStatus         m_status   = DxvkEventStatus::Signaled;
     uint32_t                m_revision = 0;
@@ -0,0 +1,85 @@
+#include <thread>
+
+#include "dxvk_frame_limiter.h"
+
+namespace dxvk {
+  
+  DxvkFrameClock::TimePoint DxvkSystemClock::now() {
+    return std::chrono::time_point_cast<Duration>(
+      std::chrono::steady_clock::now());
+  }
+  
+  
+  void DxvkSystemClock::sleep(Duration duration) {
+    std::this_thread::sleep_for(duration);
+  }
+  
+  
+  constexpr DxvkFrameClock::Duration DxvkFrameLimiter::MinSleepMargin;
+  constexpr DxvkFrameClock::Duration DxvkFrameLimiter::MaxSleepMargin;
+  
+  
+  DxvkFrameLimiter::DxvkFrameLimiter(DxvkFrameClock* clock)
+  : m_clock(clock), m_lastFrame(clock->now()) {
+    
+  }
+  
+  
+  DxvkFrameLimiter::~DxvkFrameLimiter() {
+    
+  }
+  
+  
+  void DxvkFrameLimiter::setTargetFrameRate(double frameRate) {
+    m_targetInterval = frameRate > 0.0
+      ? Duration(int64_t(1'000'000'000.0 / frameRate))
+      : Duration::zero();
+  }
+  
+  
+  void DxvkFrameLimiter::delay() {
+    TimePoint now = m_clock->now();
+    
+    if (m_targetInterval == Duration::zero()) {
+      m_lastFrame = now;
+      return;
+    }
+    
+    TimePoint target = m_lastFrame + m_targetInterval;
+    
+    if (now < target) {
+      this->waitUntil(target);
+      m_lastFrame = target;
+    } else {
+      // If we are only slightly late, keep the cadence so that
+      // the average frame rate still matches the target. If we
+      // missed an entire interval, start over from here.
+      m_lastFrame = now - target < m_targetInterval ? target : now;
+    }
+  }
+  
+  
+  void DxvkFrameLimiter::waitUntil(TimePoint target) {
+    TimePoint now = m_clock->now();
+    
+    if (target - now > m_sleepMargin) {
+      const Duration sleepTime = target - now - m_sleepMargin;
+      
+      m_clock->sleep(sleepTime);
+      
+      const TimePoint wakeTime = m_clock->now();
+      const Duration  overshoot = (wakeTime - now) - sleepTime;
+      
+      // Grow the margin quickly when the sleep overshoots,
+      // and shrink it slowly while sleeping is accurate.
+      m_sleepMargin = std::max(m_sleepMargin - m_sleepMargin / 16, overshoot * 2);
+      m_sleepMargin = std::min(std::max(m_sleepMargin, MinSleepMargin), MaxSleepMargin);
+      
+      now = wakeTime;
+    }
+    
+    while (now < target)
+      now = m_clock->now();
+  }
+  
+}
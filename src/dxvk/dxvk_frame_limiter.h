@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+
+#include "dxvk_include.h"
+
+namespace dxvk {
+  
+  /**
+   * \brief Frame clock
+   * 
+   * Monotonic time source used for frame pacing
+   * and frame time statistics. Can be replaced
+   * in order to test timing logic without having
+   * to depend on real time.
+   */
+  class DxvkFrameClock {
+    
+  public:
+    
+    using Duration  = std::chrono::nanoseconds;
+    using TimePoint = std::chrono::time_point<std::chrono::steady_clock, Duration>;
+    
+    virtual ~DxvkFrameClock() { }
+    
+    /**
+     * \brief Queries current time
+     * \returns Current time
+     */
+    virtual TimePoint now() = 0;
+    
+    /**
+     * \brief Suspends the calling thread
+     * 
+     * May return later than requested, but
+     * must not return any earlier.
+     * \param [in] duration Time to sleep
+     */
+    virtual void sleep(Duration duration) = 0;
+    
+  };
+  
+  
+  /**
+   * \brief System clock
+   * 
+   * Uses \c std::chrono::steady_clock
+   * and the operating system's sleep.
+   */
+  class DxvkSystemClock : public DxvkFrameClock {
+    
+  public:
+    
+    TimePoint now() final;
+    
+    void sleep(Duration duration) final;
+    
+  };
+  
+  
+  /**
+   * \brief Frame rate limiter
+   * 
+   * Delays presentation so that frames are presented at a
+   * fixed rate. In order to keep jitter low, the limiter
+   * sleeps until shortly before the target time and then
+   * spins. The spin margin adapts to how much the clock's
+   * sleep function tends to overshoot.
+   */
+  class DxvkFrameLimiter {
+    using Duration  = DxvkFrameClock::Duration;
+    using TimePoint = DxvkFrameClock::TimePoint;
+  public:
+    
+    /**
+     * \brief Creates a frame limiter
+     * 
+     * \param [in] clock Clock to use. Must stay
+     *        valid for the lifetime of the limiter.
+     */
+    DxvkFrameLimiter(DxvkFrameClock* clock);
+    ~DxvkFrameLimiter();
+    
+    /**
+     * \brief Sets target frame rate
+     * 
+     * \param [in] frameRate Frames per second.
+     *        If zero, the limiter is disabled.
+     */
+    void setTargetFrameRate(double frameRate);
+    
+    /**
+     * \brief Current spin margin
+     * \returns Spin margin
+     */
+    Duration sleepMargin() const {
+      return m_sleepMargin;
+    }
+    
+    /**
+     * \brief Waits until the next frame is due
+     * 
+     * Must be called once per frame, immediately
+     * before the frame is presented.
+     */
+    void delay();
+    
+  private:
+    
+    static constexpr Duration MinSleepMargin = std::chrono::microseconds(200);
+    static constexpr Duration MaxSleepMargin = std::chrono::microseconds(4000);
+    
+    DxvkFrameClock* m_clock;
+    
+    Duration  m_targetInterval = Duration::zero();
+    Duration  m_sleepMargin    = std::chrono::microseconds(1000);
+    TimePoint m_lastFrame;
+    
+    void waitUntil(TimePoint target);
+    
+  };
+  
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+
+#include "dxvk_frame_stats.h"
+
+namespace dxvk {
+  
+  DxvkFrameStats::DxvkFrameStats(size_t windowSize)
+  : m_windowSize(std::max<size_t>(windowSize, 1)) {
+    m_frames.reserve(m_windowSize);
+  }
+  
+  
+  DxvkFrameStats::~DxvkFrameStats() {
+    
+  }
+  
+  
+  void DxvkFrameStats::addFrame(Duration frameTime) {
+    if (m_frames.size() < m_windowSize) {
+      m_frames.push_back(frameTime);
+    } else {
+      m_frames[m_nextFrame] = frameTime;
+      m_nextFrame = (m_nextFrame + 1) % m_windowSize;
+    }
+  }
+  
+  
+  void DxvkFrameStats::reset() {
+    m_frames.clear();
+    m_nextFrame = 0;
+  }
+  
+  
+  DxvkFrameTimeSummary DxvkFrameStats::getSummary() const {
+    DxvkFrameTimeSummary result;
+    
+    if (m_frames.size() == 0)
+      return result;
+    
+    std::vector<Duration> sorted = m_frames;
+    std::sort(sorted.begin(), sorted.end());
+    
+    Duration total = Duration::zero();
+    
+    for (Duration frameTime : sorted)
+      total += frameTime;
+    
+    const Duration median = sorted[sorted.size() / 2];
+    const Duration p99    = sorted[((sorted.size() - 1) * 99) / 100];
+    
+    for (Duration frameTime : sorted)
+      result.stutterCount += frameTime > median * 2 ? 1 : 0;
+    
+    auto toMs = [] (Duration d) {
+      return std::chrono::duration<double, std::milli>(d).count();
+    };
+    
+    result.frameCount = sorted.size();
+    result.meanMs     = toMs(total) / double(sorted.size());
+    result.p99Ms      = toMs(p99);
+    result.maxMs      = toMs(sorted.back());
+    return result;
+  }
+  
+  
+  DxvkFrameTimeLog::DxvkFrameTimeLog(
+    const std::string&  fileName,
+          TimePoint     startTime,
+          Duration      interval)
+  : m_file      (fileName),
+    m_stats     (4096),
+    m_startTime (startTime),
+    m_lastFrame (startTime),
+    m_lastWrite (startTime),
+    m_interval  (interval) {
+    if (!m_file)
+      Logger::err(str::format("DxvkFrameTimeLog: Failed to open ", fileName));
+    
+    m_file << "time_s,frames,mean_ms,p99_ms,max_ms,stutters" << std::endl;
+  }
+  
+  
+  DxvkFrameTimeLog::~DxvkFrameTimeLog() {
+    
+  }
+  
+  
+  void DxvkFrameTimeLog::addFrame(TimePoint time) {
+    m_stats.addFrame(time - m_lastFrame);
+    m_lastFrame = time;
+    
+    if (time - m_lastWrite < m_interval)
+      return;
+    
+    DxvkFrameTimeSummary summary = m_stats.getSummary();
+    
+    m_file << std::chrono::duration<double>(time - m_startTime).count() << ","
+           << summary.frameCount   << ","
+           << summary.meanMs       << ","
+           << summary.p99Ms        << ","
+           << summary.maxMs        << ","
+           << summary.stutterCount << std::endl;
+    
+    m_stats.reset();
+    m_lastWrite = time;
+  }
+  
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <fstream>
+#include <vector>
+
+#include "dxvk_frame_limiter.h"
+
+namespace dxvk {
+  
+  /**
+   * \brief Frame time summary
+   * 
+   * All times are in milliseconds. A stutter is a frame that
+   * took more than twice as long as the median frame.
+   */
+  struct DxvkFrameTimeSummary {
+    uint32_t frameCount   = 0;
+    double   meanMs       = 0.0;
+    double   p99Ms        = 0.0;
+    double   maxMs        = 0.0;
+    uint32_t stutterCount = 0;
+  };
+  
+  
+  /**
+   * \brief Frame time statistics
+   * 
+   * Keeps the frame times of the most recent
+   * frames and computes summary statistics.
+   * Does not query any clock by itself.
+   */
+  class DxvkFrameStats {
+    using Duration = DxvkFrameClock::Duration;
+  public:
+    
+    /**
+     * \brief Creates frame statistics
+     * \param [in] windowSize Number of frames to keep
+     */
+    DxvkFrameStats(size_t windowSize);
+    ~DxvkFrameStats();
+    
+    /**
+     * \brief Adds a frame
+     * 
+     * Replaces the oldest frame if the window is full.
+     * \param [in] frameTime Time the frame took
+     */
+    void addFrame(Duration frameTime);
+    
+    /**
+     * \brief Removes all frames
+     */
+    void reset();
+    
+    /**
+     * \brief Computes summary statistics
+     * \returns Summary of the frames in the window
+     */
+    DxvkFrameTimeSummary getSummary() const;
+    
+  private:
+    
+    std::vector<Duration> m_frames;
+    size_t                m_windowSize;
+    size_t                m_nextFrame = 0;
+    
+  };
+  
+  
+  /**
+   * \brief Frame time log
+   * 
+   * Writes one line of frame time statistics per
+   * interval to a CSV file. The time of each frame
+   * is passed in by the caller.
+   */
+  class DxvkFrameTimeLog {
+    using Duration  = DxvkFrameClock::Duration;
+    using TimePoint = DxvkFrameClock::TimePoint;
+  public:
+    
+    DxvkFrameTimeLog(
+      const std::string&  fileName,
+            TimePoint     startTime,
+            Duration      interval);
+    ~DxvkFrameTimeLog();
+    
+    /**
+     * \brief Records a frame
+     * \param [in] time Time the frame was presented
+     */
+    void addFrame(TimePoint time);
+    
+  private:
+    
+    std::ofstream   m_file;
+    DxvkFrameStats  m_stats;
+    
+    TimePoint       m_startTime;
+    TimePoint       m_lastFrame;
+    TimePoint       m_lastWrite;
+    Duration        m_interval;
+    
+  };
+  
+}
@@ -161,6 +161,16 @@ namespace dxvk {
       return m_renderPass->handle();
     }
     
+    /**
+     * \brief Render pass handle for the given load ops
+     * 
+     * \param [in] ops Attachment load ops
+     * \returns Compatible render pass handle
+     */
+    VkRenderPass renderPass(const DxvkRenderPassOps& ops) const {
+      return m_renderPass->handle(ops);
+    }
+    
     /**
      * \brief Framebuffer size
      * \returns Framebuffer size
@@ -43,7 +43,7 @@ namespace dxvk {
     const Rc<DxvkShader>&         gs,
     const Rc<DxvkShader>&         fs)
   : m_device(device), m_vkd(device->vkd()),
-    m_cache(cache) {
+    m_cache(cache), m_shaders({ vs, tcs, tes, gs, fs }) {
     DxvkDescriptorSlotMapping slotMapping;
     if (vs  != nullptr) vs ->defineResourceSlots(slotMapping);
     if (tcs != nullptr) tcs->defineResourceSlots(slotMapping);
@@ -51,16 +51,17 @@ namespace dxvk {
     if (gs  != nullptr) gs ->defineResourceSlots(slotMapping);
     if (fs  != nullptr) fs ->defineResourceSlots(slotMapping);
     
-    m_layout = new DxvkPipelineLayout(m_vkd,
-      slotMapping.bindingCount(),
-      slotMapping.bindingInfos(),
-      VK_PIPELINE_BIND_POINT_GRAPHICS);
+    slotMapping.makeUniformBuffersDynamic(device->adapter()
+      ->deviceProperties().limits.maxDescriptorSetUniformBuffersDynamic);
     
-    if (vs  != nullptr) m_vs  = vs ->createShaderModule(m_vkd, slotMapping);
-    if (tcs != nullptr) m_tcs = tcs->createShaderModule(m_vkd, slotMapping);
-    if (tes != nullptr) m_tes = tes->createShaderModule(m_vkd, slotMapping);
-    if (gs  != nullptr) m_gs  = gs ->createShaderModule(m_vkd, slotMapping);
-    if (fs  != nullptr) m_fs  = fs ->createShaderModule(m_vkd, slotMapping);
+    m_layout = device->createPipelineLayout(
+      slotMapping, VK_PIPELINE_BIND_POINT_GRAPHICS);
+    
+    if (vs  != nullptr) m_vs  = vs ->createShaderModule(m_vkd, m_device->shaderModuleCounters(), slotMapping);
+    if (tcs != nullptr) m_tcs = tcs->createShaderModule(m_vkd, m_device->shaderModuleCounters(), slotMapping);
+    if (tes != nullptr) m_tes = tes->createShaderModule(m_vkd, m_device->shaderModuleCounters(), slotMapping);
+    if (gs  != nullptr) m_gs  = gs ->createShaderModule(m_vkd, m_device->shaderModuleCounters(), slotMapping);
+    if (fs  != nullptr) m_fs  = fs ->createShaderModule(m_vkd, m_device->shaderModuleCounters(), slotMapping);
     
     m_vsIn  = vs != nullptr ? vs->interfaceSlots().inputSlots  : 0;
     m_fsOut = fs != nullptr ? fs->interfaceSlots().outputSlots : 0;
@@ -78,29 +79,66 @@ namespace dxvk {
   VkPipeline DxvkGraphicsPipeline::getPipelineHandle(
     const DxvkGraphicsPipelineStateInfo& state,
           DxvkStatCounters&              stats) {
-    
-    for (const PipelineStruct& pair : m_pipelines) {
-      if (pair.stateVector == state)
-        return pair.pipeline;
+    VkPipeline pipeline  = VK_NULL_HANDLE;
+    VkPipeline basePipeline;
+    
+    { std::lock_guard<std::mutex> lock(m_mutex);
+      
+      if (this->findPipeline(state, pipeline))
+        return pipeline;
+      
+      basePipeline = m_basePipeline;
     }
     
-    VkPipeline pipeline = this->validatePipelineState(state)
-      ? this->compilePipeline(state, m_basePipeline)
+    // Compiling a pipeline can take a long time, so we don't hold
+    // the lock here. The state cache may compile pipelines for
+    // this object on a worker thread at the same time.
+    VkPipeline newPipeline = this->validatePipelineState(state)
+      ? this->compilePipeline(state, basePipeline)
       : VK_NULL_HANDLE;
     
-    m_pipelines.push_back({ state, pipeline });
+    { std::lock_guard<std::mutex> lock(m_mutex);
+      
+      // If another thread finished compiling an identical
+      // pipeline in the meantime, discard our pipeline
+      if (this->findPipeline(state, pipeline)) {
+        m_vkd->vkDestroyPipeline(m_vkd->device(), newPipeline, nullptr);
+        return pipeline;
+      }
+      
+      m_pipelines.push_back({ state, newPipeline });
+      
+      if (m_basePipeline == VK_NULL_HANDLE)
+        m_basePipeline = newPipeline;
+    }
     
-    if (m_basePipeline == VK_NULL_HANDLE)
-      m_basePipeline = pipeline;
+    if (newPipeline != VK_NULL_HANDLE)
+      m_device->stateCache()->addGraphicsPipeline(m_shaders, state);
     
     stats.addCtr(DxvkStatCounter::PipeCountGraphics, 1);
-    return pipeline;
+    return newPipeline;
+  }
+  
+  
+  bool DxvkGraphicsPipeline::findPipeline(
+    const DxvkGraphicsPipelineStateInfo& state,
+          VkPipeline&                    pipeline) const {
+    for (const PipelineStruct& pair : m_pipelines) {
+      if (pair.stateVector == state) {
+        pipeline = pair.pipeline;
+        return true;
+      }
+    }
+    
+    return false;
   }
   
   
   VkPipeline DxvkGraphicsPipeline::compilePipeline(
     const DxvkGraphicsPipelineStateInfo& state,
           VkPipeline                     baseHandle) const {
+    DXVK_PROFILE_ZONE("Compile graphics pipeline");
+    
     if (Logger::logLevel() <= LogLevel::Debug) {
       Logger::debug("Compiling graphics pipeline...");
       this->logPipelineState(LogLevel::Debug, state);
@@ -262,9 +300,12 @@ namespace dxvk {
       return VK_NULL_HANDLE;
     }
     
-    auto t1 = std::chrono::high_resolution_clock::now();
-    auto td = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
-    Logger::debug(str::format("DxvkGraphicsPipeline: Finished in ", td.count(), " ms"));
+    if (Logger::logLevel() <= LogLevel::Debug) {
+      auto t1 = std::chrono::high_resolution_clock::now();
+      auto td = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+      Logger::debug(str::format("DxvkGraphicsPipeline: Finished in ", td.count(), " ms"));
+    }
+    
     return pipeline;
   }
   
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <vector>
 
 #include "dxvk_binding.h"
@@ -77,6 +78,21 @@ namespace dxvk {
   };
   
   
+  /**
+   * \brief Graphics pipeline shaders
+   * 
+   * Shader objects used by a graphics
+   * pipeline. Unused stages are null.
+   */
+  struct DxvkGraphicsPipelineShaders {
+    Rc<DxvkShader> vs;
+    Rc<DxvkShader> tcs;
+    Rc<DxvkShader> tes;
+    Rc<DxvkShader> gs;
+    Rc<DxvkShader> fs;
+  };
+  
+  
   /**
    * \brief Common graphics pipeline state
    * 
@@ -126,7 +142,8 @@ namespace dxvk {
      * \brief Pipeline handle
      * 
      * Retrieves a pipeline handle for the given pipeline
-     * state. If necessary, a new pipeline will be created.
+     * state. If necessary, a new pipeline will be created
+     * and added to the state cache. This is thread-safe.
      * \param [in] state Pipeline state vector
      * \param [in,out] stats Stat counter
      * \returns Pipeline handle
@@ -148,6 +165,8 @@ namespace dxvk {
     Rc<DxvkPipelineCache>   m_cache;
     Rc<DxvkPipelineLayout>  m_layout;
     
+    DxvkGraphicsPipelineShaders m_shaders;
+    
     Rc<DxvkShaderModule>  m_vs;
     Rc<DxvkShaderModule>  m_tcs;
     Rc<DxvkShaderModule>  m_tes;
@@ -159,10 +178,15 @@ namespace dxvk {
     
     DxvkGraphicsCommonPipelineStateInfo m_common;
     
+    std::mutex                  m_mutex;
     std::vector<PipelineStruct> m_pipelines;
     
     VkPipeline m_basePipeline = VK_NULL_HANDLE;
     
+    bool findPipeline(
+      const DxvkGraphicsPipelineStateInfo& state,
+            VkPipeline&                    pipeline) const;
+    
     VkPipeline compilePipeline(
       const DxvkGraphicsPipelineStateInfo& state,
             VkPipeline                     baseHandle) const;
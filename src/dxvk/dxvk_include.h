@@ -3,6 +3,8 @@
 #include "../util/log/log.h"
 #include "../util/log/log_debug.h"
 
+#include "../util/prof/prof.h"
+
 #include "../util/util_env.h"
 #include "../util/util_error.h"
 #include "../util/util_flags.h"
@@ -0,0 +1,202 @@
+#include "dxvk_meta_mipgen.h"
+
+#include <dxvk_mipgen_2darr.h>
+
+namespace dxvk {
+  
+  DxvkMetaMipGenObjects::DxvkMetaMipGenObjects(const Rc<vk::DeviceFn>& vkd)
+  : m_vkd(vkd) {
+    m_sampler    = createSampler();
+    m_dsetLayout = createDescriptorSetLayout();
+    m_pipeLayout = createPipelineLayout();
+    m_pipeline   = createPipeline(dxvk_mipgen_2darr);
+  }
+  
+  
+  DxvkMetaMipGenObjects::~DxvkMetaMipGenObjects() {
+    m_vkd->vkDestroyPipeline(m_vkd->device(), m_pipeline, nullptr);
+    m_vkd->vkDestroyPipelineLayout(m_vkd->device(), m_pipeLayout, nullptr);
+    m_vkd->vkDestroyDescriptorSetLayout(m_vkd->device(), m_dsetLayout, nullptr);
+    m_vkd->vkDestroySampler(m_vkd->device(), m_sampler, nullptr);
+  }
+  
+  
+  bool DxvkMetaMipGenObjects::supportsImage(
+    const Rc<DxvkImage>&        image) {
+    const DxvkImageCreateInfo& info = image->info();
+    
+    if (info.type != VK_IMAGE_TYPE_2D
+     || info.sampleCount != VK_SAMPLE_COUNT_1_BIT
+     || !(info.usage & VK_IMAGE_USAGE_SAMPLED_BIT)
+     || !(info.usage & VK_IMAGE_USAGE_STORAGE_BIT))
+      return false;
+    
+    const DxvkFormatInfo* formatInfo = image->formatInfo();
+    
+    return formatInfo->aspectMask == VK_IMAGE_ASPECT_COLOR_BIT
+        && !formatInfo->flags.test(DxvkFormatFlag::BlockCompressed)
+        && !formatInfo->flags.test(DxvkFormatFlag::SampledInteger);
+  }
+  
+  
+  uint32_t DxvkMetaMipGenObjects::getLevelCount(
+    const Rc<DxvkImage>&        image,
+          uint32_t              srcLevel,
+          uint32_t              maxLevelCount) {
+    uint32_t levelCount = 1;
+    
+    while (levelCount < std::min(maxLevelCount, MaxLevelsPerPass)) {
+      // Level that the next level would be generated from,
+      // and the tile size of that level within a work group
+      const VkExtent3D prevExtent = image->mipLevelExtent(srcLevel + levelCount);
+      const uint32_t   tileSize   = 16u >> levelCount;
+      
+      auto needsNeighbour = [tileSize] (uint32_t extent) {
+        return (extent & 1) && extent > 1 && !((extent >> 1) % tileSize);
+      };
+      
+      if (needsNeighbour(prevExtent.width)
+       || needsNeighbour(prevExtent.height))
+        break;
+      
+      levelCount += 1;
+    }
+    
+    return levelCount;
+  }
+  
+  
+  DxvkMetaMipGenPipeline DxvkMetaMipGenObjects::getPipeline() const {
+    DxvkMetaMipGenPipeline result;
+    result.dsetLayout    = m_dsetLayout;
+    result.pipeLayout    = m_pipeLayout;
+    result.pipeline      = m_pipeline;
+    result.workgroupSize = VkExtent3D { 16, 16, 1 };
+    return result;
+  }
+  
+  
+  VkSampler DxvkMetaMipGenObjects::createSampler() {
+    VkSamplerCreateInfo samplerInfo;
+    samplerInfo.sType                   = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.pNext                   = nullptr;
+    samplerInfo.flags                   = 0;
+    samplerInfo.magFilter               = VK_FILTER_NEAREST;
+    samplerInfo.minFilter               = VK_FILTER_NEAREST;
+    samplerInfo.mipmapMode              = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.mipLodBias              = 0.0f;
+    samplerInfo.anisotropyEnable        = VK_FALSE;
+    samplerInfo.maxAnisotropy           = 1.0f;
+    samplerInfo.compareEnable           = VK_FALSE;
+    samplerInfo.compareOp               = VK_COMPARE_OP_ALWAYS;
+    samplerInfo.minLod                  = 0.0f;
+    samplerInfo.maxLod                  = 0.0f;
+    samplerInfo.borderColor             = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+    samplerInfo.unnormalizedCoordinates = VK_FALSE;
+    
+    VkSampler result = VK_NULL_HANDLE;
+    if (m_vkd->vkCreateSampler(m_vkd->device(),
+          &samplerInfo, nullptr, &result) != VK_SUCCESS)
+      throw DxvkError("Dxvk: Failed to create meta mipgen sampler");
+    return result;
+  }
+  
+  
+  VkDescriptorSetLayout DxvkMetaMipGenObjects::createDescriptorSetLayout() {
+    // The source level is read through a sampled image so
+    // that we don't depend on reading storage images without
+    // a format qualifier. The sampler is only needed because
+    // GLSL cannot fetch from a texture without one.
+    std::array<VkDescriptorSetLayoutBinding, 2> bindInfos = {{
+      { 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1,
+        VK_SHADER_STAGE_COMPUTE_BIT, &m_sampler },
+      { 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, MaxLevelsPerPass,
+        VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+    }};
+    
+    VkDescriptorSetLayoutCreateInfo dsetInfo;
+    dsetInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    dsetInfo.pNext              = nullptr;
+    dsetInfo.flags              = 0;
+    dsetInfo.bindingCount       = bindInfos.size();
+    dsetInfo.pBindings          = bindInfos.data();
+    
+    VkDescriptorSetLayout result = VK_NULL_HANDLE;
+    if (m_vkd->vkCreateDescriptorSetLayout(m_vkd->device(),
+          &dsetInfo, nullptr, &result) != VK_SUCCESS)
+      throw DxvkError("Dxvk: Failed to create meta mipgen descriptor set layout");
+    return result;
+  }
+  
+  
+  VkPipelineLayout DxvkMetaMipGenObjects::createPipelineLayout() {
+    VkPushConstantRange pushInfo;
+    pushInfo.stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushInfo.offset             = 0;
+    pushInfo.size               = sizeof(DxvkMetaMipGenArgs);
+    
+    VkPipelineLayoutCreateInfo pipeInfo;
+    pipeInfo.sType              = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipeInfo.pNext              = nullptr;
+    pipeInfo.flags              = 0;
+    pipeInfo.setLayoutCount     = 1;
+    pipeInfo.pSetLayouts        = &m_dsetLayout;
+    pipeInfo.pushConstantRangeCount = 1;
+    pipeInfo.pPushConstantRanges    = &pushInfo;
+    
+    VkPipelineLayout result = VK_NULL_HANDLE;
+    if (m_vkd->vkCreatePipelineLayout(m_vkd->device(),
+          &pipeInfo, nullptr, &result) != VK_SUCCESS)
+      throw DxvkError("Dxvk: Failed to create meta mipgen pipeline layout");
+    return result;
+  }
+  
+  
+  VkPipeline DxvkMetaMipGenObjects::createPipeline(
+    const SpirvCodeBuffer&        spirvCode) {
+    VkShaderModuleCreateInfo shaderInfo;
+    shaderInfo.sType              = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    shaderInfo.pNext              = nullptr;
+    shaderInfo.flags              = 0;
+    shaderInfo.codeSize           = spirvCode.size();
+    shaderInfo.pCode              = spirvCode.data();
+    
+    VkShaderModule shaderModule = VK_NULL_HANDLE;
+    if (m_vkd->vkCreateShaderModule(m_vkd->device(),
+          &shaderInfo, nullptr, &shaderModule) != VK_SUCCESS)
+      throw DxvkError("Dxvk: Failed to create meta mipgen shader module");
+    
+    VkPipelineShaderStageCreateInfo stageInfo;
+    stageInfo.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stageInfo.pNext               = nullptr;
+    stageInfo.flags               = 0;
+    stageInfo.stage               = VK_SHADER_STAGE_COMPUTE_BIT;
+    stageInfo.module              = shaderModule;
+    stageInfo.pName               = "main";
+    stageInfo.pSpecializationInfo = nullptr;
+    
+    VkComputePipelineCreateInfo pipeInfo;
+    pipeInfo.sType                = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipeInfo.pNext                = nullptr;
+    pipeInfo.flags                = 0;
+    pipeInfo.stage                = stageInfo;
+    pipeInfo.layout               = m_pipeLayout;
+    pipeInfo.basePipelineHandle   = VK_NULL_HANDLE;
+    pipeInfo.basePipelineIndex    = -1;
+    
+    VkPipeline result = VK_NULL_HANDLE;
+    
+    const VkResult status = m_vkd->vkCreateComputePipelines(
+      m_vkd->device(), VK_NULL_HANDLE, 1, &pipeInfo, nullptr, &result);
+    
+    m_vkd->vkDestroyShaderModule(m_vkd->device(), shaderModule, nullptr);
+    
+    if (status != VK_SUCCESS)
+      throw DxvkError("Dxvk: Failed to create meta mipgen compute pipeline");
+    return result;
+  }
+  
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "dxvk_image.h"
+
+#include "../spirv/spirv_code_buffer.h"
+
+namespace dxvk {
+  
+  /**
+   * \brief Mip generation args
+   * 
+   * The data structure that can be passed
+   * to the mip generation shader as push
+   * constants.
+   */
+  struct DxvkMetaMipGenArgs {
+    VkExtent2D srcExtent;
+    uint32_t   levelCount;
+  };
+  
+  
+  /**
+   * \brief Pipeline-related objects
+   * 
+   * Use this to bind the pipeline
+   * and allocate a descriptor set.
+   */
+  struct DxvkMetaMipGenPipeline {
+    VkDescriptorSetLayout dsetLayout;
+    VkPipelineLayout      pipeLayout;
+    VkPipeline            pipeline;
+    VkExtent3D            workgroupSize;
+  };
+  
+  
+  /**
+   * \brief Mip generation shaders and related objects
+   * 
+   * Creates the compute pipeline that generates up to
+   * \c MaxLevelsPerPass mip levels from a single source
+   * level in one dispatch, using shared memory to pass
+   * intermediate results between levels.
+   */
+  class DxvkMetaMipGenObjects : public RcObject {
+    
+  public:
+    
+    constexpr static uint32_t MaxLevelsPerPass = 4;
+    
+    DxvkMetaMipGenObjects(const Rc<vk::DeviceFn>& vkd);
+    ~DxvkMetaMipGenObjects();
+    
+    /**
+     * \brief Checks whether an image is supported
+     * 
+     * The compute path only supports 2D images with
+     * float or normalized color formats which can be
+     * used as storage images. Other images need to
+     * fall back to blits.
+     * \param [in] image The image to generate mips for
+     * \returns \c true if the compute path can be used
+     */
+    static bool supportsImage(
+      const Rc<DxvkImage>&        image);
+    
+    /**
+     * \brief Computes number of levels for one pass
+     * 
+     * Odd-sized levels fold their last row or column
+     * into the last destination texel, which needs a
+     * source texel from a neighbouring work group if
+     * the destination extent is a multiple of the
+     * tile size. The pass must stop before such levels.
+     * \param [in] image The image to generate mips for
+     * \param [in] srcLevel Source level of the pass
+     * \param [in] maxLevelCount Number of levels left
+     * \returns Number of levels to generate in the pass
+     */
+    static uint32_t getLevelCount(
+      const Rc<DxvkImage>&        image,
+            uint32_t              srcLevel,
+            uint32_t              maxLevelCount);
+    
+    /**
+     * \brief Retrieves pipeline objects
+     * \returns The pipeline-related objects to use
+     */
+    DxvkMetaMipGenPipeline getPipeline() const;
+    
+  private:
+    
+    Rc<vk::DeviceFn> m_vkd;
+    
+    VkSampler             m_sampler    = VK_NULL_HANDLE;
+    VkDescriptorSetLayout m_dsetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout      m_pipeLayout = VK_NULL_HANDLE;
+    VkPipeline            m_pipeline   = VK_NULL_HANDLE;
+    
+    VkSampler createSampler();
+    
+    VkDescriptorSetLayout createDescriptorSetLayout();
+    
+    VkPipelineLayout createPipelineLayout();
+    
+    VkPipeline createPipeline(
+      const SpirvCodeBuffer&        spirvCode);
+    
+  };
+  
+}
@@ -42,15 +42,36 @@ namespace dxvk {
   }
   
   
+  void DxvkDescriptorSlotMapping::makeUniformBuffersDynamic(uint32_t maxCount) {
+    // Bindings that exceed the device limit remain regular
+    // uniform buffers and will be updated the usual way.
+    uint32_t count = 0;
+    
+    for (auto& slot : m_descriptorSlots) {
+      if (slot.type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER && count < maxCount) {
+        slot.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        count += 1;
+      }
+    }
+  }
+  
+  
   DxvkPipelineLayout::DxvkPipelineLayout(
     const Rc<vk::DeviceFn>&   vkd,
           uint32_t            bindingCount,
     const DxvkDescriptorSlot* bindingInfos,
           VkPipelineBindPoint pipelineBindPoint)
-  : m_vkd(vkd), m_bindingSlots(bindingCount) {
+  : m_vkd(vkd), m_bindPoint(pipelineBindPoint), m_bindingSlots(bindingCount) {
     
-    for (uint32_t i = 0; i < bindingCount; i++)
+    for (uint32_t i = 0; i < bindingCount; i++) {
       m_bindingSlots[i] = bindingInfos[i];
+      
+      if (bindingInfos[i].type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+        m_dynamicBindings.push_back(i);
+      
+      if (bindingInfos[i].type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+        m_hasStaticUniformBuffers = true;
+    }
     
     std::vector<VkDescriptorSetLayoutBinding>       bindings(bindingCount);
     std::vector<VkDescriptorUpdateTemplateEntryKHR> tEntries(bindingCount);
@@ -137,4 +158,75 @@ namespace dxvk {
       m_vkd->device(), m_descriptorSetLayout, nullptr);
   }
   
+  
+  bool DxvkPipelineLayout::matches(
+          uint32_t            bindingCount,
+    const DxvkDescriptorSlot* bindingInfos,
+          VkPipelineBindPoint pipelineBindPoint) const {
+    if (m_bindPoint != pipelineBindPoint
+     || m_bindingSlots.size() != bindingCount)
+      return false;
+    
+    for (uint32_t i = 0; i < bindingCount; i++) {
+      if (m_bindingSlots[i].slot   != bindingInfos[i].slot
+       || m_bindingSlots[i].type   != bindingInfos[i].type
+       || m_bindingSlots[i].view   != bindingInfos[i].view
+       || m_bindingSlots[i].stages != bindingInfos[i].stages)
+        return false;
+    }
+    
+    return true;
+  }
+  
+  
+  DxvkPipelineLayoutPool::DxvkPipelineLayoutPool(const Rc<vk::DeviceFn>& vkd)
+  : m_vkd(vkd) {
+    
+  }
+  
+  
+  DxvkPipelineLayoutPool::~DxvkPipelineLayoutPool() {
+    
+  }
+  
+  
+  Rc<DxvkPipelineLayout> DxvkPipelineLayoutPool::getLayout(
+    const DxvkDescriptorSlotMapping&  mapping,
+          VkPipelineBindPoint         pipelineBindPoint) {
+    const size_t hash = computeHash(mapping, pipelineBindPoint);
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    auto entries = m_layouts.equal_range(hash);
+    
+    for (auto e = entries.first; e != entries.second; e++) {
+      if (e->second->matches(mapping.bindingCount(), mapping.bindingInfos(), pipelineBindPoint))
+        return e->second;
+    }
+    
+    Rc<DxvkPipelineLayout> layout = new DxvkPipelineLayout(m_vkd,
+      mapping.bindingCount(), mapping.bindingInfos(), pipelineBindPoint);
+    
+    m_layouts.insert({ hash, layout });
+    return layout;
+  }
+  
+  
+  size_t DxvkPipelineLayoutPool::computeHash(
+    const DxvkDescriptorSlotMapping&  mapping,
+          VkPipelineBindPoint         pipelineBindPoint) {
+    DxvkHashState result;
+    result.add(uint32_t(pipelineBindPoint));
+    
+    for (uint32_t i = 0; i < mapping.bindingCount(); i++) {
+      const DxvkDescriptorSlot& binding = mapping.bindingInfos()[i];
+      result.add(binding.slot);
+      result.add(uint32_t(binding.type));
+      result.add(uint32_t(binding.view));
+      result.add(uint32_t(binding.stages));
+    }
+    
+    return result;
+  }
+  
 }
\ No newline at end of file
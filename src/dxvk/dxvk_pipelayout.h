@@ -1,7 +1,10 @@
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
+#include "dxvk_hash.h"
 #include "dxvk_include.h"
 
 namespace dxvk {
@@ -91,6 +94,18 @@ namespace dxvk {
     uint32_t getBindingId(
             uint32_t              slot) const;
     
+    /**
+     * \brief Makes uniform buffers dynamic
+     * 
+     * Converts uniform buffer bindings to dynamic uniform
+     * buffer bindings, so that changing the offset of a
+     * bound buffer does not require a descriptor update.
+     * \param [in] maxCount Maximum number of dynamic
+     *        uniform buffers supported by the device
+     */
+    void makeUniformBuffersDynamic(
+            uint32_t              maxCount);
+    
   private:
     
     std::vector<DxvkDescriptorSlot> m_descriptorSlots;
@@ -142,6 +157,41 @@ namespace dxvk {
       return m_bindingSlots.data();
     }
     
+    /**
+     * \brief Number of dynamic bindings
+     * 
+     * Number of dynamic offsets that have to be
+     * passed when binding a descriptor set.
+     * \returns Dynamic binding count
+     */
+    uint32_t dynamicBindingCount() const {
+      return m_dynamicBindings.size();
+    }
+    
+    /**
+     * \brief Dynamic binding index
+     * 
+     * Dynamic offsets are consumed in binding order,
+     * so this maps offset indices to binding indices.
+     * \param [in] id Dynamic offset index
+     * \returns Index of the corresponding binding
+     */
+    uint32_t dynamicBinding(uint32_t id) const {
+      return m_dynamicBindings[id];
+    }
+    
+    /**
+     * \brief Checks for non-dynamic uniform buffers
+     * 
+     * If this returns \c false, changing the offset of a
+     * uniform buffer within the same Vulkan buffer only
+     * requires the descriptor set to be bound again.
+     * \returns \c true if any uniform buffer is not dynamic
+     */
+    bool hasStaticUniformBuffers() const {
+      return m_hasStaticUniformBuffers;
+    }
+    
     /**
      * \brief Descriptor set layout handle
      * \returns Descriptor set layout handle
@@ -166,15 +216,78 @@ namespace dxvk {
       return m_descriptorTemplate;
     }
     
+    /**
+     * \brief Checks whether the layout matches a binding list
+     * 
+     * \param [in] bindingCount Number of bindings
+     * \param [in] bindingInfos Binding infos
+     * \param [in] pipelineBindPoint Pipeline bind point
+     * \returns \c true if the layout has been created
+     *          with the exact same parameters
+     */
+    bool matches(
+            uint32_t            bindingCount,
+      const DxvkDescriptorSlot* bindingInfos,
+            VkPipelineBindPoint pipelineBindPoint) const;
+    
   private:
     
     Rc<vk::DeviceFn> m_vkd;
     
+    VkPipelineBindPoint           m_bindPoint;
+    
     VkDescriptorSetLayout         m_descriptorSetLayout = VK_NULL_HANDLE;
     VkPipelineLayout              m_pipelineLayout      = VK_NULL_HANDLE;
     VkDescriptorUpdateTemplateKHR m_descriptorTemplate  = VK_NULL_HANDLE;
     
     std::vector<DxvkDescriptorSlot> m_bindingSlots;
+    std::vector<uint32_t>           m_dynamicBindings;
+    
+    bool m_hasStaticUniformBuffers = false;
+    
+  };
+  
+  
+  /**
+   * \brief Pipeline layout pool
+   * 
+   * Thread-safe class that deduplicates pipeline layouts.
+   * Pipelines that use the exact same resource bindings
+   * share a layout object, and with it the descriptor set
+   * layout and the descriptor update template. Since the
+   * layout objects are unique, they can be compared by
+   * pointer in order to check for compatibility.
+   */
+  class DxvkPipelineLayoutPool : public RcObject {
+    
+  public:
+    
+    DxvkPipelineLayoutPool(const Rc<vk::DeviceFn>& vkd);
+    ~DxvkPipelineLayoutPool();
+    
+    /**
+     * \brief Retrieves a pipeline layout
+     * 
+     * Creates a new layout if no layout with the
+     * given bindings and bind point exists yet.
+     * \param [in] mapping Descriptor slot mapping
+     * \param [in] pipelineBindPoint Pipeline bind point
+     * \returns Pipeline layout
+     */
+    Rc<DxvkPipelineLayout> getLayout(
+      const DxvkDescriptorSlotMapping&  mapping,
+            VkPipelineBindPoint         pipelineBindPoint);
+    
+  private:
+    
+    Rc<vk::DeviceFn> m_vkd;
+    
+    std::mutex m_mutex;
+    std::unordered_multimap<size_t, Rc<DxvkPipelineLayout>> m_layouts;
+    
+    static size_t computeHash(
+      const DxvkDescriptorSlotMapping&  mapping,
+            VkPipelineBindPoint         pipelineBindPoint);
     
   };
   
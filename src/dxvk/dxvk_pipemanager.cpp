@@ -55,6 +55,8 @@ namespace dxvk {
     DxvkComputePipelineKey key;
     key.cs = cs;
     
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
     auto pair = m_computePipelines.find(key);
     if (pair != m_computePipelines.end())
       return pair->second;
@@ -84,6 +86,8 @@ namespace dxvk {
     key.gs  = gs;
     key.fs  = fs;
     
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
     auto pair = m_graphicsPipelines.find(key);
     if (pair != m_graphicsPipelines.end())
       return pair->second;
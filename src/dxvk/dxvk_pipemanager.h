@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 
 #include "dxvk_compute.h"
@@ -53,6 +54,10 @@ namespace dxvk {
    * used within the application. This is necessary
    * because DXVK does not expose the concept of shader
    * pipeline objects to the client API.
+   * 
+   * The pipeline manager is owned by the device and
+   * shared by all contexts and the state cache, so
+   * all methods are thread-safe.
    */
   class DxvkPipelineManager : public RcObject {
     
@@ -99,6 +104,8 @@ namespace dxvk {
     
     const DxvkDevice* m_device;
     
+    std::mutex        m_mutex;
+    
     std::unordered_map<
       DxvkComputePipelineKey,
       Rc<DxvkComputePipeline>,
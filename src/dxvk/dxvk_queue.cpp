@@ -5,7 +5,8 @@ namespace dxvk {
   
   DxvkSubmissionQueue::DxvkSubmissionQueue(DxvkDevice* device)
   : m_device(device),
-    m_thread([this] () { threadFunc(); }) {
+    m_submitThread([this] () { submitCmdLists(); }),
+    m_finishThread([this] () { finishCmdLists(); }) {
     
   }
   
@@ -15,44 +16,104 @@ namespace dxvk {
       m_stopped.store(true);
     }
     
-    m_condOnAdd.notify_one();
-    m_thread.join();
+    m_condOnAdd.notify_all();
+    m_submitThread.join();
+    m_finishThread.join();
   }
   
   
-  void DxvkSubmissionQueue::submit(const Rc<DxvkCommandList>& cmdList) {
-    { std::unique_lock<std::mutex> lock(m_mutex);
-      
-      m_condOnTake.wait(lock, [this] {
-        return m_entries.size() < MaxNumQueuedCommandBuffers;
+  void DxvkSubmissionQueue::submit(DxvkSubmission&& submission) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    m_condOnTake.wait(lock, [this] {
+      return m_submitQueue.size() + m_finishQueue.size() < MaxNumQueuedCommandBuffers;
+    });
+    
+    m_pending += 1;
+    m_submitQueue.push({ std::move(submission), Clock::now() });
+    m_condOnAdd.notify_all();
+  }
+  
+  
+  void DxvkSubmissionQueue::synchronize() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    m_condOnSubmit.wait(lock, [this] {
+      return m_submitQueue.size() == 0;
+    });
+  }
+  
+  
+  void DxvkSubmissionQueue::submitCmdLists() {
+    Profiler::setThreadName("dxvk-submit");
+    
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    while (!m_stopped.load()) {
+      m_condOnAdd.wait(lock, [this] {
+        return m_stopped.load() || m_submitQueue.size() != 0;
       });
       
-      m_entries.push(cmdList);
-      m_condOnAdd.notify_one();
+      if (m_submitQueue.size() == 0)
+        continue;
+      
+      // The entry stays in the queue until it has been
+      // submitted, so that synchronize() can wait for it
+      Entry entry = m_submitQueue.front();
+      lock.unlock();
+      
+      VkResult status;
+      
+      { DXVK_PROFILE_ZONE("Submit command list");
+        status = m_device->submitToQueue(entry.submission);
+      }
+      
+      auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - entry.queueTime);
+      m_device->addStatCtr(DxvkStatCounter::QueueSubmitLatency, latency.count());
+      
+      lock.lock();
+      
+      if (status == VK_SUCCESS) {
+        m_finishQueue.push(std::move(entry.submission.cmdList));
+      } else {
+        Logger::err(str::format(
+          "DxvkSubmissionQueue: Command buffer submission failed: ",
+          status));
+      }
+      
+      m_submitQueue.pop();
+      m_pending -= 1;
+      
+      m_condOnAdd.notify_all();
+      m_condOnTake.notify_one();
+      m_condOnSubmit.notify_all();
     }
   }
   
   
-  void DxvkSubmissionQueue::threadFunc() {
+  void DxvkSubmissionQueue::finishCmdLists() {
+    Profiler::setThreadName("dxvk-queue");
+    
     while (!m_stopped.load()) {
       Rc<DxvkCommandList> cmdList;
       
       { std::unique_lock<std::mutex> lock(m_mutex);
         
         m_condOnAdd.wait(lock, [this] {
-          return m_stopped.load() || (m_entries.size() != 0);
+          return m_stopped.load() || m_finishQueue.size() != 0;
         });
         
-        if (m_entries.size() != 0) {
-          cmdList = std::move(m_entries.front());
-          m_entries.pop();
-        }
-        
-        m_condOnTake.notify_one();
+        if (m_finishQueue.size() != 0)
+          cmdList = m_finishQueue.front();
       }
       
       if (cmdList != nullptr) {
-        VkResult status = cmdList->synchronize();
+        VkResult status;
+        
+        { DXVK_PROFILE_ZONE("Wait for fence");
+          status = cmdList->synchronize();
+        }
         
         if (status == VK_SUCCESS) {
           cmdList->writeQueryData();
@@ -65,8 +126,14 @@ namespace dxvk {
             "DxvkSubmissionQueue: Failed to sync fence: ",
             status));
         }
+        
+        { std::unique_lock<std::mutex> lock(m_mutex);
+          m_finishQueue.pop();
+        }
+        
+        m_condOnTake.notify_one();
       }
     }
   }
   
-}
\ No newline at end of file
+}
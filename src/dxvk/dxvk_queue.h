@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -13,33 +14,91 @@ namespace dxvk {
   class DxvkDevice;
   
   /**
-   * \brief Submission queue
+   * \brief Queued command list submission
    * 
+   * Stores a command list along with the semaphores
+   * that will be passed to \c vkQueueSubmit. Both
+   * semaphores are optional.
+   */
+  struct DxvkSubmission {
+    Rc<DxvkCommandList> cmdList;
+    VkSemaphore         waitSync = VK_NULL_HANDLE;
+    VkSemaphore         wakeSync = VK_NULL_HANDLE;
+  };
+  
+  
+  /**
+   * \brief Submission queue
    * 
+   * Submits command lists to the device queue on a
+   * dedicated thread, in the order in which they were
+   * queued, so that the calling thread does not have to
+   * wait for the driver. A second thread waits for the
+   * submitted command lists to complete execution and
+   * recycles them.
    */
   class DxvkSubmissionQueue {
-    
+    using Clock = std::chrono::high_resolution_clock;
   public:
     
     DxvkSubmissionQueue(DxvkDevice* device);
     ~DxvkSubmissionQueue();
     
-    void submit(const Rc<DxvkCommandList>& cmdList);
+    /**
+     * \brief Number of pending submissions
+     * 
+     * Command lists that have been queued, but
+     * not yet been submitted to the device.
+     * \returns Pending submission count
+     */
+    uint32_t pendingSubmissions() const {
+      return m_pending.load();
+    }
+    
+    /**
+     * \brief Queues a command list for submission
+     * 
+     * Blocks if too many command lists are in flight.
+     * \param [in] submission The submission
+     */
+    void submit(DxvkSubmission&& submission);
+    
+    /**
+     * \brief Waits for pending submissions
+     * 
+     * Returns once all command lists queued prior to this
+     * call have been submitted to the device. This must be
+     * called before any operation that depends on queued
+     * work being visible to the device, e.g. a present.
+     */
+    void synchronize();
     
   private:
     
+    struct Entry {
+      DxvkSubmission    submission;
+      Clock::time_point queueTime;
+    };
+    
     DxvkDevice*             m_device;
     
     std::atomic<bool>       m_stopped = { false };
+    std::atomic<uint32_t>   m_pending = { 0u };
     
     std::mutex              m_mutex;
     std::condition_variable m_condOnAdd;
     std::condition_variable m_condOnTake;
-    std::queue<Rc<DxvkCommandList>> m_entries;
-    std::thread             m_thread;
+    std::condition_variable m_condOnSubmit;
+    std::queue<Entry>       m_submitQueue;
+    std::queue<Rc<DxvkCommandList>> m_finishQueue;
+    
+    std::thread             m_submitThread;
+    std::thread             m_finishThread;
+    
+    void submitCmdLists();
     
-    void threadFunc();
+    void finishCmdLists();
     
   };
   
-}
\ No newline at end of file
+}
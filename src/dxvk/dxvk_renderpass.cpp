@@ -26,7 +26,44 @@ namespace dxvk {
   DxvkRenderPass::DxvkRenderPass(
     const Rc<vk::DeviceFn>&     vkd,
     const DxvkRenderPassFormat& fmt)
-  : m_vkd(vkd), m_format(fmt) {
+  : m_vkd(vkd), m_format(fmt),
+    m_renderPass(createRenderPass(DxvkRenderPassOps())) {
+    
+  }
+  
+  
+  DxvkRenderPass::~DxvkRenderPass() {
+    m_vkd->vkDestroyRenderPass(
+      m_vkd->device(), m_renderPass, nullptr);
+    
+    for (const auto& variant : m_variants) {
+      m_vkd->vkDestroyRenderPass(
+        m_vkd->device(), variant.second, nullptr);
+    }
+  }
+  
+  
+  VkRenderPass DxvkRenderPass::handle(const DxvkRenderPassOps& ops) {
+    if (ops == DxvkRenderPassOps())
+      return m_renderPass;
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    for (const auto& variant : m_variants) {
+      if (variant.first == ops)
+        return variant.second;
+    }
+    
+    VkRenderPass renderPass = this->createRenderPass(ops);
+    m_variants.push_back({ ops, renderPass });
+    return renderPass;
+  }
+  
+  
+  VkRenderPass DxvkRenderPass::createRenderPass(
+    const DxvkRenderPassOps&    ops) {
+    const DxvkRenderPassFormat& fmt = m_format;
+    
     std::vector<VkAttachmentDescription> attachments;
     
     VkAttachmentReference                                  depthRef;
@@ -41,9 +78,9 @@ namespace dxvk {
       desc.flags          = 0;
       desc.format         = depthFmt.format;
       desc.samples        = fmt.getSampleCount();
-      desc.loadOp         = VK_ATTACHMENT_LOAD_OP_LOAD;
+      desc.loadOp         = ops.depthLoadOp;
       desc.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
-      desc.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_LOAD;
+      desc.stencilLoadOp  = ops.stencilLoadOp;
       desc.stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE;
       desc.initialLayout  = depthFmt.initialLayout;
       desc.finalLayout    = depthFmt.finalLayout;
@@ -65,7 +102,7 @@ namespace dxvk {
         desc.flags            = 0;
         desc.format           = colorFmt.format;
         desc.samples          = fmt.getSampleCount();
-        desc.loadOp           = VK_ATTACHMENT_LOAD_OP_LOAD;
+        desc.loadOp           = ops.colorLoadOps.at(i);
         desc.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;
         desc.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         desc.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;
@@ -139,14 +176,12 @@ namespace dxvk {
     info.dependencyCount              = subpassDeps.size();
     info.pDependencies                = subpassDeps.data();
     
-    if (m_vkd->vkCreateRenderPass(m_vkd->device(), &info, nullptr, &m_renderPass) != VK_SUCCESS)
-      throw DxvkError("DxvkRenderPass::DxvkRenderPass: Failed to create render pass object");
-  }
-  
-  
-  DxvkRenderPass::~DxvkRenderPass() {
-    m_vkd->vkDestroyRenderPass(
-      m_vkd->device(), m_renderPass, nullptr);
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    
+    if (m_vkd->vkCreateRenderPass(m_vkd->device(), &info, nullptr, &renderPass) != VK_SUCCESS)
+      throw DxvkError("DxvkRenderPass::createRenderPass: Failed to create render pass object");
+    
+    return renderPass;
   }
   
   
@@ -181,6 +216,19 @@ namespace dxvk {
   }
   
   
+  Rc<DxvkRenderPass> DxvkRenderPassPool::findRenderPass(
+          VkRenderPass          handle) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    for (const auto& renderPass : m_renderPasses) {
+      if (renderPass->handle() == handle)
+        return renderPass;
+    }
+    
+    return nullptr;
+  }
+  
+  
   Rc<DxvkRenderPass> DxvkRenderPassPool::createRenderPass(
     const DxvkRenderPassFormat& fmt) {
     return new DxvkRenderPass(m_vkd, fmt);
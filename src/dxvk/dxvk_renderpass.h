@@ -109,11 +109,43 @@ namespace dxvk {
   };
   
   
+  /**
+   * \brief Render pass load ops
+   * 
+   * Defines how the contents of each attachment are
+   * initialized when the render pass begins. Render
+   * passes which only differ in their load ops are
+   * compatible, so pipelines and framebuffers created
+   * for one of them can be used with any other.
+   */
+  struct DxvkRenderPassOps {
+    DxvkRenderPassOps() {
+      colorLoadOps.fill(VK_ATTACHMENT_LOAD_OP_LOAD);
+    }
+    
+    VkAttachmentLoadOp depthLoadOp   = VK_ATTACHMENT_LOAD_OP_LOAD;
+    VkAttachmentLoadOp stencilLoadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    
+    std::array<VkAttachmentLoadOp, MaxNumRenderTargets> colorLoadOps;
+    
+    bool operator == (const DxvkRenderPassOps& other) const {
+      return depthLoadOp   == other.depthLoadOp
+          && stencilLoadOp == other.stencilLoadOp
+          && colorLoadOps  == other.colorLoadOps;
+    }
+    
+    bool operator != (const DxvkRenderPassOps& other) const {
+      return !this->operator == (other);
+    }
+  };
+  
+  
   /**
    * \brief DXVK render pass
    * 
    * Render pass objects are used internally to identify render
-   * target formats and 
+   * target formats and create compatible pipelines. Variants
+   * with different load ops are created on demand.
    */
   class DxvkRenderPass : public RcObject {
     
@@ -127,13 +159,33 @@ namespace dxvk {
     /**
      * \brief Render pass handle
      * 
-     * Internal use only.
+     * The default render pass loads and stores the
+     * contents of all attachments. This handle must
+     * be used to create pipelines and framebuffers.
      * \returns Render pass handle
      */
     VkRenderPass handle() const {
       return m_renderPass;
     }
     
+    /**
+     * \brief Render pass handle for the given load ops
+     * 
+     * Creates a compatible render pass variant if
+     * one does not exist yet for the given ops.
+     * \param [in] ops Attachment load ops
+     * \returns Render pass handle
+     */
+    VkRenderPass handle(const DxvkRenderPassOps& ops);
+    
+    /**
+     * \brief Render pass format
+     * \returns Render target formats
+     */
+    const DxvkRenderPassFormat& format() const {
+      return m_format;
+    }
+    
     /**
      * \brief Render pass sample count
      * \returns Render pass sample count
@@ -161,6 +213,12 @@ namespace dxvk {
     DxvkRenderPassFormat  m_format;
     VkRenderPass          m_renderPass;
     
+    std::mutex                                            m_mutex;
+    std::vector<std::pair<DxvkRenderPassOps, VkRenderPass>> m_variants;
+    
+    VkRenderPass createRenderPass(
+      const DxvkRenderPassOps&    ops);
+    
   };
   
   
@@ -186,6 +244,17 @@ namespace dxvk {
     Rc<DxvkRenderPass> getRenderPass(
       const DxvkRenderPassFormat& fmt);
     
+    /**
+     * \brief Looks up a render pass by its handle
+     * 
+     * Only finds render passes by the handle that is
+     * used to create pipelines, not by any variant.
+     * \param [in] handle Default render pass handle
+     * \returns Render pass object, or \c nullptr
+     */
+    Rc<DxvkRenderPass> findRenderPass(
+            VkRenderPass          handle);
+    
   private:
     
     Rc<vk::DeviceFn> m_vkd;
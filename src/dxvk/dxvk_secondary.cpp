@@ -0,0 +1,29 @@
+#include "dxvk_device.h"
+#include "dxvk_secondary.h"
+
+namespace dxvk {
+  
+  DxvkSecondaryCommands::DxvkSecondaryCommands(
+    const Rc<DxvkDevice>& device)
+  : m_device(device) {
+    
+  }
+  
+  
+  DxvkSecondaryCommands::~DxvkSecondaryCommands() {
+    // Slices that never became the buffer's backing
+    // storage are not owned by anyone else
+    if (!renamesApplied) {
+      for (const auto& rename : bufferRenames)
+        rename.buffer->freePhysicalSlice(rename.slice);
+    }
+    
+    for (const auto& segment : segments) {
+      if (segment.cmdList != nullptr) {
+        segment.cmdList->reset();
+        m_device->recycleSecondaryCommandList(segment.cmdList);
+      }
+    }
+  }
+  
+}
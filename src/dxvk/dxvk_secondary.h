@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+
+#include "dxvk_buffer.h"
+#include "dxvk_cmdlist.h"
+#include "dxvk_framebuffer.h"
+
+namespace dxvk {
+  
+  class DxvkDevice;
+  
+  /**
+   * \brief Secondary command buffer segment
+   * 
+   * Stores one render pass instance recorded into a
+   * secondary command list. The render pass itself is
+   * begun by the primary command list, using the load
+   * operations and clear values stored here.
+   */
+  struct DxvkSecondarySegment {
+    Rc<DxvkFramebuffer> framebuffer;
+    DxvkRenderPassOps   renderPassOps;
+    
+    std::array<VkClearValue, MaxNumRenderTargets> colorClearValues = { };
+    VkClearValue                                  depthClearValue  = { };
+    
+    Rc<DxvkCommandList> cmdList;
+  };
+  
+  
+  /**
+   * \brief Buffer slice used by secondary commands
+   * 
+   * Recorded commands reference physical buffer slices
+   * directly, so the buffer must still be backed by the
+   * same slice when the commands are executed.
+   */
+  struct DxvkSecondaryBufferSlice {
+    Rc<DxvkBuffer>          buffer;
+    DxvkPhysicalBufferSlice slice;
+  };
+  
+  
+  /**
+   * \brief Secondary commands
+   * 
+   * Commands recorded by a context in secondary mode.
+   * Buffer invalidations are not applied during recording,
+   * but are stored so that the context executing the
+   * commands can apply them in the same order.
+   * 
+   * Primary command lists track this object as a resource
+   * when executing the commands. Once the last reference
+   * is gone, no command list can still be executing the
+   * secondary command lists, so they get recycled.
+   */
+  class DxvkSecondaryCommands : public DxvkResource {
+    
+  public:
+    
+    DxvkSecondaryCommands(
+      const Rc<DxvkDevice>& device);
+    
+    ~DxvkSecondaryCommands();
+    
+    /// Render pass instances, in submission order
+    std::vector<DxvkSecondarySegment>     segments;
+    
+    /// Buffer slices used before being invalidated
+    std::vector<DxvkSecondaryBufferSlice> bufferSlices;
+    
+    /// Buffer invalidations, in submission order
+    std::vector<DxvkSecondaryBufferSlice> bufferRenames;
+    
+    /// Whether the invalidations have been applied
+    bool                                  renamesApplied = false;
+    
+  private:
+    
+    Rc<DxvkDevice> m_device;
+    
+  };
+  
+}
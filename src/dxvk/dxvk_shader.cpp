@@ -4,10 +4,12 @@ namespace dxvk {
   
   DxvkShaderModule::DxvkShaderModule(
     const Rc<vk::DeviceFn>&     vkd,
+    const Rc<DxvkShaderModuleCounters>& counters,
           VkShaderStageFlagBits stage,
     const SpirvCodeBuffer&      code,
     const std::string&          name)
-  : m_vkd(vkd), m_stage(stage), m_debugName(name) {
+  : m_vkd(vkd), m_counters(counters), m_stage(stage),
+    m_codeSize(code.size()), m_debugName(name) {
     VkShaderModuleCreateInfo info;
     info.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
     info.pNext    = nullptr;
@@ -18,12 +20,16 @@ namespace dxvk {
     if (m_vkd->vkCreateShaderModule(m_vkd->device(),
           &info, nullptr, &m_module) != VK_SUCCESS)
       throw DxvkError("DxvkComputePipeline::DxvkComputePipeline: Failed to create shader module");
+    
+    m_counters->addModule(m_codeSize);
   }
   
   
   DxvkShaderModule::~DxvkShaderModule() {
     m_vkd->vkDestroyShaderModule(
       m_vkd->device(), m_module, nullptr);
+    
+    m_counters->removeModule(m_codeSize);
   }
   
   
@@ -89,15 +95,34 @@ namespace dxvk {
   
   Rc<DxvkShaderModule> DxvkShader::createShaderModule(
     const Rc<vk::DeviceFn>&          vkd,
+    const Rc<DxvkShaderModuleCounters>& counters,
     const DxvkDescriptorSlotMapping& mapping) const {
-    SpirvCodeBuffer spirvCode = m_code;
+    // The module only depends on the binding IDs that
+    // the shader's resource slots get mapped to
+    std::vector<uint32_t> bindingIds(m_idOffsets.size());
+    
+    for (size_t i = 0; i < m_idOffsets.size(); i++)
+      bindingIds[i] = mapping.getBindingId(m_code.data()[m_idOffsets[i]]);
+    
+    std::lock_guard<std::mutex> lock(m_moduleLock);
+    
+    for (const ModuleEntry& entry : m_modules) {
+      if (entry.bindingIds == bindingIds)
+        return entry.module;
+    }
     
     // Remap resource binding IDs
+    SpirvCodeBuffer spirvCode = m_code;
+    
     uint32_t* code = spirvCode.data();
-    for (uint32_t ofs : m_idOffsets)
-      code[ofs] = mapping.getBindingId(code[ofs]);
+    for (size_t i = 0; i < m_idOffsets.size(); i++)
+      code[m_idOffsets[i]] = bindingIds[i];
     
-    return new DxvkShaderModule(vkd, m_stage, spirvCode, m_debugName);
+    Rc<DxvkShaderModule> module = new DxvkShaderModule(
+      vkd, counters, m_stage, spirvCode, m_debugName);
+    
+    m_modules.push_back({ std::move(bindingIds), module });
+    return module;
   }
   
   
@@ -108,6 +133,10 @@ namespace dxvk {
   
   void DxvkShader::read(std::istream& inputStream) {
     m_code = SpirvCodeBuffer(inputStream);
+    
+    // Modules created from the old code are stale
+    std::lock_guard<std::mutex> lock(m_moduleLock);
+    m_modules.clear();
   }
   
 }
\ No newline at end of file
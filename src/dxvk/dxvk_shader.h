@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 #include "dxvk_include.h"
@@ -7,6 +9,8 @@
 
 #include "../spirv/spirv_code_buffer.h"
 
+#include "../util/sha1/sha1_util.h"
+
 namespace dxvk {
   
   /**
@@ -22,6 +26,66 @@ namespace dxvk {
   };
   
   
+  /**
+   * \brief Shader module statistics
+   * 
+   * Number of shader modules that currently exist,
+   * and the total size of their SPIR-V code, in bytes.
+   */
+  struct DxvkShaderModuleStats {
+    uint32_t moduleCount;
+    uint32_t codeSize;
+  };
+  
+  
+  /**
+   * \brief Shader module counters
+   * 
+   * Tracks the shader modules created on one
+   * device. Modules keep a reference to the
+   * counters since they can outlive the device.
+   */
+  class DxvkShaderModuleCounters : public RcObject {
+    
+  public:
+    
+    /**
+     * \brief Registers a shader module
+     * \param [in] codeSize Size of the module's code
+     */
+    void addModule(uint32_t codeSize) {
+      m_moduleCount += 1;
+      m_codeSize    += codeSize;
+    }
+    
+    /**
+     * \brief Unregisters a shader module
+     * \param [in] codeSize Size of the module's code
+     */
+    void removeModule(uint32_t codeSize) {
+      m_moduleCount -= 1;
+      m_codeSize    -= codeSize;
+    }
+    
+    /**
+     * \brief Queries shader module statistics
+     * \returns Shader module statistics
+     */
+    DxvkShaderModuleStats getStats() const {
+      DxvkShaderModuleStats result;
+      result.moduleCount = m_moduleCount.load();
+      result.codeSize    = m_codeSize.load();
+      return result;
+    }
+    
+  private:
+    
+    std::atomic<uint32_t> m_moduleCount = { 0u };
+    std::atomic<uint32_t> m_codeSize    = { 0u };
+    
+  };
+  
+  
   /**
    * \brief Shader module object
    * 
@@ -36,6 +100,7 @@ namespace dxvk {
     
     DxvkShaderModule(
       const Rc<vk::DeviceFn>&     vkd,
+      const Rc<DxvkShaderModuleCounters>& counters,
             VkShaderStageFlagBits stage,
       const SpirvCodeBuffer&      code,
       const std::string&          name);
@@ -70,8 +135,10 @@ namespace dxvk {
   private:
     
     Rc<vk::DeviceFn>      m_vkd;
+    Rc<DxvkShaderModuleCounters> m_counters;
     VkShaderStageFlagBits m_stage;
     VkShaderModule        m_module;
+    uint32_t              m_codeSize;
     std::string           m_debugName;
     
   };
@@ -123,13 +190,19 @@ namespace dxvk {
     /**
      * \brief Creates a shader module
      * 
-     * Maps the binding slot numbers 
+     * Maps the binding slot numbers to the binding IDs
+     * of the given mapping. Modules are cached by the
+     * binding IDs that are actually used by the shader,
+     * so that pipelines with the same bindings for this
+     * shader share a single module. This is thread-safe.
      * \param [in] vkd Vulkan device functions
+     * \param [in] counters Device's shader module counters
      * \param [in] mapping Resource slot mapping
      * \returns The shader module
      */
     Rc<DxvkShaderModule> createShaderModule(
       const Rc<vk::DeviceFn>&          vkd,
+      const Rc<DxvkShaderModuleCounters>& counters,
       const DxvkDescriptorSlotMapping& mapping) const;
     
     /**
@@ -170,8 +243,46 @@ namespace dxvk {
       m_debugName = name;
     }
     
+    /**
+     * \brief Checks whether the shader has a key
+     * \returns \c true if a shader key has been set
+     */
+    bool hasShaderKey() const {
+      return m_hasShaderKey;
+    }
+    
+    /**
+     * \brief Shader key
+     * 
+     * Identifies the shader across multiple runs
+     * of the application. Only valid if a key has
+     * been set via \ref setShaderKey.
+     * \returns Shader key
+     */
+    const Sha1Hash& shaderKey() const {
+      return m_shaderKey;
+    }
+    
+    /**
+     * \brief Sets the shader key
+     * 
+     * Shaders with a key can be used by the state cache.
+     * The key must be derived from the shader's original
+     * code, e.g. the SHA-1 hash of the DXBC bytecode.
+     * \param [in] key The shader's key
+     */
+    void setShaderKey(const Sha1Hash& key) {
+      m_shaderKey    = key;
+      m_hasShaderKey = true;
+    }
+    
   private:
     
+    struct ModuleEntry {
+      std::vector<uint32_t> bindingIds;
+      Rc<DxvkShaderModule>  module;
+    };
+    
     VkShaderStageFlagBits m_stage;
     SpirvCodeBuffer       m_code;
     
@@ -180,6 +291,12 @@ namespace dxvk {
     DxvkInterfaceSlots            m_interface;
     std::string                   m_debugName;
     
+    Sha1Hash                      m_shaderKey;
+    bool                          m_hasShaderKey = false;
+    
+    mutable std::mutex               m_moduleLock;
+    mutable std::vector<ModuleEntry> m_modules;
+    
   };
   
 }
\ No newline at end of file
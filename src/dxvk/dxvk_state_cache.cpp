@@ -0,0 +1,369 @@
+#include <cstring>
+
+#include "dxvk_pipemanager.h"
+#include "dxvk_state_cache.h"
+
+namespace dxvk {
+  
+  bool DxvkStateCacheEntry::operator == (const DxvkStateCacheEntry& other) const {
+    return std::memcmp(this, &other, sizeof(DxvkStateCacheEntry)) == 0;
+  }
+  
+  
+  size_t DxvkStateCacheEntry::hash() const {
+    DxvkHashState result;
+    
+    const uint32_t* data = reinterpret_cast<const uint32_t*>(this);
+    
+    for (size_t i = 0; i < sizeof(DxvkStateCacheEntry) / sizeof(uint32_t); i++)
+      result.add(data[i]);
+    
+    return result;
+  }
+  
+  
+  size_t DxvkStateCacheShaderHash::operator () (const Sha1Hash& key) const {
+    size_t result;
+    std::memcpy(&result, key.digest(), sizeof(result));
+    return result;
+  }
+  
+  
+  DxvkStateCache::DxvkStateCache(
+          DxvkPipelineManager*  pipeManager,
+          DxvkRenderPassPool*   passManager,
+    const Rc<DxvkPipelineCache>& pipeCache)
+  : m_pipeManager (pipeManager),
+    m_passManager (passManager),
+    m_pipeCache   (pipeCache),
+    m_enabled     (env::getEnvVar(L"DXVK_STATE_CACHE") != "0"),
+    m_fileName    (getCacheFileName()) {
+    if (!m_enabled)
+      return;
+    
+    this->readCacheFile();
+    
+    // Use half of the available cores so that the pipelines
+    // the application needs right now are not held up
+    const uint32_t workerCount = std::max(1u,
+      std::thread::hardware_concurrency() / 2);
+    
+    for (uint32_t i = 0; i < workerCount; i++)
+      m_workerThreads.emplace_back([this] () { workerFunc(); });
+    
+    m_writerThread = std::thread([this] () { writerFunc(); });
+  }
+  
+  
+  DxvkStateCache::~DxvkStateCache() {
+    if (!m_enabled)
+      return;
+    
+    { std::lock_guard<std::mutex> workerLock(m_workerLock);
+      std::lock_guard<std::mutex> writerLock(m_writerLock);
+      m_stopThreads.store(true);
+    }
+    
+    m_workerCond.notify_all();
+    m_writerCond.notify_all();
+    
+    for (auto& thread : m_workerThreads)
+      thread.join();
+    
+    m_writerThread.join();
+  }
+  
+  
+  void DxvkStateCache::addGraphicsPipeline(
+    const DxvkGraphicsPipelineShaders&    shaders,
+    const DxvkGraphicsPipelineStateInfo&  state) {
+    if (!m_enabled)
+      return;
+    
+    DxvkStateCacheEntry entry;
+    
+    if (!getShaderKey(shaders.vs,  entry.shaders.vs)
+     || !getShaderKey(shaders.tcs, entry.shaders.tcs)
+     || !getShaderKey(shaders.tes, entry.shaders.tes)
+     || !getShaderKey(shaders.gs,  entry.shaders.gs)
+     || !getShaderKey(shaders.fs,  entry.shaders.fs))
+      return;
+    
+    Rc<DxvkRenderPass> renderPass = m_passManager->findRenderPass(state.omRenderPass);
+    
+    if (renderPass == nullptr)
+      return;
+    
+    entry.format = renderPass->format();
+    entry.state  = state;
+    entry.state.omRenderPass = VK_NULL_HANDLE;
+    
+    { std::lock_guard<std::mutex> lock(m_entryLock);
+      
+      if (!m_entrySet.insert(entry).second)
+        return;
+    }
+    
+    { std::lock_guard<std::mutex> lock(m_writerLock);
+      m_writerQueue.push(entry);
+    }
+    
+    m_writerCond.notify_one();
+  }
+  
+  
+  void DxvkStateCache::registerShader(
+    const Rc<DxvkShader>&                 shader) {
+    if (!m_enabled || shader == nullptr || !shader->hasShaderKey())
+      return;
+    
+    const Sha1Hash& key = shader->shaderKey();
+    
+    std::vector<size_t> entryIds;
+    
+    { std::lock_guard<std::mutex> lock(m_entryLock);
+      
+      if (!m_shaders.insert({ key, shader }).second)
+        return;
+      
+      // Compile all pipelines that use this shader, provided
+      // that all other shaders have already been registered
+      auto entries = m_shaderEntries.equal_range(key);
+      
+      for (auto e = entries.first; e != entries.second; e++) {
+        const DxvkStateCacheEntry& entry = m_entries[e->second];
+        
+        Rc<DxvkShader> s;
+        
+        if (getShader(entry.shaders.vs,  s)
+         && getShader(entry.shaders.tcs, s)
+         && getShader(entry.shaders.tes, s)
+         && getShader(entry.shaders.gs,  s)
+         && getShader(entry.shaders.fs,  s))
+          entryIds.push_back(e->second);
+      }
+    }
+    
+    if (entryIds.size() == 0)
+      return;
+    
+    { std::lock_guard<std::mutex> lock(m_workerLock);
+      
+      for (size_t id : entryIds)
+        m_workerQueue.push(id);
+    }
+    
+    m_workerCond.notify_all();
+  }
+  
+  
+  void DxvkStateCache::readCacheFile() {
+    std::ifstream file(m_fileName, std::ios_base::binary);
+    
+    if (!file)
+      return;
+    
+    DxvkStateCacheHeader expected;
+    DxvkStateCacheHeader header;
+    
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+     || std::memcmp(header.magic, expected.magic, sizeof(header.magic))
+     || header.version   != expected.version
+     || header.entrySize != expected.entrySize) {
+      Logger::warn(str::format("DxvkStateCache: ", m_fileName, " is invalid or out of date"));
+      return;
+    }
+    
+    DxvkStateCacheEntry entry;
+    
+    while (file.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+      if (!m_entrySet.insert(entry).second)
+        continue;
+      
+      const size_t entryId = m_entries.size();
+      m_entries.push_back(entry);
+      
+      for (const Sha1Hash* key : {
+          &entry.shaders.vs, &entry.shaders.tcs, &entry.shaders.tes,
+          &entry.shaders.gs, &entry.shaders.fs }) {
+        if (!(*key == Sha1Hash(Sha1Digest())))
+          m_shaderEntries.insert({ *key, entryId });
+      }
+    }
+    
+    // If the last entry was only partially written, the
+    // file has to be rewritten before we can append to it
+    m_fileValid = file.gcount() == 0;
+    
+    Logger::info(str::format("DxvkStateCache: Read ",
+      m_entries.size(), " pipelines from ", m_fileName));
+  }
+  
+  
+  void DxvkStateCache::writeCacheEntry(
+          std::ofstream&        file,
+    const DxvkStateCacheEntry&  entry) {
+    file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+  }
+  
+  
+  bool DxvkStateCache::getShaderKey(
+    const Rc<DxvkShader>&       shader,
+          Sha1Hash&             key) const {
+    if (shader == nullptr) {
+      key = Sha1Hash(Sha1Digest());
+      return true;
+    }
+    
+    if (!shader->hasShaderKey())
+      return false;
+    
+    key = shader->shaderKey();
+    return true;
+  }
+  
+  
+  bool DxvkStateCache::getShader(
+    const Sha1Hash&             key,
+          Rc<DxvkShader>&       shader) const {
+    if (key == Sha1Hash(Sha1Digest())) {
+      shader = nullptr;
+      return true;
+    }
+    
+    auto entry = m_shaders.find(key);
+    
+    if (entry == m_shaders.end())
+      return false;
+    
+    shader = entry->second;
+    return true;
+  }
+  
+  
+  void DxvkStateCache::compilePipeline(
+          size_t                entryId) {
+    DxvkStateCacheEntry         entry;
+    DxvkGraphicsPipelineShaders shaders;
+    
+    { std::lock_guard<std::mutex> lock(m_entryLock);
+      entry = m_entries[entryId];
+      
+      getShader(entry.shaders.vs,  shaders.vs);
+      getShader(entry.shaders.tcs, shaders.tcs);
+      getShader(entry.shaders.tes, shaders.tes);
+      getShader(entry.shaders.gs,  shaders.gs);
+      getShader(entry.shaders.fs,  shaders.fs);
+    }
+    
+    Rc<DxvkGraphicsPipeline> pipeline = m_pipeManager->createGraphicsPipeline(
+      m_pipeCache, shaders.vs, shaders.tcs, shaders.tes, shaders.gs, shaders.fs);
+    
+    if (pipeline == nullptr)
+      return;
+    
+    Rc<DxvkRenderPass> renderPass = m_passManager->getRenderPass(entry.format);
+    
+    DxvkGraphicsPipelineStateInfo state = entry.state;
+    state.omRenderPass = renderPass->handle();
+    
+    DxvkStatCounters stats;
+    pipeline->getPipelineHandle(state, stats);
+  }
+  
+  
+  void DxvkStateCache::workerFunc() {
+    Profiler::setThreadName("dxvk-state-cache");
+    
+    while (!m_stopThreads.load()) {
+      size_t entryId;
+      
+      { std::unique_lock<std::mutex> lock(m_workerLock);
+        
+        m_workerCond.wait(lock, [this] {
+          return m_stopThreads.load() || m_workerQueue.size() != 0;
+        });
+        
+        if (m_workerQueue.size() == 0)
+          break;
+        
+        entryId = m_workerQueue.front();
+        m_workerQueue.pop();
+      }
+      
+      this->compilePipeline(entryId);
+    }
+  }
+  
+  
+  void DxvkStateCache::writerFunc() {
+    Profiler::setThreadName("dxvk-state-cache-writer");
+    
+    std::ofstream file;
+    bool          failed = false;
+    
+    // Entries are written even after the stop signal
+    // so that no pipelines are lost on shutdown
+    while (true) {
+      DxvkStateCacheEntry entry;
+      
+      { std::unique_lock<std::mutex> lock(m_writerLock);
+        
+        m_writerCond.wait(lock, [this] {
+          return m_stopThreads.load() || m_writerQueue.size() != 0;
+        });
+        
+        if (m_writerQueue.size() == 0)
+          break;
+        
+        entry = m_writerQueue.front();
+        m_writerQueue.pop();
+      }
+      
+      if (failed)
+        continue;
+      
+      if (!file.is_open()) {
+        if (m_fileValid) {
+          file.open(m_fileName, std::ios_base::binary | std::ios_base::app);
+        } else {
+          file.open(m_fileName, std::ios_base::binary | std::ios_base::trunc);
+          
+          DxvkStateCacheHeader header;
+          file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+          
+          // Entries are only read in the constructor,
+          // so we can access them without locking
+          for (const auto& e : m_entries)
+            this->writeCacheEntry(file, e);
+        }
+        
+        if (!file) {
+          Logger::err(str::format("DxvkStateCache: Failed to open ", m_fileName));
+          failed = true;
+          continue;
+        }
+      }
+      
+      this->writeCacheEntry(file, entry);
+      file.flush();
+    }
+  }
+  
+  
+  std::string DxvkStateCache::getCacheFileName() {
+    std::string path = env::getEnvVar(L"DXVK_STATE_CACHE_PATH");
+    
+    if (!path.empty() && *path.rbegin() != '/')
+      path += '/';
+    
+    std::string exeName = env::getExeName();
+    auto extp = exeName.find_last_of('.');
+    
+    if (extp != std::string::npos && exeName.substr(extp + 1) == "exe")
+      exeName.erase(extp);
+    
+    return path + exeName + ".dxvk-cache";
+  }
+  
+}
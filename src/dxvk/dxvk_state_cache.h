@@ -0,0 +1,193 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "dxvk_graphics.h"
+#include "dxvk_renderpass.h"
+
+namespace dxvk {
+  
+  class DxvkPipelineManager;
+  
+  /**
+   * \brief State cache shader keys
+   * 
+   * Identifies the shaders of a graphics pipeline
+   * by their shader keys. The keys of unused
+   * shader stages are all zeroes.
+   */
+  struct DxvkStateCacheKey {
+    Sha1Hash vs;
+    Sha1Hash tcs;
+    Sha1Hash tes;
+    Sha1Hash gs;
+    Sha1Hash fs;
+  };
+  
+  
+  /**
+   * \brief State cache entry
+   * 
+   * Stores everything that is needed to compile a
+   * graphics pipeline. The render pass is stored by
+   * its format, since handles are only valid for the
+   * lifetime of a device, and the render pass handle
+   * in the pipeline state is always null. Entries
+   * are written to the cache file as-is.
+   */
+  struct DxvkStateCacheEntry {
+    DxvkStateCacheKey             shaders;
+    DxvkRenderPassFormat          format;
+    DxvkGraphicsPipelineStateInfo state;
+    
+    bool operator == (const DxvkStateCacheEntry& other) const;
+    
+    size_t hash() const;
+  };
+  
+  
+  /**
+   * \brief State cache file header
+   * 
+   * The version must be incremented whenever the
+   * layout of the pipeline state changes. Files
+   * with a different version or entry size are
+   * discarded.
+   */
+  struct DxvkStateCacheHeader {
+    char     magic[4]   = { 'D', 'X', 'V', 'K' };
+    uint32_t version    = 1;
+    uint32_t entrySize  = sizeof(DxvkStateCacheEntry);
+  };
+  
+  
+  /**
+   * \brief Shader key hash
+   * 
+   * The shader keys are SHA-1 hashes, so
+   * we can use any part of the digest.
+   */
+  struct DxvkStateCacheShaderHash {
+    size_t operator () (const Sha1Hash& key) const;
+  };
+  
+  
+  /**
+   * \brief State cache
+   * 
+   * Records the shaders and pipeline state of every graphics
+   * pipeline compiled by the application to a file. On the
+   * next run, those pipelines are compiled on worker threads
+   * as soon as all their shaders are created, so that they
+   * are ready by the time the application first uses them.
+   * 
+   * Can be disabled by setting \c DXVK_STATE_CACHE to \c 0.
+   * The cache file is written to the directory specified by
+   * \c DXVK_STATE_CACHE_PATH, or the working directory.
+   */
+  class DxvkStateCache : public RcObject {
+    
+  public:
+    
+    DxvkStateCache(
+            DxvkPipelineManager*  pipeManager,
+            DxvkRenderPassPool*   passManager,
+      const Rc<DxvkPipelineCache>& pipeCache);
+    ~DxvkStateCache();
+    
+    /**
+     * \brief Adds a graphics pipeline to the cache
+     * 
+     * Called whenever a graphics pipeline has been compiled.
+     * If the pipeline is not already in the cache, it will be
+     * written to the cache file. Pipelines using shaders that
+     * do not have a shader key are ignored.
+     * \param [in] shaders The pipeline's shaders
+     * \param [in] state Pipeline state vector
+     */
+    void addGraphicsPipeline(
+      const DxvkGraphicsPipelineShaders&    shaders,
+      const DxvkGraphicsPipelineStateInfo&  state);
+    
+    /**
+     * \brief Registers a newly created shader
+     * 
+     * Makes the shader available to the state cache, and
+     * starts compiling all cached pipelines for which all
+     * shaders have been registered.
+     * \param [in] shader The shader object
+     */
+    void registerShader(
+      const Rc<DxvkShader>&                 shader);
+    
+  private:
+    
+    DxvkPipelineManager*          m_pipeManager;
+    DxvkRenderPassPool*           m_passManager;
+    Rc<DxvkPipelineCache>         m_pipeCache;
+    
+    bool                          m_enabled;
+    bool                          m_fileValid = false;
+    std::string                   m_fileName;
+    
+    std::atomic<bool>             m_stopThreads = { false };
+    
+    std::mutex                    m_entryLock;
+    std::vector<DxvkStateCacheEntry> m_entries;
+    
+    std::unordered_set<
+      DxvkStateCacheEntry,
+      DxvkHash>                   m_entrySet;
+    
+    std::unordered_map<
+      Sha1Hash, Rc<DxvkShader>,
+      DxvkStateCacheShaderHash>   m_shaders;
+    
+    std::unordered_multimap<
+      Sha1Hash, size_t,
+      DxvkStateCacheShaderHash>   m_shaderEntries;
+    
+    std::mutex                    m_workerLock;
+    std::condition_variable       m_workerCond;
+    std::queue<size_t>            m_workerQueue;
+    std::vector<std::thread>      m_workerThreads;
+    
+    std::mutex                    m_writerLock;
+    std::condition_variable       m_writerCond;
+    std::queue<DxvkStateCacheEntry> m_writerQueue;
+    std::thread                   m_writerThread;
+    
+    void readCacheFile();
+    
+    void writeCacheEntry(
+            std::ofstream&        file,
+      const DxvkStateCacheEntry&  entry);
+    
+    bool getShaderKey(
+      const Rc<DxvkShader>&       shader,
+            Sha1Hash&             key) const;
+    
+    bool getShader(
+      const Sha1Hash&             key,
+            Rc<DxvkShader>&       shader) const;
+    
+    void compilePipeline(
+            size_t                entryId);
+    
+    void workerFunc();
+    
+    void writerFunc();
+    
+    static std::string getCacheFileName();
+    
+  };
+  
+}
@@ -31,4 +31,26 @@ namespace dxvk {
       m_counters[i] = 0;
   }
   
+  
+  const char* DxvkStatCounters::getCtrName(DxvkStatCounter ctr) {
+    switch (ctr) {
+      case DxvkStatCounter::CmdDrawCalls:           return "CmdDrawCalls";
+      case DxvkStatCounter::CmdDispatchCalls:       return "CmdDispatchCalls";
+      case DxvkStatCounter::CmdRenderPassCount:     return "CmdRenderPassCount";
+      case DxvkStatCounter::MemoryAllocationCount:  return "MemoryAllocationCount";
+      case DxvkStatCounter::MemoryAllocated:        return "MemoryAllocated";
+      case DxvkStatCounter::MemoryUsed:             return "MemoryUsed";
+      case DxvkStatCounter::PipeCountGraphics:      return "PipeCountGraphics";
+      case DxvkStatCounter::PipeCountCompute:       return "PipeCountCompute";
+      case DxvkStatCounter::ShaderModuleCount:      return "ShaderModuleCount";
+      case DxvkStatCounter::ShaderModuleMemory:     return "ShaderModuleMemory";
+      case DxvkStatCounter::QueueSubmitCount:       return "QueueSubmitCount";
+      case DxvkStatCounter::QueuePresentCount:      return "QueuePresentCount";
+      case DxvkStatCounter::QueueSubmitLatency:     return "QueueSubmitLatency";
+      case DxvkStatCounter::QueueSubmitPending:     return "QueueSubmitPending";
+      case DxvkStatCounter::QueueAcquireTime:       return "QueueAcquireTime";
+      default:                                      return "Unknown";
+    }
+  }
+  
 }
@@ -19,8 +19,13 @@ namespace dxvk {
     MemoryUsed,               ///< Amount of memory used
     PipeCountGraphics,        ///< Number of graphics pipelines
     PipeCountCompute,         ///< Number of compute pipelines
+    ShaderModuleCount,        ///< Number of shader modules
+    ShaderModuleMemory,       ///< Size of shader module code
     QueueSubmitCount,         ///< Number of command buffer submissions
     QueuePresentCount,        ///< Number of present calls / frames
+    QueueSubmitLatency,       ///< Total submission latency, in microseconds
+    QueueSubmitPending,       ///< Number of pending submissions
+    QueueAcquireTime,         ///< Time spent acquiring swap images, in microseconds
     NumCounters,              ///< Number of counters available
   };
   
@@ -44,7 +49,7 @@ namespace dxvk {
      * \param [in] ctr The counter
      * \returns Counter value
      */
-    uint32_t getCtr(DxvkStatCounter ctr) const {
+    uint64_t getCtr(DxvkStatCounter ctr) const {
       return m_counters[uint32_t(ctr)];
     }
     
@@ -54,7 +59,7 @@ namespace dxvk {
      * \param [in] ctr The counter
      * \param [in] val Counter value
      */
-    void setCtr(DxvkStatCounter ctr, uint32_t val) {
+    void setCtr(DxvkStatCounter ctr, uint64_t val) {
       m_counters[uint32_t(ctr)] = val;
     }
     
@@ -64,7 +69,7 @@ namespace dxvk {
      * \param [in] ctr Counter to increment
      * \param [in] val Number to add to counter value
      */
-    void addCtr(DxvkStatCounter ctr, uint32_t val) {
+    void addCtr(DxvkStatCounter ctr, uint64_t val) {
       m_counters[uint32_t(ctr)] += val;
     }
     
@@ -101,9 +106,19 @@ namespace dxvk {
      */
     void reset();
     
+    /**
+     * \brief Retrieves counter name
+     * 
+     * Used to identify counters in exported
+     * statistics, e.g. \c "CmdDrawCalls".
+     * \param [in] ctr The counter
+     * \returns Counter name
+     */
+    static const char* getCtrName(DxvkStatCounter ctr);
+    
   private:
     
-    std::array<uint32_t, uint32_t(DxvkStatCounter::NumCounters)> m_counters;
+    std::array<uint64_t, uint32_t(DxvkStatCounter::NumCounters)> m_counters;
     
   };
   
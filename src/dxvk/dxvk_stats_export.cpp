@@ -0,0 +1,195 @@
+#include <cstring>
+
+#include "dxvk_stats_export.h"
+
+namespace dxvk {
+  
+  DxvkStatsExporter::DxvkStatsExporter()
+  : m_format    (getFormat()),
+    m_fileName  (getFileName(m_format)),
+    m_prevFrame (Clock::now()) {
+    if (!enabled())
+      return;
+    
+    Logger::info(str::format("DxvkStatsExporter: Writing stats to ", m_fileName));
+    m_thread = std::thread([this] () { writerFunc(); });
+  }
+  
+  
+  DxvkStatsExporter::~DxvkStatsExporter() {
+    if (!enabled())
+      return;
+    
+    { std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopped = true;
+    }
+    
+    m_cond.notify_one();
+    m_thread.join();
+  }
+  
+  
+  void DxvkStatsExporter::addFrame(
+    const DxvkStatCounters&     counters) {
+    if (!enabled())
+      return;
+    
+    const TimePoint now = Clock::now();
+    
+    { std::lock_guard<std::mutex> lock(m_mutex);
+      
+      // Keep the previous counters so that the changes
+      // end up in the next frame that does get written
+      if (m_frames.size() >= MaxQueuedFrames) {
+        m_dropCount += 1;
+        return;
+      }
+      
+      Frame frame;
+      frame.frameTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_prevFrame).count();
+      frame.counters  = counters.diff(m_prevCounters);
+      m_frames.push(frame);
+      
+      m_prevFrame    = now;
+      m_prevCounters = counters;
+    }
+    
+    m_cond.notify_one();
+  }
+  
+  
+  void DxvkStatsExporter::writerFunc() {
+    Profiler::setThreadName("dxvk-stats-export");
+    
+    std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+    
+    if (m_format == DxvkStatsExportFormat::Binary)
+      mode |= std::ios_base::binary;
+    
+    std::ofstream file(m_fileName, mode);
+    
+    if (!file)
+      Logger::err(str::format("DxvkStatsExporter: Failed to open ", m_fileName));
+    else
+      this->writeHeader(file);
+    
+    // Frames are written even after the stop
+    // signal so that the capture is complete
+    while (true) {
+      std::queue<Frame> frames;
+      uint64_t          dropCount;
+      
+      { std::unique_lock<std::mutex> lock(m_mutex);
+        
+        m_cond.wait(lock, [this] {
+          return m_stopped || m_frames.size() != 0;
+        });
+        
+        if (m_frames.size() == 0)
+          break;
+        
+        std::swap(frames, m_frames);
+        dropCount = std::exchange(m_dropCount, 0);
+      }
+      
+      if (dropCount != 0)
+        Logger::warn(str::format("DxvkStatsExporter: Dropped ", dropCount, " frames"));
+      
+      if (!file)
+        continue;
+      
+      while (frames.size() != 0) {
+        this->writeFrame(file, frames.front());
+        frames.pop();
+      }
+      
+      file.flush();
+    }
+  }
+  
+  
+  void DxvkStatsExporter::writeHeader(
+          std::ofstream&    file) {
+    constexpr uint32_t counterCount = uint32_t(DxvkStatCounter::NumCounters);
+    
+    if (m_format == DxvkStatsExportFormat::Csv) {
+      file << "FrameTime";
+      
+      for (uint32_t i = 0; i < counterCount; i++)
+        file << "," << DxvkStatCounters::getCtrName(DxvkStatCounter(i));
+      
+      file << std::endl;
+    } else {
+      DxvkStatsFileHeader header;
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      
+      for (uint32_t i = 0; i < counterCount; i++) {
+        DxvkStatsFileCounter counter = { };
+        std::strncpy(counter.name, DxvkStatCounters::getCtrName(DxvkStatCounter(i)), sizeof(counter.name) - 1);
+        file.write(reinterpret_cast<const char*>(&counter), sizeof(counter));
+      }
+    }
+  }
+  
+  
+  void DxvkStatsExporter::writeFrame(
+          std::ofstream&    file,
+    const Frame&            frame) {
+    constexpr uint32_t counterCount = uint32_t(DxvkStatCounter::NumCounters);
+    
+    if (m_format == DxvkStatsExportFormat::Csv) {
+      file << frame.frameTime;
+      
+      for (uint32_t i = 0; i < counterCount; i++)
+        file << "," << int64_t(frame.counters.getCtr(DxvkStatCounter(i)));
+      
+      file << "\n";
+    } else {
+      std::array<uint64_t, counterCount + 1> record;
+      record[0] = frame.frameTime;
+      
+      for (uint32_t i = 0; i < counterCount; i++)
+        record[i + 1] = frame.counters.getCtr(DxvkStatCounter(i));
+      
+      file.write(reinterpret_cast<const char*>(record.data()), sizeof(record));
+    }
+  }
+  
+  
+  DxvkStatsExportFormat DxvkStatsExporter::getFormat() {
+    const std::string format = env::getEnvVar(L"DXVK_STATS_EXPORT");
+    
+    if (format == "csv")
+      return DxvkStatsExportFormat::Csv;
+    
+    if (format == "binary")
+      return DxvkStatsExportFormat::Binary;
+    
+    if (!format.empty())
+      Logger::warn(str::format("DxvkStatsExporter: Unknown format: ", format));
+    
+    return DxvkStatsExportFormat::None;
+  }
+  
+  
+  std::string DxvkStatsExporter::getFileName(
+          DxvkStatsExportFormat format) {
+    if (format == DxvkStatsExportFormat::None)
+      return std::string();
+    
+    std::string path = env::getEnvVar(L"DXVK_STATS_EXPORT_PATH");
+    
+    if (!path.empty())
+      return path;
+    
+    std::string exeName = env::getExeName();
+    auto extp = exeName.find_last_of('.');
+    
+    if (extp != std::string::npos && exeName.substr(extp + 1) == "exe")
+      exeName.erase(extp);
+    
+    return exeName + (format == DxvkStatsExportFormat::Csv
+      ? "_stats.csv" : "_stats.dxvk-stats");
+  }
+  
+}
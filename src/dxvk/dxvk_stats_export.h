@@ -0,0 +1,138 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+#include "dxvk_stats.h"
+
+namespace dxvk {
+  
+  /**
+   * \brief Stats export format
+   */
+  enum class DxvkStatsExportFormat : uint32_t {
+    None,
+    Csv,
+    Binary,
+  };
+  
+  
+  /**
+   * \brief Binary stats file header
+   * 
+   * Followed by one \ref DxvkStatsFileCounter per
+   * counter, and then one record per frame. Each
+   * record consists of the frame time in nanoseconds
+   * and the change of each counter since the previous
+   * frame, all stored as 64-bit integers. Deltas of
+   * counters that can decrease, such as the amount of
+   * memory used, must be read as signed integers.
+   */
+  struct DxvkStatsFileHeader {
+    char     magic[4]     = { 'D', 'X', 'S', 'T' };
+    uint32_t version      = 1;
+    uint32_t counterCount = uint32_t(DxvkStatCounter::NumCounters);
+    uint32_t reserved     = 0;
+  };
+  
+  
+  /**
+   * \brief Binary stats file counter description
+   * 
+   * Stores the counter name, so that captures
+   * can be read without knowing which counters
+   * the DXVK version that wrote them had.
+   */
+  struct DxvkStatsFileCounter {
+    char name[32];
+  };
+  
+  
+  /**
+   * \brief Stats exporter
+   * 
+   * Writes the per-frame change of every stat counter,
+   * together with the frame time, to a file. Files are
+   * written on a background thread so that presenting
+   * a frame does not block on file I/O.
+   * 
+   * Enabled by setting \c DXVK_STATS_EXPORT to \c csv
+   * or \c binary. The file name can be specified with
+   * \c DXVK_STATS_EXPORT_PATH, and may be a named pipe
+   * in order to monitor a running application.
+   */
+  class DxvkStatsExporter {
+    constexpr static size_t MaxQueuedFrames = 1024;
+    
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = typename Clock::time_point;
+    
+    struct Frame {
+      uint64_t          frameTime;
+      DxvkStatCounters  counters;
+    };
+  public:
+    
+    DxvkStatsExporter();
+    ~DxvkStatsExporter();
+    
+    /**
+     * \brief Checks whether stats are exported
+     * \returns \c true if the exporter is enabled
+     */
+    bool enabled() const {
+      return m_format != DxvkStatsExportFormat::None;
+    }
+    
+    /**
+     * \brief Records a frame
+     * 
+     * Computes the difference between the given counters
+     * and the counters passed in for the previous frame,
+     * and queues it for the writer thread. If the writer
+     * falls behind, e.g. because nobody reads from the
+     * pipe, the frame is dropped and its counter changes
+     * are added to the next frame that can be queued.
+     * \param [in] counters Current counter values
+     */
+    void addFrame(
+      const DxvkStatCounters&     counters);
+    
+  private:
+    
+    const DxvkStatsExportFormat m_format;
+    
+    std::string             m_fileName;
+    
+    TimePoint               m_prevFrame;
+    DxvkStatCounters        m_prevCounters;
+    
+    bool                    m_stopped = false;
+    
+    std::mutex              m_mutex;
+    std::condition_variable m_cond;
+    std::queue<Frame>       m_frames;
+    uint64_t                m_dropCount = 0;
+    std::thread             m_thread;
+    
+    void writerFunc();
+    
+    void writeHeader(
+            std::ofstream&    file);
+    
+    void writeFrame(
+            std::ofstream&    file,
+      const Frame&            frame);
+    
+    static DxvkStatsExportFormat getFormat();
+    
+    static std::string getFileName(
+            DxvkStatsExportFormat format);
+    
+  };
+  
+}
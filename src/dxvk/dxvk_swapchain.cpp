@@ -1,3 +1,5 @@
+#include <chrono>
+
 #include "dxvk_main.h"
 
 #include "dxvk_device.h"
@@ -82,12 +84,20 @@ namespace dxvk {
   
   VkResult DxvkSwapchain::acquireNextImage(
     const Rc<DxvkSemaphore>& wakeSync) {
-    return m_vkd->vkAcquireNextImageKHR(
+    auto t0 = std::chrono::high_resolution_clock::now();
+    
+    VkResult status = m_vkd->vkAcquireNextImageKHR(
       m_vkd->device(), m_handle,
       std::numeric_limits<uint64_t>::max(),
       wakeSync->handle(),
       VK_NULL_HANDLE,
       &m_imageIndex);
+    
+    auto t1 = std::chrono::high_resolution_clock::now();
+    auto td = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0);
+    
+    m_device->addStatCtr(DxvkStatCounter::QueueAcquireTime, td.count());
+    return status;
   }
   
   
@@ -114,6 +124,12 @@ namespace dxvk {
     swapInfo.imageExtent            = m_surface->pickImageExtent(caps, m_properties.preferredBufferSize);
     swapInfo.imageArrayLayers       = 1;
     swapInfo.imageUsage             = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    
+    // Allow presenters to copy directly to the swap
+    // image, if the surface supports this at all
+    if (caps.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT)
+      swapInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    
     swapInfo.imageSharingMode       = VK_SHARING_MODE_EXCLUSIVE;
     swapInfo.queueFamilyIndexCount  = 0;
     swapInfo.pQueueFamilyIndices    = nullptr;
@@ -157,7 +173,7 @@ namespace dxvk {
     imageInfo.extent.depth  = 1;
     imageInfo.numLayers     = swapInfo.imageArrayLayers;
     imageInfo.mipLevels     = 1;
-    imageInfo.usage         = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    imageInfo.usage         = swapInfo.imageUsage;
     imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
     imageInfo.stages        = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
     imageInfo.access        = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT
@@ -165,6 +181,11 @@ namespace dxvk {
                             | VK_ACCESS_MEMORY_READ_BIT;
     imageInfo.layout        = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
     
+    if (imageInfo.usage & VK_IMAGE_USAGE_TRANSFER_DST_BIT) {
+      imageInfo.stages |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+      imageInfo.access |= VK_ACCESS_TRANSFER_WRITE_BIT;
+    }
+    
     DxvkImageViewCreateInfo viewInfo;
     viewInfo.type         = VK_IMAGE_VIEW_TYPE_2D;
     viewInfo.format       = fmt.format;
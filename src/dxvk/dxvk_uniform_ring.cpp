@@ -0,0 +1,113 @@
+#include "dxvk_device.h"
+#include "dxvk_uniform_ring.h"
+
+namespace dxvk {
+  
+  constexpr static VkBufferUsageFlags RingUsageFlags
+    = VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+    | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+    | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+  
+  
+  DxvkUniformRing::DxvkUniformRing(
+          DxvkDevice*           device,
+          VkMemoryPropertyFlags memFlags)
+  : m_device(device), m_memFlags(memFlags) {
+    
+  }
+  
+  
+  DxvkUniformRing::~DxvkUniformRing() {
+    
+  }
+  
+  
+  bool DxvkUniformRing::isCompatible(
+    const DxvkBufferCreateInfo& createInfo,
+          VkMemoryPropertyFlags memFlags) const {
+    return createInfo.renameHint == DxvkBufferRenameHint::Streaming
+        && createInfo.size <= MaxSliceSize
+        && (createInfo.usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+        && (createInfo.usage & ~RingUsageFlags) == 0
+        && memFlags == m_memFlags;
+  }
+  
+  
+  DxvkPhysicalBufferSlice DxvkUniformRing::alloc(VkDeviceSize length) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    const VkDeviceSize stride = align(length, SliceAlignment);
+    
+    if (m_offset + stride > ChunkSize) {
+      m_chunkId = this->nextChunk();
+      m_offset  = 0;
+    }
+    
+    Chunk& chunk = m_chunks[m_chunkId];
+    chunk.useCount += 1;
+    
+    DxvkPhysicalBufferSlice slice = chunk.buffer->slice(m_offset, length);
+    m_offset += stride;
+    return slice;
+  }
+  
+  
+  void DxvkUniformRing::free(const DxvkPhysicalBufferSlice& slice) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    const VkBuffer handle = slice.handle();
+    
+    uint32_t idleChunks = 0;
+    size_t   chunkId    = m_chunks.size();
+    
+    for (size_t i = 0; i < m_chunks.size(); i++) {
+      if (m_chunks[i].buffer->handle() == handle)
+        chunkId = i;
+      else if (m_chunks[i].useCount == 0)
+        idleChunks += 1;
+    }
+    
+    if (chunkId == m_chunks.size())
+      return;
+    
+    // Release the chunk if it is no longer needed and we
+    // already have enough idle chunks. The GPU may still
+    // be using it, but it is kept alive by command lists.
+    if (--m_chunks[chunkId].useCount == 0
+     && chunkId != m_chunkId
+     && idleChunks >= MaxIdleChunks) {
+      m_chunks.erase(m_chunks.begin() + chunkId);
+      
+      if (m_chunkId > chunkId)
+        m_chunkId -= 1;
+    }
+  }
+  
+  
+  size_t DxvkUniformRing::nextChunk() {
+    // Reuse a chunk that has no live slices left
+    // and has been fully consumed by the GPU
+    for (size_t i = 0; i < m_chunks.size(); i++) {
+      if (i != m_chunkId
+       && m_chunks[i].useCount == 0
+       && !m_chunks[i].buffer->isInUse())
+        return i;
+    }
+    
+    m_chunks.push_back({ this->createChunk(), 0 });
+    return m_chunks.size() - 1;
+  }
+  
+  
+  Rc<DxvkPhysicalBuffer> DxvkUniformRing::createChunk() const {
+    DxvkBufferCreateInfo info;
+    info.size   = ChunkSize;
+    info.usage  = RingUsageFlags;
+    info.stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    info.access = VK_ACCESS_TRANSFER_READ_BIT
+                | VK_ACCESS_TRANSFER_WRITE_BIT;
+    
+    return m_device->allocPhysicalBuffer(info, m_memFlags);
+  }
+  
+}
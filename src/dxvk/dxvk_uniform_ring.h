@@ -0,0 +1,107 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "dxvk_buffer_res.h"
+
+namespace dxvk {
+  
+  class DxvkDevice;
+  
+  /**
+   * \brief Uniform buffer ring
+   * 
+   * Sub-allocates backing slices for small uniform
+   * buffers that get invalidated very frequently from
+   * a set of large chunks which are shared by all such
+   * buffers on the device. Since consecutive slices
+   * share the same Vulkan buffer, renaming a buffer
+   * usually only changes the dynamic offset that is
+   * passed to \c vkCmdBindDescriptorSets.
+   * 
+   * Slices are allocated linearly from the current
+   * chunk. Chunks are reused once all of their slices
+   * have been freed and the GPU no longer uses them.
+   * Buffers that stop being renamed leave the ring, so
+   * that their last slice does not keep a chunk alive.
+   */
+  class DxvkUniformRing : public RcObject {
+    
+  public:
+    
+    /// Size of a single chunk, in bytes
+    constexpr static VkDeviceSize ChunkSize = 4 << 20;
+    
+    /// Maximum size of a buffer served by the ring
+    constexpr static VkDeviceSize MaxSliceSize = 65536;
+    
+    /// Alignment of individual slices
+    constexpr static VkDeviceSize SliceAlignment = 256;
+    
+    /// Number of idle chunks kept around for reuse
+    constexpr static uint32_t MaxIdleChunks = 2;
+    
+    DxvkUniformRing(
+            DxvkDevice*           device,
+            VkMemoryPropertyFlags memFlags);
+    
+    ~DxvkUniformRing();
+    
+    /**
+     * \brief Checks whether a buffer can use the ring
+     * 
+     * Only host-visible uniform buffers that are small
+     * enough and are expected to be invalidated many
+     * times per frame are allocated from the ring.
+     * \param [in] createInfo Buffer properties
+     * \param [in] memFlags Buffer memory flags
+     * \returns \c true if the ring can back the buffer
+     */
+    bool isCompatible(
+      const DxvkBufferCreateInfo& createInfo,
+            VkMemoryPropertyFlags memFlags) const;
+    
+    /**
+     * \brief Allocates a slice
+     * 
+     * \param [in] length Slice length, in bytes
+     * \returns The new slice
+     */
+    DxvkPhysicalBufferSlice alloc(
+            VkDeviceSize          length);
+    
+    /**
+     * \brief Frees a slice
+     * 
+     * The slice must not be used by the host anymore,
+     * but the GPU may still be using it. Slices that
+     * were not allocated from this ring are ignored.
+     * \param [in] slice The slice to free
+     */
+    void free(
+      const DxvkPhysicalBufferSlice& slice);
+    
+  private:
+    
+    struct Chunk {
+      Rc<DxvkPhysicalBuffer> buffer;
+      uint32_t               useCount;
+    };
+    
+    DxvkDevice*           m_device;
+    VkMemoryPropertyFlags m_memFlags;
+    
+    std::mutex            m_mutex;
+    std::vector<Chunk>    m_chunks;
+    
+    size_t       m_chunkId = 0;
+    VkDeviceSize m_offset  = ChunkSize;
+    
+    size_t nextChunk();
+    
+    Rc<DxvkPhysicalBuffer> createChunk() const;
+    
+  };
+  
+}
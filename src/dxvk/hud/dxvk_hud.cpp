@@ -34,6 +34,9 @@ namespace dxvk::hud {
     m_hudFps.update();
     m_hudStats.update(m_device);
     
+    if (m_config.elements.test(HudElement::Graphs))
+      m_hudGraphs.update(m_device);
+    
     this->beginRenderPass(recreateFbo);
     this->updateUniformBuffer();
     this->renderText();
@@ -79,8 +82,20 @@ namespace dxvk::hud {
         m_context, m_textRenderer, position);
     }
     
+    if (m_config.elements.test(HudElement::FrameTimes)) {
+      position = m_hudFps.renderFrameTimes(
+        m_context, m_textRenderer, position);
+    }
+    
     position = m_hudStats.renderText(
       m_context, m_textRenderer, position);
+    
+    if (m_config.elements.test(HudElement::Graphs)) {
+      position = m_hudGraphs.renderGraphs(
+        m_context, m_textRenderer, position);
+    }
+    
+    m_textRenderer.endFrame(m_context);
   }
   
   
@@ -7,6 +7,7 @@
 #include "dxvk_hud_config.h"
 #include "dxvk_hud_devinfo.h"
 #include "dxvk_hud_fps.h"
+#include "dxvk_hud_graphs.h"
 #include "dxvk_hud_text.h"
 #include "dxvk_hud_stats.h"
 
@@ -84,6 +85,7 @@ namespace dxvk::hud {
     
     HudDeviceInfo         m_hudDeviceInfo;
     HudFps                m_hudFps;
+    HudGraphs             m_hudGraphs;
     HudStats              m_hudStats;
     
     void renderText();
@@ -11,6 +11,9 @@ namespace dxvk::hud {
     { "submissions",  HudElement::StatSubmissions   },
     { "pipelines",    HudElement::StatPipelines     },
     { "memory",       HudElement::StatMemory        },
+    { "csstats",      HudElement::StatCsThread      },
+    { "frametimes",   HudElement::FrameTimes        },
+    { "graphs",       HudElement::Graphs            },
   }};
   
   
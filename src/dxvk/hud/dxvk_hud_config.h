@@ -17,6 +17,9 @@ namespace dxvk::hud {
     StatSubmissions   = 3,
     StatPipelines     = 4,
     StatMemory        = 5,
+    StatCsThread      = 6,
+    FrameTimes        = 7,
+    Graphs            = 8,
   };
   
   using HudElements = Flags<HudElement>;
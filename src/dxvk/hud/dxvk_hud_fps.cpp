@@ -5,8 +5,12 @@
 namespace dxvk::hud {
   
   HudFps::HudFps()
-  : m_fpsString("FPS: "),
-    m_prevUpdate(Clock::now()) {
+  : m_fpsString       ("FPS: "),
+    m_frameTimeString ("Frame time: "),
+    m_stutterString   ("Stutters: "),
+    m_prevUpdate      (Clock::now()),
+    m_prevFrame       (m_prevUpdate),
+    m_frameStats      (256) {
     
   }
   
@@ -22,10 +26,23 @@ namespace dxvk::hud {
     const TimePoint now = Clock::now();
     const TimeDiff elapsed = std::chrono::duration_cast<TimeDiff>(now - m_prevUpdate);
     
+    m_frameStats.addFrame(now - m_prevFrame);
+    m_prevFrame = now;
+    
     if (elapsed.count() >= UpdateInterval) {
       const int64_t fps = (10'000'000ll * m_frameCount) / elapsed.count();
       m_fpsString = str::format("FPS: ", fps / 10, ".", fps % 10);
       
+      const DxvkFrameTimeSummary summary = m_frameStats.getSummary();
+      const int64_t meanTime = int64_t(summary.meanMs * 10.0);
+      const int64_t p99Time  = int64_t(summary.p99Ms  * 10.0);
+      
+      m_frameTimeString = str::format("Frame time: ",
+        meanTime / 10, ".", meanTime % 10, " ms (p99: ",
+        p99Time  / 10, ".", p99Time  % 10, " ms)");
+      m_stutterString = str::format("Stutters: ",
+        summary.stutterCount, " / ", summary.frameCount);
+      
       m_prevUpdate = now;
       m_frameCount = 0;
     }
@@ -44,4 +61,22 @@ namespace dxvk::hud {
     return HudPos { position.x, position.y + 24 };
   }
   
+  
+  HudPos HudFps::renderFrameTimes(
+    const Rc<DxvkContext>&  context,
+          HudTextRenderer&  renderer,
+          HudPos            position) {
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      m_frameTimeString);
+    
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y + 20 },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      m_stutterString);
+    
+    return HudPos { position.x, position.y + 44 };
+  }
+  
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <chrono>
 
+#include "../dxvk_frame_stats.h"
+
 #include "dxvk_hud_text.h"
 
 namespace dxvk::hud {
@@ -9,11 +11,12 @@ namespace dxvk::hud {
   /**
    * \brief FPS display for the HUD
    * 
-   * Displays the current frames per second.
-   * TODO implement frame time info/graph.
+   * Displays the current frames per second, as
+   * well as frame time statistics over the most
+   * recent frames.
    */
   class HudFps {
-    using Clock     = std::chrono::high_resolution_clock;
+    using Clock     = std::chrono::steady_clock;
     using TimeDiff  = std::chrono::microseconds;
     using TimePoint = typename Clock::time_point;
     
@@ -30,13 +33,23 @@ namespace dxvk::hud {
             HudTextRenderer&  renderer,
             HudPos            position);
     
+    HudPos renderFrameTimes(
+      const Rc<DxvkContext>&  context,
+            HudTextRenderer&  renderer,
+            HudPos            position);
+    
   private:
     
     std::string m_fpsString;
+    std::string m_frameTimeString;
+    std::string m_stutterString;
     
     TimePoint m_prevUpdate;
+    TimePoint m_prevFrame;
     int64_t  m_frameCount = 0;
     
+    DxvkFrameStats m_frameStats;
+    
   };
   
 }
\ No newline at end of file
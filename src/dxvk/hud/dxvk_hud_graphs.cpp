@@ -0,0 +1,134 @@
+#include "dxvk_hud_graphs.h"
+
+namespace dxvk::hud {
+  
+  HudGraphs::HudGraphs()
+  : m_prevFrame(Clock::now()) {
+    m_graphs.emplace_back("Frame time",  " ms",  16.7f, HudColor { 0.0f, 1.0f, 0.0f, 1.0f });
+    m_graphs.emplace_back("CS load",     "%",   100.0f, HudColor { 1.0f, 0.5f, 0.0f, 1.0f });
+    m_graphs.emplace_back("Queue depth", "",      4.0f, HudColor { 0.0f, 0.5f, 1.0f, 1.0f });
+    m_graphs.emplace_back("Pipelines",   "",      4.0f, HudColor { 1.0f, 1.0f, 0.0f, 1.0f });
+    m_graphs.emplace_back("Allocated",   " MB",  16.0f, HudColor { 1.0f, 0.0f, 1.0f, 1.0f });
+  }
+  
+  
+  HudGraphs::~HudGraphs() {
+    
+  }
+  
+  
+  void HudGraphs::update(const Rc<DxvkDevice>& device) {
+    const TimePoint now = Clock::now();
+    const uint64_t frameTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_prevFrame).count();
+    m_prevFrame = now;
+    
+    DxvkStatCounters nextCounters = device->getStatCounters();
+    DxvkStatCounters diffCounters = nextCounters.diff(m_prevCounters);
+    
+    DxvkCsStatsData nextCsStats = device->csStats()->getData();
+    DxvkCsStatsData diffCsStats = nextCsStats.diff(m_prevCsStats);
+    
+    // The amount of allocated memory can shrink, in
+    // which case we do not count any new allocations
+    const int64_t memAllocated = int64_t(diffCounters.getCtr(DxvkStatCounter::MemoryAllocated));
+    
+    const uint64_t pipeCount
+      = diffCounters.getCtr(DxvkStatCounter::PipeCountGraphics)
+      + diffCounters.getCtr(DxvkStatCounter::PipeCountCompute);
+    
+    this->addSample(HudGraphType::FrameTime, float(frameTime) / 1000000.0f);
+    this->addSample(HudGraphType::CsLoad, 100.0f * float(diffCsStats.busyTime) / float(std::max<uint64_t>(frameTime, 1)));
+    this->addSample(HudGraphType::QueueDepth, float(nextCounters.getCtr(DxvkStatCounter::QueueSubmitPending)));
+    this->addSample(HudGraphType::Pipelines, float(pipeCount));
+    this->addSample(HudGraphType::Memory, float(std::max<int64_t>(memAllocated, 0)) / float(1024 * 1024));
+    
+    m_prevCounters = nextCounters;
+    m_prevCsStats  = std::move(nextCsStats);
+  }
+  
+  
+  HudPos HudGraphs::renderGraphs(
+    const Rc<DxvkContext>&  context,
+          HudTextRenderer&  renderer,
+          HudPos            position) {
+    for (const auto& graph : m_graphs)
+      position = this->renderGraph(context, renderer, graph, position);
+    
+    return position;
+  }
+  
+  
+  HudGraphs::HudGraph::HudGraph(
+    const char*           name,
+    const char*           unit,
+          float           minScale,
+          HudColor        color)
+  : name(name), unit(unit), minScale(minScale),
+    color(color), samples(SampleCount) {
+    
+  }
+  
+  
+  void HudGraphs::addSample(
+          HudGraphType      type,
+          float             value) {
+    m_graphs.at(uint32_t(type)).samples.push(value);
+  }
+  
+  
+  HudPos HudGraphs::renderGraph(
+    const Rc<DxvkContext>&  context,
+          HudTextRenderer&  renderer,
+    const HudGraph&         graph,
+          HudPos            position) {
+    constexpr float GraphWidth  = float(SampleCount);
+    constexpr float GraphHeight = 32.0f;
+    
+    const HudSampleSummary summary = graph.samples.getSummary();
+    
+    const std::string label = str::format(graph.name, ": ",
+      formatValue(summary.last), graph.unit, " (avg: ",
+      formatValue(summary.avg),  ", max: ",
+      formatValue(summary.max),  ")");
+    
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      label);
+    
+    // Scale the graph so that the largest value fits, but
+    // do not let small fluctuations fill the entire graph
+    const HudPos graphPos = { position.x, position.y + 8.0f };
+    const float  scale    = GraphHeight / std::max(summary.max, graph.minScale);
+    
+    renderer.drawRect(context, graphPos,
+      { GraphWidth, GraphHeight },
+      { 0.0f, 0.0f, 0.0f, 0.5f });
+    
+    // Samples are drawn from the right so that
+    // the newest sample is always at the edge
+    const size_t count = graph.samples.count();
+    
+    for (size_t i = 0; i < count; i++) {
+      const float value  = graph.samples.get(i);
+      const float height = std::min(value * scale, GraphHeight);
+      
+      if (height <= 0.0f)
+        continue;
+      
+      renderer.drawRect(context,
+        { graphPos.x + GraphWidth - float(count - i), graphPos.y + GraphHeight - height },
+        { 1.0f, height },
+        graph.color);
+    }
+    
+    return { position.x, graphPos.y + GraphHeight + 24.0f };
+  }
+  
+  
+  std::string HudGraphs::formatValue(float value) {
+    const int64_t fixed = int64_t(value * 10.0f + 0.5f);
+    return str::format(fixed / 10, ".", fixed % 10);
+  }
+  
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+
+#include "../dxvk_cs_stats.h"
+#include "../dxvk_stats.h"
+
+#include "dxvk_hud_samples.h"
+#include "dxvk_hud_text.h"
+
+namespace dxvk::hud {
+  
+  /**
+   * \brief Graph display for the HUD
+   * 
+   * Records one sample per frame for the frame time,
+   * CS thread load, submission queue depth, and the
+   * number of pipelines and amount of memory allocated
+   * in that frame, and draws each of them as a graph
+   * over the most recent frames.
+   */
+  class HudGraphs {
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = typename Clock::time_point;
+    
+    constexpr static size_t SampleCount = 256;
+  public:
+    
+    HudGraphs();
+    ~HudGraphs();
+    
+    void update(
+      const Rc<DxvkDevice>&   device);
+    
+    HudPos renderGraphs(
+      const Rc<DxvkContext>&  context,
+            HudTextRenderer&  renderer,
+            HudPos            position);
+    
+  private:
+    
+    enum class HudGraphType : uint32_t {
+      FrameTime,
+      CsLoad,
+      QueueDepth,
+      Pipelines,
+      Memory,
+      NumGraphs,
+    };
+    
+    struct HudGraph {
+      HudGraph(
+        const char*           name,
+        const char*           unit,
+              float           minScale,
+              HudColor        color);
+      
+      const char*     name;
+      const char*     unit;
+      float           minScale;
+      HudColor        color;
+      HudSampleBuffer samples;
+    };
+    
+    std::vector<HudGraph> m_graphs;
+    
+    TimePoint         m_prevFrame;
+    
+    DxvkStatCounters  m_prevCounters;
+    DxvkCsStatsData   m_prevCsStats;
+    
+    void addSample(
+            HudGraphType      type,
+            float             value);
+    
+    HudPos renderGraph(
+      const Rc<DxvkContext>&  context,
+            HudTextRenderer&  renderer,
+      const HudGraph&         graph,
+            HudPos            position);
+    
+    static std::string formatValue(float value);
+    
+  };
+  
+}
@@ -0,0 +1,67 @@
+#include <algorithm>
+
+#include "dxvk_hud_samples.h"
+
+namespace dxvk::hud {
+  
+  HudSampleBuffer::HudSampleBuffer(size_t capacity)
+  : m_samples(std::max<size_t>(capacity, 1), 0.0f) {
+    
+  }
+  
+  
+  HudSampleBuffer::~HudSampleBuffer() {
+    
+  }
+  
+  
+  float HudSampleBuffer::get(size_t index) const {
+    if (index >= m_count)
+      return 0.0f;
+    
+    // The oldest sample is the one that will be overwritten
+    // next, unless the buffer has not been filled yet
+    const size_t first = m_count < m_samples.size() ? 0 : m_next;
+    return m_samples[(first + index) % m_samples.size()];
+  }
+  
+  
+  void HudSampleBuffer::push(float value) {
+    m_samples[m_next] = value;
+    m_next  = (m_next + 1) % m_samples.size();
+    m_count = std::min(m_count + 1, m_samples.size());
+  }
+  
+  
+  void HudSampleBuffer::clear() {
+    m_next  = 0;
+    m_count = 0;
+  }
+  
+  
+  HudSampleSummary HudSampleBuffer::getSummary() const {
+    HudSampleSummary result;
+    
+    if (m_count == 0)
+      return result;
+    
+    result.count = uint32_t(m_count);
+    result.min   = this->get(0);
+    result.max   = this->get(0);
+    result.last  = this->get(m_count - 1);
+    
+    double sum = 0.0;
+    
+    for (size_t i = 0; i < m_count; i++) {
+      const float value = m_samples[i];
+      
+      result.min = std::min(result.min, value);
+      result.max = std::max(result.max, value);
+      sum += value;
+    }
+    
+    result.avg = float(sum / double(m_count));
+    return result;
+  }
+  
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+
+#include "../dxvk_include.h"
+
+namespace dxvk::hud {
+  
+  /**
+   * \brief Sample summary
+   * 
+   * Aggregated values over all samples that
+   * are currently stored in a sample buffer.
+   * All values are zero if there are none.
+   */
+  struct HudSampleSummary {
+    uint32_t count = 0;
+    float    min   = 0.0f;
+    float    max   = 0.0f;
+    float    avg   = 0.0f;
+    float    last  = 0.0f;
+  };
+  
+  
+  /**
+   * \brief Per-frame sample buffer
+   * 
+   * Ring buffer that stores one value per frame
+   * for a fixed number of frames. Once the buffer
+   * is full, new samples replace the oldest ones.
+   * Does not depend on any device state, so that
+   * it can be used and tested on its own.
+   */
+  class HudSampleBuffer {
+    
+  public:
+    
+    /**
+     * \brief Creates a sample buffer
+     * \param [in] capacity Maximum number of samples
+     */
+    HudSampleBuffer(size_t capacity);
+    ~HudSampleBuffer();
+    
+    /**
+     * \brief Maximum number of samples
+     * \returns Sample buffer capacity
+     */
+    size_t capacity() const {
+      return m_samples.size();
+    }
+    
+    /**
+     * \brief Number of stored samples
+     * \returns Sample count
+     */
+    size_t count() const {
+      return m_count;
+    }
+    
+    /**
+     * \brief Retrieves a sample
+     * 
+     * \param [in] index Sample index, where
+     *        \c 0 is the oldest stored sample
+     * \returns Sample value
+     */
+    float get(size_t index) const;
+    
+    /**
+     * \brief Adds a sample
+     * 
+     * Replaces the oldest sample if the buffer is full.
+     * \param [in] value Sample value
+     */
+    void push(float value);
+    
+    /**
+     * \brief Removes all samples
+     */
+    void clear();
+    
+    /**
+     * \brief Computes summary of all samples
+     * \returns Minimum, maximum and average
+     */
+    HudSampleSummary getSummary() const;
+    
+  private:
+    
+    std::vector<float> m_samples;
+    
+    size_t m_next  = 0;
+    size_t m_count = 0;
+    
+  };
+  
+}
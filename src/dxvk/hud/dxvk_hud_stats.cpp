@@ -20,6 +20,12 @@ namespace dxvk::hud {
     DxvkStatCounters nextCounters = device->getStatCounters();
     m_diffCounters = nextCounters.diff(m_prevCounters);
     m_prevCounters = nextCounters;
+    
+    if (m_elements.test(HudElement::StatCsThread)) {
+      DxvkCsStatsData nextCsStats = device->csStats()->getData();
+      m_diffCsStats = nextCsStats.diff(m_prevCsStats);
+      m_prevCsStats = std::move(nextCsStats);
+    }
   }
   
   
@@ -39,6 +45,9 @@ namespace dxvk::hud {
     if (m_elements.test(HudElement::StatMemory))
       position = this->printMemoryStats(context, renderer, position);
     
+    if (m_elements.test(HudElement::StatCsThread))
+      position = this->printCsStats(context, renderer, position);
+    
     return position;
   }
   
@@ -47,7 +56,7 @@ namespace dxvk::hud {
     const Rc<DxvkContext>&  context,
           HudTextRenderer&  renderer,
           HudPos            position) {
-    const uint64_t frameCount = std::max(m_diffCounters.getCtr(DxvkStatCounter::QueuePresentCount), 1u);
+    const uint64_t frameCount = std::max(m_diffCounters.getCtr(DxvkStatCounter::QueuePresentCount), uint64_t(1));
     
     const uint64_t gpCalls = m_diffCounters.getCtr(DxvkStatCounter::CmdDrawCalls)       / frameCount;
     const uint64_t cpCalls = m_diffCounters.getCtr(DxvkStatCounter::CmdDispatchCalls)   / frameCount;
@@ -80,17 +89,34 @@ namespace dxvk::hud {
     const Rc<DxvkContext>&  context,
           HudTextRenderer&  renderer,
           HudPos            position) {
-    const uint64_t frameCount = std::max(m_diffCounters.getCtr(DxvkStatCounter::QueuePresentCount), 1u);
+    const uint64_t frameCount = std::max(m_diffCounters.getCtr(DxvkStatCounter::QueuePresentCount), uint64_t(1));
     const uint64_t numSubmits = m_diffCounters.getCtr(DxvkStatCounter::QueueSubmitCount) / frameCount;
     
+    const uint64_t submitCount   = std::max(m_diffCounters.getCtr(DxvkStatCounter::QueueSubmitCount), uint64_t(1));
+    const uint64_t submitLatency = m_diffCounters.getCtr(DxvkStatCounter::QueueSubmitLatency) / submitCount;
+    const uint64_t submitPending = m_prevCounters.getCtr(DxvkStatCounter::QueueSubmitPending);
+    const uint64_t acquireTime   = m_diffCounters.getCtr(DxvkStatCounter::QueueAcquireTime) / frameCount;
+    
     const std::string strSubmissions = str::format("Queue submissions: ", numSubmits);
+    const std::string strSubmitQueue = str::format("Submit latency:    ", submitLatency, " us, ", submitPending, " pending");
+    const std::string strAcquireTime = str::format("Acquire wait:      ", acquireTime, " us");
     
     renderer.drawText(context, 16.0f,
       { position.x, position.y },
       { 1.0f, 1.0f, 1.0f, 1.0f },
       strSubmissions);
     
-    return { position.x, position.y + 24.0f };
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y + 20.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strSubmitQueue);
+    
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y + 40.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strAcquireTime);
+    
+    return { position.x, position.y + 64.0f };
   }
   
   
@@ -100,9 +126,12 @@ namespace dxvk::hud {
           HudPos            position) {
     const uint64_t gpCount = m_prevCounters.getCtr(DxvkStatCounter::PipeCountGraphics);
     const uint64_t cpCount = m_prevCounters.getCtr(DxvkStatCounter::PipeCountCompute);
+    const uint64_t smCount = m_prevCounters.getCtr(DxvkStatCounter::ShaderModuleCount);
+    const uint64_t smSize  = m_prevCounters.getCtr(DxvkStatCounter::ShaderModuleMemory);
     
     const std::string strGpCount = str::format("Graphics pipelines: ", gpCount);
     const std::string strCpCount = str::format("Compute pipelines:  ", cpCount);
+    const std::string strSmCount = str::format("Shader modules:     ", smCount, " (", smSize / 1024, " kB)");
     
     renderer.drawText(context, 16.0f,
       { position.x, position.y },
@@ -114,7 +143,12 @@ namespace dxvk::hud {
       { 1.0f, 1.0f, 1.0f, 1.0f },
       strCpCount);
     
-    return { position.x, position.y + 44.0f };
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y + 40.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strSmCount);
+    
+    return { position.x, position.y + 64.0f };
   }
   
   
@@ -144,12 +178,59 @@ namespace dxvk::hud {
   }
   
   
+  HudPos HudStats::printCsStats(
+    const Rc<DxvkContext>&  context,
+          HudTextRenderer&  renderer,
+          HudPos            position) {
+    constexpr uint32_t MaxCommandCount = 8;
+    
+    const uint64_t frameCount = std::max(m_diffCounters.getCtr(DxvkStatCounter::QueuePresentCount), uint64_t(1));
+    const uint64_t chunkCount = std::max<uint64_t>(m_diffCsStats.chunkCount, 1);
+    
+    const uint64_t chunksPerFrame = m_diffCsStats.chunkCount   / frameCount;
+    const uint64_t cmdsPerChunk   = m_diffCsStats.commandCount / chunkCount;
+    const uint64_t fillRatio      = (100 * m_diffCsStats.bytesUsed) / std::max<uint64_t>(m_diffCsStats.bytesTotal, 1);
+    const uint64_t stallTime      = m_diffCsStats.stallTime / (1000 * frameCount);
+    
+    const std::string strChunks = str::format("CS chunks:  ", chunksPerFrame, " (", cmdsPerChunk, " cmds, ", fillRatio, "% full)");
+    const std::string strStalls = str::format("CS stalls:  ", stallTime, " us");
+    
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strChunks);
+    
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y + 20.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strStalls);
+    
+    position.y += 44.0f;
+    
+    for (const auto& cmd : m_diffCsStats.topCommands(MaxCommandCount)) {
+      const std::string strCommand = str::format("  ", cmd.first, ": ",
+        cmd.second.count / frameCount, " / ",
+        cmd.second.time / (1000 * frameCount), " us");
+      
+      renderer.drawText(context, 16.0f,
+        { position.x, position.y },
+        { 1.0f, 1.0f, 1.0f, 1.0f },
+        strCommand);
+      
+      position.y += 20.0f;
+    }
+    
+    return { position.x, position.y + 4.0f };
+  }
+  
+  
   HudElements HudStats::filterElements(HudElements elements) {
     return elements & HudElements(
       HudElement::StatDrawCalls,
       HudElement::StatSubmissions,
       HudElement::StatPipelines,
-      HudElement::StatMemory);
+      HudElement::StatMemory,
+      HudElement::StatCsThread);
   }
   
 }
\ No newline at end of file
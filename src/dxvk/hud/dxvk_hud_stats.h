@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../dxvk_cs_stats.h"
 #include "../dxvk_stats.h"
 
 #include "dxvk_hud_config.h"
@@ -36,6 +37,9 @@ namespace dxvk::hud {
     DxvkStatCounters  m_prevCounters;
     DxvkStatCounters  m_diffCounters;
     
+    DxvkCsStatsData   m_prevCsStats;
+    DxvkCsStatsData   m_diffCsStats;
+    
     HudPos printDrawCallStats(
       const Rc<DxvkContext>&  context,
             HudTextRenderer&  renderer,
@@ -56,6 +60,11 @@ namespace dxvk::hud {
             HudTextRenderer&  renderer,
             HudPos            position);
     
+    HudPos printCsStats(
+      const Rc<DxvkContext>&  context,
+            HudTextRenderer&  renderer,
+            HudPos            position);
+    
     static HudElements filterElements(HudElements elements);
     
   };
@@ -57,6 +57,21 @@ namespace dxvk::hud {
     context->bindResourceSampler(1, m_fontSampler);
     context->bindResourceView   (2, m_fontView, nullptr);
     
+    // All vertices of the frame go into one buffer slice,
+    // which is only read by the draw issued in endFrame
+    auto vertexSlice = m_vertexBuffer->allocPhysicalSlice();
+    context->invalidateBuffer(m_vertexBuffer, vertexSlice);
+    
+    m_vertexData  = reinterpret_cast<HudTextVertex*>(vertexSlice.mapPtr(0));
+    m_vertexIndex = 0;
+  }
+  
+  
+  void HudTextRenderer::endFrame(const Rc<DxvkContext>& context) {
+    if (m_vertexIndex != 0)
+      context->draw(m_vertexIndex, 1, 0, 0);
+    
+    m_vertexData  = nullptr;
     m_vertexIndex = 0;
   }
   
@@ -67,13 +82,10 @@ namespace dxvk::hud {
           HudPos            pos,
           HudColor          color,
     const std::string&      text) {
-    const size_t vertexIndex = m_vertexIndex;
-    
-    auto vertexSlice = m_vertexBuffer->allocPhysicalSlice();
-    context->invalidateBuffer(m_vertexBuffer, vertexSlice);
+    HudTextVertex* vertexData = this->allocVertices(6 * text.size());
     
-    HudTextVertex* vertexData = reinterpret_cast<HudTextVertex*>(
-      vertexSlice.mapPtr(vertexIndex * sizeof(HudTextVertex)));
+    if (vertexData == nullptr)
+      return;
     
     const float sizeFactor = size / static_cast<float>(g_hudFont.size);
     
@@ -126,10 +138,47 @@ namespace dxvk::hud {
       
       pos.x += sizeFactor * static_cast<float>(g_hudFont.advance);
     }
+  }
+  
+  
+  void HudTextRenderer::drawRect(
+    const Rc<DxvkContext>&  context,
+          HudPos            pos,
+          HudPos            size,
+          HudColor          color) {
+    HudTextVertex* vertexData = this->allocVertices(6);
+    
+    if (vertexData == nullptr)
+      return;
+    
+    const HudPos posTl = { pos.x,          pos.y          };
+    const HudPos posBr = { pos.x + size.x, pos.y + size.y };
+    
+    const HudTexCoord texSolid = { ~0u, ~0u };
+    
+    vertexData[0].position = { posTl.x, posTl.y };
+    vertexData[1].position = { posBr.x, posTl.y };
+    vertexData[2].position = { posTl.x, posBr.y };
+    vertexData[3].position = { posBr.x, posBr.y };
+    vertexData[4].position = { posTl.x, posBr.y };
+    vertexData[5].position = { posBr.x, posTl.y };
+    
+    for (uint32_t i = 0; i < 6; i++) {
+      vertexData[i].texcoord = texSolid;
+      vertexData[i].color    = color;
+    }
+  }
+  
+  
+  HudTextVertex* HudTextRenderer::allocVertices(
+          size_t            count) {
+    if (m_vertexData == nullptr
+     || m_vertexIndex + count > MaxVertexCount)
+      return nullptr;
     
-    const uint32_t vertexCount = 6 * text.size();
-    context->draw(vertexCount, 1, vertexIndex, 0);
-    m_vertexIndex += vertexCount;
+    HudTextVertex* result = m_vertexData + m_vertexIndex;
+    m_vertexIndex += count;
+    return result;
   }
   
   
@@ -141,8 +190,8 @@ namespace dxvk::hud {
       { 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_IMAGE_VIEW_TYPE_MAX_ENUM },
     }};
     
-    // 3 input registers, 2 output registers, tightly packed
-    const DxvkInterfaceSlots interfaceSlots = { 0x7, 0x3 };
+    // 3 input registers, 3 output registers, tightly packed
+    const DxvkInterfaceSlots interfaceSlots = { 0x7, 0x7 };
     
     return new DxvkShader(
       VK_SHADER_STAGE_VERTEX_BIT,
@@ -162,8 +211,8 @@ namespace dxvk::hud {
       { 2, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_IMAGE_VIEW_TYPE_2D       },
     }};
     
-    // 2 input registers, 1 output register
-    const DxvkInterfaceSlots interfaceSlots = { 0x3, 0x1 };
+    // 3 input registers, 1 output register
+    const DxvkInterfaceSlots interfaceSlots = { 0x7, 0x1 };
     
     return new DxvkShader(
       VK_SHADER_STAGE_FRAGMENT_BIT,
@@ -43,6 +43,10 @@ namespace dxvk::hud {
   
   /**
    * \brief Text vertex
+   * 
+   * Vertices of solid rectangles use \c HudTexCoord
+   * components of \c ~0u, in which case the shader
+   * does not sample the font texture.
    */
   struct HudTextVertex {
     HudPos      position;
@@ -55,6 +59,9 @@ namespace dxvk::hud {
    * 
    * Can be used by the presentation backend to
    * display performance and driver information.
+   * Text and rectangles are collected in a single
+   * vertex buffer and drawn in one draw call by
+   * \ref endFrame.
    */
   class HudTextRenderer {
     constexpr static VkDeviceSize MaxVertexCount = 1 << 16;
@@ -69,6 +76,9 @@ namespace dxvk::hud {
     void beginFrame(
       const Rc<DxvkContext>&  context);
     
+    void endFrame(
+      const Rc<DxvkContext>&  context);
+    
     void drawText(
       const Rc<DxvkContext>&  context,
             float             size,
@@ -76,6 +86,12 @@ namespace dxvk::hud {
             HudColor          color,
       const std::string&      text);
     
+    void drawRect(
+      const Rc<DxvkContext>&  context,
+            HudPos            pos,
+            HudPos            size,
+            HudColor          color);
+    
   private:
     
     std::array<uint8_t, 256> m_charMap;
@@ -88,8 +104,12 @@ namespace dxvk::hud {
     Rc<DxvkSampler>     m_fontSampler;
     
     Rc<DxvkBuffer>      m_vertexBuffer;
+    HudTextVertex*      m_vertexData  = nullptr;
     size_t              m_vertexIndex = 0;
     
+    HudTextVertex* allocVertices(
+            size_t            count);
+    
     Rc<DxvkShader> createVertexShader(
       const Rc<DxvkDevice>& device);
     
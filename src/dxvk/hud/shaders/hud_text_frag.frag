@@ -5,6 +5,7 @@ layout(set = 0, binding = 2) uniform texture2D t_font;
 
 layout(location = 0) in vec2 v_texcoord;
 layout(location = 1) in vec4 v_color;
+layout(location = 2) in float v_solid;
 
 layout(location = 0) out vec4 o_color;
 
@@ -21,6 +22,10 @@ void main() {
   vec4 r_center = vec4(v_color.rgb, v_color.a * r_alpha_center);
   vec4 r_shadow = vec4(0.0f, 0.0f, 0.0f, r_alpha_shadow);
   
-  o_color = mix(r_shadow, r_center, r_alpha_center);
+  // Solid rectangles do not have meaningful texture
+  // coordinates, so the font result is discarded
+  o_color = v_solid != 0.0f
+    ? v_color
+    : mix(r_shadow, r_center, r_alpha_center);
   o_color.rgb *= o_color.a;
 }
\ No newline at end of file
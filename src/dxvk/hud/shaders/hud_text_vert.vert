@@ -11,10 +11,12 @@ layout(location = 2) in  vec4 v_color;
 
 layout(location = 0) out vec2 o_texcoord;
 layout(location = 1) out vec4 o_color;
+layout(location = 2) out float o_solid;
 
 void main() {
   o_texcoord = vec2(v_texcoord);
   o_color    = v_color;
+  o_solid    = v_texcoord.x == ~0u ? 1.0f : 0.0f;
   
   vec2 pos = 2.0f * (v_position / vec2(g_hud.size)) - 1.0f;
   gl_Position = vec4(pos, 0.0f, 1.0f);
@@ -1,9 +1,22 @@
 #include "dxvk_vulkan_loader.h"
 
+#ifdef DXVK_NULL_VULKAN
+#include "dxvk_vulkan_null.h"
+#endif
+
 namespace dxvk::vk {
   
+  static PFN_vkVoidFunction getInstanceProcAddr(VkInstance instance, const char* name) {
+#ifdef DXVK_NULL_VULKAN
+    return getNullInstanceProcAddr(instance, name);
+#else
+    return ::vkGetInstanceProcAddr(instance, name);
+#endif
+  }
+  
+  
   PFN_vkVoidFunction LibraryLoader::sym(const char* name) const {
-    return ::vkGetInstanceProcAddr(nullptr, name);
+    return getInstanceProcAddr(nullptr, name);
   }
   
   
@@ -12,13 +25,13 @@ namespace dxvk::vk {
   
   
   PFN_vkVoidFunction InstanceLoader::sym(const char* name) const {
-    return ::vkGetInstanceProcAddr(m_instance, name);
+    return getInstanceProcAddr(m_instance, name);
   }
   
   
   DeviceLoader::DeviceLoader(VkInstance instance, VkDevice device)
   : m_getDeviceProcAddr(reinterpret_cast<PFN_vkGetDeviceProcAddr>(
-      ::vkGetInstanceProcAddr(instance, "vkGetDeviceProcAddr"))),
+      getInstanceProcAddr(instance, "vkGetDeviceProcAddr"))),
     m_device(device) { }
   
   
@@ -0,0 +1,1176 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "dxvk_vulkan_null.h"
+
+#include "../dxvk_format.h"
+
+#include "../../util/log/log.h"
+#include "../../util/util_env.h"
+
+namespace dxvk::vk {
+  
+  namespace {
+    
+    using Clock = std::chrono::high_resolution_clock;
+    
+    std::atomic<uint64_t> g_nextHandle = { 0x1000 };
+    
+    
+    /**
+     * \brief Converts an object pointer to a handle
+     * 
+     * Works for both dispatchable and non-dispatchable
+     * handles, which may be 64-bit integers on 32-bit
+     * platforms and pointers on 64-bit platforms.
+     */
+    template<typename T>
+    T toHandle(uint64_t value) {
+      T handle;
+      std::memcpy(&handle, &value, sizeof(handle));
+      return handle;
+    }
+    
+    template<typename T, typename Obj>
+    T toHandle(Obj* object) {
+      return toHandle<T>(uint64_t(reinterpret_cast<uintptr_t>(object)));
+    }
+    
+    template<typename Obj, typename T>
+    Obj* fromHandle(T handle) {
+      uint64_t value = 0;
+      std::memcpy(&value, &handle, sizeof(handle));
+      return reinterpret_cast<Obj*>(uintptr_t(value));
+    }
+    
+    template<typename T>
+    T allocHandle() {
+      return toHandle<T>(g_nextHandle++);
+    }
+    
+    
+    struct NullMemory {
+      void*        data;
+      VkDeviceSize size;
+    };
+    
+    struct NullBuffer {
+      VkDeviceSize size;
+    };
+    
+    struct NullImage {
+      VkImageCreateInfo info;
+    };
+    
+    struct NullFence {
+      std::atomic<int64_t> signalTime;
+    };
+    
+    struct NullSwapchain {
+      std::vector<VkImage> images;
+      uint32_t             nextImage = 0;
+    };
+    
+    
+    /**
+     * \brief Fence latency
+     * 
+     * Time between a submission and the point where
+     * its fence is considered signaled. Read once
+     * from \c DXVK_NULL_FENCE_LATENCY.
+     */
+    std::chrono::microseconds getFenceLatency() {
+      static const std::chrono::microseconds latency = [] {
+        const std::string value = env::getEnvVar(L"DXVK_NULL_FENCE_LATENCY");
+        return std::chrono::microseconds(value.empty() ? 0 : std::atoll(value.c_str()));
+      } ();
+      
+      return latency;
+    }
+    
+    int64_t getTimestamp() {
+      return std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now().time_since_epoch()).count();
+    }
+    
+    constexpr int64_t FenceUnsignaled = INT64_MAX;
+    
+    
+    template<typename T>
+    VkResult writeArray(uint32_t* pCount, T* pData, const T* pSrc, uint32_t srcCount) {
+      if (pData == nullptr) {
+        *pCount = srcCount;
+        return VK_SUCCESS;
+      }
+      
+      const uint32_t count = std::min(*pCount, srcCount);
+      std::copy(pSrc, pSrc + count, pData);
+      *pCount = count;
+      return count < srcCount ? VK_INCOMPLETE : VK_SUCCESS;
+    }
+    
+    VkExtensionProperties makeExtension(const char* name) {
+      VkExtensionProperties result = { };
+      std::strncpy(result.extensionName, name, VK_MAX_EXTENSION_NAME_SIZE - 1);
+      result.specVersion = 1;
+      return result;
+    }
+    
+    
+    /**
+     * \brief Generic no-op function
+     * 
+     * Used for destroy functions and all
+     * commands recorded into command buffers.
+     */
+    template<typename Fn>
+    struct NullNoOp;
+    
+    template<typename... Args>
+    struct NullNoOp<void (VKAPI_PTR*)(Args...)> {
+      static VKAPI_ATTR void VKAPI_CALL call(Args...) { }
+    };
+    
+    template<typename... Args>
+    struct NullNoOp<VkResult (VKAPI_PTR*)(Args...)> {
+      static VKAPI_ATTR VkResult VKAPI_CALL call(Args...) { return VK_SUCCESS; }
+    };
+    
+    
+    /**
+     * \brief Generic create function
+     * 
+     * Returns a unique dummy handle for objects
+     * that do not need to store any state.
+     */
+    template<typename Fn>
+    struct NullCreate;
+    
+    template<typename Parent, typename Info, typename T>
+    struct NullCreate<VkResult (VKAPI_PTR*)(Parent, const Info*, const VkAllocationCallbacks*, T*)> {
+      static VKAPI_ATTR VkResult VKAPI_CALL call(Parent, const Info*, const VkAllocationCallbacks*, T* pHandle) {
+        *pHandle = allocHandle<T>();
+        return VK_SUCCESS;
+      }
+    };
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullCreateInstance(
+      const VkInstanceCreateInfo*         pCreateInfo,
+      const VkAllocationCallbacks*        pAllocator,
+            VkInstance*                   pInstance) {
+      Logger::warn("Vulkan: Using null device, no rendering will be performed");
+      *pInstance = allocHandle<VkInstance>();
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullEnumerateInstanceLayerProperties(
+            uint32_t*                     pPropertyCount,
+            VkLayerProperties*            pProperties) {
+      *pPropertyCount = 0;
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullEnumerateInstanceExtensionProperties(
+      const char*                         pLayerName,
+            uint32_t*                     pPropertyCount,
+            VkExtensionProperties*        pProperties) {
+      if (pLayerName != nullptr) {
+        *pPropertyCount = 0;
+        return VK_ERROR_LAYER_NOT_PRESENT;
+      }
+      
+      const std::array<VkExtensionProperties, 3> extensions = {{
+        makeExtension(VK_KHR_SURFACE_EXTENSION_NAME),
+        makeExtension(VK_KHR_WIN32_SURFACE_EXTENSION_NAME),
+        makeExtension(VK_EXT_DEBUG_REPORT_EXTENSION_NAME),
+      }};
+      
+      return writeArray(pPropertyCount, pProperties,
+        extensions.data(), extensions.size());
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullEnumeratePhysicalDevices(
+            VkInstance                    instance,
+            uint32_t*                     pPhysicalDeviceCount,
+            VkPhysicalDevice*             pPhysicalDevices) {
+      static const VkPhysicalDevice adapter = allocHandle<VkPhysicalDevice>();
+      return writeArray(pPhysicalDeviceCount, pPhysicalDevices, &adapter, 1);
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullGetPhysicalDeviceFeatures(
+            VkPhysicalDevice              physicalDevice,
+            VkPhysicalDeviceFeatures*     pFeatures) {
+      // The feature struct only consists of VkBool32
+      // members, so we can simply enable all of them
+      VkBool32* features = reinterpret_cast<VkBool32*>(pFeatures);
+      
+      for (size_t i = 0; i < sizeof(*pFeatures) / sizeof(VkBool32); i++)
+        features[i] = VK_TRUE;
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullGetPhysicalDeviceFormatProperties(
+            VkPhysicalDevice              physicalDevice,
+            VkFormat                      format,
+            VkFormatProperties*           pFormatProperties) {
+      const VkFormatFeatureFlags imageFeatures
+        = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT
+        | VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT
+        | VK_FORMAT_FEATURE_STORAGE_IMAGE_ATOMIC_BIT
+        | VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT
+        | VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BLEND_BIT
+        | VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT
+        | VK_FORMAT_FEATURE_BLIT_SRC_BIT
+        | VK_FORMAT_FEATURE_BLIT_DST_BIT
+        | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT
+        | VK_FORMAT_FEATURE_TRANSFER_SRC_BIT_KHR
+        | VK_FORMAT_FEATURE_TRANSFER_DST_BIT_KHR;
+      
+      const VkFormatFeatureFlags bufferFeatures
+        = VK_FORMAT_FEATURE_UNIFORM_TEXEL_BUFFER_BIT
+        | VK_FORMAT_FEATURE_STORAGE_TEXEL_BUFFER_BIT
+        | VK_FORMAT_FEATURE_STORAGE_TEXEL_BUFFER_ATOMIC_BIT
+        | VK_FORMAT_FEATURE_VERTEX_BUFFER_BIT;
+      
+      const bool supported = format != VK_FORMAT_UNDEFINED;
+      
+      pFormatProperties->linearTilingFeatures  = supported ? imageFeatures  : 0;
+      pFormatProperties->optimalTilingFeatures = supported ? imageFeatures  : 0;
+      pFormatProperties->bufferFeatures        = supported ? bufferFeatures : 0;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullGetPhysicalDeviceImageFormatProperties(
+            VkPhysicalDevice              physicalDevice,
+            VkFormat                      format,
+            VkImageType                   type,
+            VkImageTiling                 tiling,
+            VkImageUsageFlags             usage,
+            VkImageCreateFlags            flags,
+            VkImageFormatProperties*      pImageFormatProperties) {
+      if (format == VK_FORMAT_UNDEFINED)
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+      
+      switch (type) {
+        case VK_IMAGE_TYPE_1D: pImageFormatProperties->maxExtent = { 16384,     1,    1 }; break;
+        case VK_IMAGE_TYPE_2D: pImageFormatProperties->maxExtent = { 16384, 16384,    1 }; break;
+        case VK_IMAGE_TYPE_3D: pImageFormatProperties->maxExtent = {  2048,  2048, 2048 }; break;
+        default: return VK_ERROR_FORMAT_NOT_SUPPORTED;
+      }
+      
+      pImageFormatProperties->maxMipLevels    = 15;
+      pImageFormatProperties->maxArrayLayers  = type == VK_IMAGE_TYPE_3D ? 1 : 2048;
+      pImageFormatProperties->sampleCounts    = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT
+                                              | VK_SAMPLE_COUNT_4_BIT | VK_SAMPLE_COUNT_8_BIT;
+      pImageFormatProperties->maxResourceSize = VkDeviceSize(1) << 31;
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullGetPhysicalDeviceMemoryProperties(
+            VkPhysicalDevice                  physicalDevice,
+            VkPhysicalDeviceMemoryProperties* pMemoryProperties) {
+      *pMemoryProperties = VkPhysicalDeviceMemoryProperties();
+      
+      pMemoryProperties->memoryHeapCount = 2;
+      pMemoryProperties->memoryHeaps[0] = { VkDeviceSize(2) << 30, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT };
+      pMemoryProperties->memoryHeaps[1] = { VkDeviceSize(4) << 30, 0 };
+      
+      pMemoryProperties->memoryTypeCount = 4;
+      pMemoryProperties->memoryTypes[0] = { VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0 };
+      pMemoryProperties->memoryTypes[1] = { VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                                          | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 1 };
+      pMemoryProperties->memoryTypes[2] = { VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                                          | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                                          | VK_MEMORY_PROPERTY_HOST_CACHED_BIT, 1 };
+      pMemoryProperties->memoryTypes[3] = { VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+                                          | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                                          | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 0 };
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullGetPhysicalDeviceProperties(
+            VkPhysicalDevice              physicalDevice,
+            VkPhysicalDeviceProperties*   pProperties) {
+      *pProperties = VkPhysicalDeviceProperties();
+      pProperties->apiVersion    = VK_MAKE_VERSION(1, 0, 65);
+      pProperties->driverVersion = VK_MAKE_VERSION(1, 0, 0);
+      pProperties->deviceType    = VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU;
+      std::strncpy(pProperties->deviceName, "DXVK null device",
+        VK_MAX_PHYSICAL_DEVICE_NAME_SIZE - 1);
+      
+      VkPhysicalDeviceLimits& limits = pProperties->limits;
+      limits.maxImageDimension1D                    = 16384;
+      limits.maxImageDimension2D                    = 16384;
+      limits.maxImageDimension3D                    = 2048;
+      limits.maxImageDimensionCube                  = 16384;
+      limits.maxImageArrayLayers                    = 2048;
+      limits.maxTexelBufferElements                 = 1u << 27;
+      limits.maxUniformBufferRange                  = 65536;
+      limits.maxStorageBufferRange                  = 1u << 30;
+      limits.maxPushConstantsSize                   = 128;
+      limits.maxMemoryAllocationCount               = 4096;
+      limits.maxSamplerAllocationCount              = 4000;
+      limits.bufferImageGranularity                 = 1;
+      limits.maxBoundDescriptorSets                 = 8;
+      limits.maxPerStageDescriptorSamplers          = 1u << 20;
+      limits.maxPerStageDescriptorUniformBuffers    = 1u << 20;
+      limits.maxPerStageDescriptorStorageBuffers    = 1u << 20;
+      limits.maxPerStageDescriptorSampledImages     = 1u << 20;
+      limits.maxPerStageDescriptorStorageImages     = 1u << 20;
+      limits.maxPerStageDescriptorInputAttachments  = 1u << 20;
+      limits.maxPerStageResources                   = 1u << 20;
+      limits.maxDescriptorSetSamplers               = 1u << 20;
+      limits.maxDescriptorSetUniformBuffers         = 1u << 20;
+      limits.maxDescriptorSetUniformBuffersDynamic  = 16;
+      limits.maxDescriptorSetStorageBuffers         = 1u << 20;
+      limits.maxDescriptorSetStorageBuffersDynamic  = 16;
+      limits.maxDescriptorSetSampledImages          = 1u << 20;
+      limits.maxDescriptorSetStorageImages          = 1u << 20;
+      limits.maxDescriptorSetInputAttachments       = 1u << 20;
+      limits.maxVertexInputAttributes               = 32;
+      limits.maxVertexInputBindings                 = 32;
+      limits.maxVertexInputAttributeOffset          = 2047;
+      limits.maxVertexInputBindingStride            = 2048;
+      limits.maxVertexOutputComponents              = 128;
+      limits.maxTessellationGenerationLevel         = 64;
+      limits.maxTessellationPatchSize               = 32;
+      limits.maxTessellationControlPerVertexInputComponents   = 128;
+      limits.maxTessellationControlPerVertexOutputComponents  = 128;
+      limits.maxTessellationControlPerPatchOutputComponents   = 120;
+      limits.maxTessellationControlTotalOutputComponents      = 4096;
+      limits.maxTessellationEvaluationInputComponents         = 128;
+      limits.maxTessellationEvaluationOutputComponents        = 128;
+      limits.maxGeometryShaderInvocations           = 32;
+      limits.maxGeometryInputComponents             = 128;
+      limits.maxGeometryOutputComponents            = 128;
+      limits.maxGeometryOutputVertices              = 1024;
+      limits.maxGeometryTotalOutputComponents       = 1024;
+      limits.maxFragmentInputComponents             = 128;
+      limits.maxFragmentOutputAttachments           = 8;
+      limits.maxFragmentDualSrcAttachments          = 1;
+      limits.maxFragmentCombinedOutputResources     = 1u << 20;
+      limits.maxComputeSharedMemorySize             = 32768;
+      limits.maxComputeWorkGroupCount[0]            = 65535;
+      limits.maxComputeWorkGroupCount[1]            = 65535;
+      limits.maxComputeWorkGroupCount[2]            = 65535;
+      limits.maxComputeWorkGroupInvocations         = 1024;
+      limits.maxComputeWorkGroupSize[0]             = 1024;
+      limits.maxComputeWorkGroupSize[1]             = 1024;
+      limits.maxComputeWorkGroupSize[2]             = 64;
+      limits.subPixelPrecisionBits                  = 8;
+      limits.subTexelPrecisionBits                  = 8;
+      limits.mipmapPrecisionBits                    = 8;
+      limits.maxDrawIndexedIndexValue               = ~0u;
+      limits.maxDrawIndirectCount                   = ~0u;
+      limits.maxSamplerLodBias                      = 16.0f;
+      limits.maxSamplerAnisotropy                   = 16.0f;
+      limits.maxViewports                           = 16;
+      limits.maxViewportDimensions[0]               = 16384;
+      limits.maxViewportDimensions[1]               = 16384;
+      limits.viewportBoundsRange[0]                 = -32768.0f;
+      limits.viewportBoundsRange[1]                 =  32767.0f;
+      limits.viewportSubPixelBits                   = 8;
+      limits.minMemoryMapAlignment                  = 64;
+      limits.minTexelBufferOffsetAlignment          = 16;
+      limits.minUniformBufferOffsetAlignment        = 256;
+      limits.minStorageBufferOffsetAlignment        = 16;
+      limits.minTexelOffset                         = -8;
+      limits.maxTexelOffset                         = 7;
+      limits.minTexelGatherOffset                   = -32;
+      limits.maxTexelGatherOffset                   = 31;
+      limits.minInterpolationOffset                 = -0.5f;
+      limits.maxInterpolationOffset                 = 0.4375f;
+      limits.subPixelInterpolationOffsetBits        = 4;
+      limits.maxFramebufferWidth                    = 16384;
+      limits.maxFramebufferHeight                   = 16384;
+      limits.maxFramebufferLayers                   = 2048;
+      limits.framebufferColorSampleCounts           = 0xF;
+      limits.framebufferDepthSampleCounts           = 0xF;
+      limits.framebufferStencilSampleCounts         = 0xF;
+      limits.framebufferNoAttachmentsSampleCounts   = 0xF;
+      limits.maxColorAttachments                    = 8;
+      limits.sampledImageColorSampleCounts          = 0xF;
+      limits.sampledImageIntegerSampleCounts        = 0xF;
+      limits.sampledImageDepthSampleCounts          = 0xF;
+      limits.sampledImageStencilSampleCounts        = 0xF;
+      limits.storageImageSampleCounts               = 0xF;
+      limits.maxSampleMaskWords                     = 1;
+      limits.timestampComputeAndGraphics            = VK_TRUE;
+      limits.timestampPeriod                        = 1.0f;
+      limits.maxClipDistances                       = 8;
+      limits.maxCullDistances                       = 8;
+      limits.maxCombinedClipAndCullDistances        = 8;
+      limits.discreteQueuePriorities                = 2;
+      limits.pointSizeRange[0]                      = 1.0f;
+      limits.pointSizeRange[1]                      = 64.0f;
+      limits.lineWidthRange[0]                      = 1.0f;
+      limits.lineWidthRange[1]                      = 1.0f;
+      limits.pointSizeGranularity                   = 1.0f;
+      limits.lineWidthGranularity                   = 1.0f;
+      limits.optimalBufferCopyOffsetAlignment       = 1;
+      limits.optimalBufferCopyRowPitchAlignment     = 1;
+      limits.nonCoherentAtomSize                    = 64;
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullGetPhysicalDeviceQueueFamilyProperties(
+            VkPhysicalDevice              physicalDevice,
+            uint32_t*                     pQueueFamilyPropertyCount,
+            VkQueueFamilyProperties*      pQueueFamilyProperties) {
+      VkQueueFamilyProperties family;
+      family.queueFlags         = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+      family.queueCount         = 1;
+      family.timestampValidBits = 64;
+      family.minImageTransferGranularity = { 1, 1, 1 };
+      
+      writeArray(pQueueFamilyPropertyCount, pQueueFamilyProperties, &family, 1);
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullGetPhysicalDeviceSparseImageFormatProperties(
+            VkPhysicalDevice              physicalDevice,
+            VkFormat                      format,
+            VkImageType                   type,
+            VkSampleCountFlagBits         samples,
+            VkImageUsageFlags             usage,
+            VkImageTiling                 tiling,
+            uint32_t*                     pPropertyCount,
+            VkSparseImageFormatProperties* pProperties) {
+      *pPropertyCount = 0;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullEnumerateDeviceExtensionProperties(
+            VkPhysicalDevice              physicalDevice,
+      const char*                         pLayerName,
+            uint32_t*                     pPropertyCount,
+            VkExtensionProperties*        pProperties) {
+      const std::array<VkExtensionProperties, 5> extensions = {{
+        makeExtension(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME),
+        makeExtension(VK_KHR_MAINTENANCE1_EXTENSION_NAME),
+        makeExtension(VK_KHR_MAINTENANCE2_EXTENSION_NAME),
+        makeExtension(VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME),
+        makeExtension(VK_KHR_SWAPCHAIN_EXTENSION_NAME),
+      }};
+      
+      return writeArray(pPropertyCount, pProperties,
+        extensions.data(), extensions.size());
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullGetPhysicalDeviceSurfaceSupportKHR(
+            VkPhysicalDevice              physicalDevice,
+            uint32_t                      queueFamilyIndex,
+            VkSurfaceKHR                  surface,
+            VkBool32*                     pSupported) {
+      *pSupported = VK_TRUE;
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR VkBool32 VKAPI_CALL nullGetPhysicalDeviceWin32PresentationSupportKHR(
+            VkPhysicalDevice              physicalDevice,
+            uint32_t                      queueFamilyIndex) {
+      return VK_TRUE;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullGetPhysicalDeviceSurfaceCapabilitiesKHR(
+            VkPhysicalDevice              physicalDevice,
+            VkSurfaceKHR                  surface,
+            VkSurfaceCapabilitiesKHR*     pSurfaceCapabilities) {
+      // The window size is unknown, so let the
+      // swap chain decide the image size.
+      pSurfaceCapabilities->minImageCount           = 1;
+      pSurfaceCapabilities->maxImageCount           = 8;
+      pSurfaceCapabilities->currentExtent           = { ~0u, ~0u };
+      pSurfaceCapabilities->minImageExtent          = { 1, 1 };
+      pSurfaceCapabilities->maxImageExtent          = { 16384, 16384 };
+      pSurfaceCapabilities->maxImageArrayLayers     = 1;
+      pSurfaceCapabilities->supportedTransforms     = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+      pSurfaceCapabilities->currentTransform        = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+      pSurfaceCapabilities->supportedCompositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+      pSurfaceCapabilities->supportedUsageFlags     = VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+                                                    | VK_IMAGE_USAGE_TRANSFER_DST_BIT
+                                                    | VK_IMAGE_USAGE_SAMPLED_BIT
+                                                    | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullGetPhysicalDeviceSurfaceFormatsKHR(
+            VkPhysicalDevice              physicalDevice,
+            VkSurfaceKHR                  surface,
+            uint32_t*                     pSurfaceFormatCount,
+            VkSurfaceFormatKHR*           pSurfaceFormats) {
+      const std::array<VkSurfaceFormatKHR, 4> formats = {{
+        { VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR },
+        { VK_FORMAT_B8G8R8A8_SRGB,  VK_COLOR_SPACE_SRGB_NONLINEAR_KHR },
+        { VK_FORMAT_R8G8B8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR },
+        { VK_FORMAT_R8G8B8A8_SRGB,  VK_COLOR_SPACE_SRGB_NONLINEAR_KHR },
+      }};
+      
+      return writeArray(pSurfaceFormatCount, pSurfaceFormats,
+        formats.data(), formats.size());
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullGetPhysicalDeviceSurfacePresentModesKHR(
+            VkPhysicalDevice              physicalDevice,
+            VkSurfaceKHR                  surface,
+            uint32_t*                     pPresentModeCount,
+            VkPresentModeKHR*             pPresentModes) {
+      const std::array<VkPresentModeKHR, 3> modes = {{
+        VK_PRESENT_MODE_IMMEDIATE_KHR,
+        VK_PRESENT_MODE_MAILBOX_KHR,
+        VK_PRESENT_MODE_FIFO_KHR,
+      }};
+      
+      return writeArray(pPresentModeCount, pPresentModes,
+        modes.data(), modes.size());
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullAllocateMemory(
+            VkDevice                      device,
+      const VkMemoryAllocateInfo*         pAllocateInfo,
+      const VkAllocationCallbacks*        pAllocator,
+            VkDeviceMemory*               pMemory) {
+      // calloc typically maps zero pages lazily, so large
+      // allocations that are never touched are cheap.
+      void* data = std::calloc(1, pAllocateInfo->allocationSize);
+      
+      if (data == nullptr)
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+      
+      *pMemory = toHandle<VkDeviceMemory>(new NullMemory { data, pAllocateInfo->allocationSize });
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullFreeMemory(
+            VkDevice                      device,
+            VkDeviceMemory                memory,
+      const VkAllocationCallbacks*        pAllocator) {
+      NullMemory* object = fromHandle<NullMemory>(memory);
+      
+      if (object != nullptr) {
+        std::free(object->data);
+        delete object;
+      }
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullMapMemory(
+            VkDevice                      device,
+            VkDeviceMemory                memory,
+            VkDeviceSize                  offset,
+            VkDeviceSize                  size,
+            VkMemoryMapFlags              flags,
+            void**                        ppData) {
+      NullMemory* object = fromHandle<NullMemory>(memory);
+      *ppData = reinterpret_cast<char*>(object->data) + offset;
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullCreateBuffer(
+            VkDevice                      device,
+      const VkBufferCreateInfo*           pCreateInfo,
+      const VkAllocationCallbacks*        pAllocator,
+            VkBuffer*                     pBuffer) {
+      *pBuffer = toHandle<VkBuffer>(new NullBuffer { pCreateInfo->size });
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullDestroyBuffer(
+            VkDevice                      device,
+            VkBuffer                      buffer,
+      const VkAllocationCallbacks*        pAllocator) {
+      delete fromHandle<NullBuffer>(buffer);
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullGetBufferMemoryRequirements(
+            VkDevice                      device,
+            VkBuffer                      buffer,
+            VkMemoryRequirements*         pMemoryRequirements) {
+      pMemoryRequirements->size           = align(fromHandle<NullBuffer>(buffer)->size, 256);
+      pMemoryRequirements->alignment      = 256;
+      pMemoryRequirements->memoryTypeBits = 0xF;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullCreateImage(
+            VkDevice                      device,
+      const VkImageCreateInfo*            pCreateInfo,
+      const VkAllocationCallbacks*        pAllocator,
+            VkImage*                      pImage) {
+      NullImage* image = new NullImage;
+      image->info = *pCreateInfo;
+      image->info.pNext = nullptr;
+      image->info.pQueueFamilyIndices = nullptr;
+      
+      *pImage = toHandle<VkImage>(image);
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullDestroyImage(
+            VkDevice                      device,
+            VkImage                       image,
+      const VkAllocationCallbacks*        pAllocator) {
+      delete fromHandle<NullImage>(image);
+    }
+    
+    
+    VkDeviceSize getSubresourceSize(const VkImageCreateInfo& info, uint32_t level) {
+      const DxvkFormatInfo* format = imageFormatInfo(info.format);
+      
+      const VkExtent3D blockCount = {
+        (std::max(info.extent.width  >> level, 1u) + format->blockSize.width  - 1) / format->blockSize.width,
+        (std::max(info.extent.height >> level, 1u) + format->blockSize.height - 1) / format->blockSize.height,
+        (std::max(info.extent.depth  >> level, 1u) + format->blockSize.depth  - 1) / format->blockSize.depth };
+      
+      return format->elementSize * info.samples
+        * blockCount.width * blockCount.height * blockCount.depth;
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullGetImageMemoryRequirements(
+            VkDevice                      device,
+            VkImage                       image,
+            VkMemoryRequirements*         pMemoryRequirements) {
+      const VkImageCreateInfo& info = fromHandle<NullImage>(image)->info;
+      
+      VkDeviceSize size = 0;
+      
+      for (uint32_t i = 0; i < info.mipLevels; i++)
+        size += align(getSubresourceSize(info, i), 256) * info.arrayLayers;
+      
+      pMemoryRequirements->size           = std::max<VkDeviceSize>(size, 256);
+      pMemoryRequirements->alignment      = 256;
+      pMemoryRequirements->memoryTypeBits = 0xF;
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullGetImageSubresourceLayout(
+            VkDevice                      device,
+            VkImage                       image,
+      const VkImageSubresource*           pSubresource,
+            VkSubresourceLayout*          pLayout) {
+      const VkImageCreateInfo& info   = fromHandle<NullImage>(image)->info;
+      const DxvkFormatInfo*    format = imageFormatInfo(info.format);
+      
+      const uint32_t level = pSubresource->mipLevel;
+      
+      const VkExtent3D blockCount = {
+        (std::max(info.extent.width  >> level, 1u) + format->blockSize.width  - 1) / format->blockSize.width,
+        (std::max(info.extent.height >> level, 1u) + format->blockSize.height - 1) / format->blockSize.height,
+        (std::max(info.extent.depth  >> level, 1u) + format->blockSize.depth  - 1) / format->blockSize.depth };
+      
+      VkDeviceSize offset = 0;
+      
+      for (uint32_t i = 0; i < level; i++)
+        offset += align(getSubresourceSize(info, i), 256) * info.arrayLayers;
+      
+      pLayout->size       = getSubresourceSize(info, level);
+      pLayout->rowPitch   = format->elementSize * blockCount.width;
+      pLayout->depthPitch = pLayout->rowPitch   * blockCount.height;
+      pLayout->arrayPitch = align(pLayout->size, 256);
+      pLayout->offset     = offset + pLayout->arrayPitch * pSubresource->arrayLayer;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullCreateFence(
+            VkDevice                      device,
+      const VkFenceCreateInfo*            pCreateInfo,
+      const VkAllocationCallbacks*        pAllocator,
+            VkFence*                      pFence) {
+      NullFence* fence = new NullFence;
+      fence->signalTime = (pCreateInfo->flags & VK_FENCE_CREATE_SIGNALED_BIT)
+        ? 0 : FenceUnsignaled;
+      
+      *pFence = toHandle<VkFence>(fence);
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullDestroyFence(
+            VkDevice                      device,
+            VkFence                       fence,
+      const VkAllocationCallbacks*        pAllocator) {
+      delete fromHandle<NullFence>(fence);
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullResetFences(
+            VkDevice                      device,
+            uint32_t                      fenceCount,
+      const VkFence*                      pFences) {
+      for (uint32_t i = 0; i < fenceCount; i++)
+        fromHandle<NullFence>(pFences[i])->signalTime = FenceUnsignaled;
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullGetFenceStatus(
+            VkDevice                      device,
+            VkFence                       fence) {
+      return fromHandle<NullFence>(fence)->signalTime <= getTimestamp()
+        ? VK_SUCCESS : VK_NOT_READY;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullWaitForFences(
+            VkDevice                      device,
+            uint32_t                      fenceCount,
+      const VkFence*                      pFences,
+            VkBool32                      waitAll,
+            uint64_t                      timeout) {
+      // Fences that are not signaled and have not been
+      // submitted will never be signaled, so there's no
+      // point in waiting for them.
+      int64_t signalTime = waitAll ? 0 : FenceUnsignaled;
+      
+      for (uint32_t i = 0; i < fenceCount; i++) {
+        const int64_t t = fromHandle<NullFence>(pFences[i])->signalTime;
+        signalTime = waitAll ? std::max(signalTime, t) : std::min(signalTime, t);
+      }
+      
+      const int64_t now = getTimestamp();
+      
+      if (signalTime <= now)
+        return VK_SUCCESS;
+      
+      if (signalTime == FenceUnsignaled || uint64_t(signalTime - now) * 1000 > timeout) {
+        if (timeout != 0 && timeout != ~0ull)
+          std::this_thread::sleep_for(std::chrono::nanoseconds(timeout));
+        return VK_TIMEOUT;
+      }
+      
+      std::this_thread::sleep_for(std::chrono::microseconds(signalTime - now));
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullQueueSubmit(
+            VkQueue                       queue,
+            uint32_t                      submitCount,
+      const VkSubmitInfo*                 pSubmits,
+            VkFence                       fence) {
+      if (fence != VK_NULL_HANDLE) {
+        fromHandle<NullFence>(fence)->signalTime
+          = getTimestamp() + getFenceLatency().count();
+      }
+      
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullGetEventStatus(
+            VkDevice                      device,
+            VkEvent                       event) {
+      return VK_EVENT_SET;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullGetQueryPoolResults(
+            VkDevice                      device,
+            VkQueryPool                   queryPool,
+            uint32_t                      firstQuery,
+            uint32_t                      queryCount,
+            size_t                        dataSize,
+            void*                         pData,
+            VkDeviceSize                  stride,
+            VkQueryResultFlags            flags) {
+      std::memset(pData, 0, dataSize);
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullGetPipelineCacheData(
+            VkDevice                      device,
+            VkPipelineCache               pipelineCache,
+            size_t*                       pDataSize,
+            void*                         pData) {
+      *pDataSize = 0;
+      return VK_SUCCESS;
+    }
+    
+    
+    template<typename Info, typename T>
+    VkResult createHandles(uint32_t count, const Info* pInfos, T* pHandles) {
+      for (uint32_t i = 0; i < count; i++)
+        pHandles[i] = allocHandle<T>();
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullCreateGraphicsPipelines(
+            VkDevice                      device,
+            VkPipelineCache               pipelineCache,
+            uint32_t                      createInfoCount,
+      const VkGraphicsPipelineCreateInfo* pCreateInfos,
+      const VkAllocationCallbacks*        pAllocator,
+            VkPipeline*                   pPipelines) {
+      return createHandles(createInfoCount, pCreateInfos, pPipelines);
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullCreateComputePipelines(
+            VkDevice                      device,
+            VkPipelineCache               pipelineCache,
+            uint32_t                      createInfoCount,
+      const VkComputePipelineCreateInfo*  pCreateInfos,
+      const VkAllocationCallbacks*        pAllocator,
+            VkPipeline*                   pPipelines) {
+      return createHandles(createInfoCount, pCreateInfos, pPipelines);
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullAllocateDescriptorSets(
+            VkDevice                      device,
+      const VkDescriptorSetAllocateInfo*  pAllocateInfo,
+            VkDescriptorSet*              pDescriptorSets) {
+      return createHandles(pAllocateInfo->descriptorSetCount,
+        pAllocateInfo->pSetLayouts, pDescriptorSets);
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullAllocateCommandBuffers(
+            VkDevice                      device,
+      const VkCommandBufferAllocateInfo*  pAllocateInfo,
+            VkCommandBuffer*              pCommandBuffers) {
+      return createHandles(pAllocateInfo->commandBufferCount,
+        pAllocateInfo, pCommandBuffers);
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullGetRenderAreaGranularity(
+            VkDevice                      device,
+            VkRenderPass                  renderPass,
+            VkExtent2D*                   pGranularity) {
+      *pGranularity = { 1, 1 };
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullGetDeviceQueue(
+            VkDevice                      device,
+            uint32_t                      queueFamilyIndex,
+            uint32_t                      queueIndex,
+            VkQueue*                      pQueue) {
+      static const VkQueue queue = allocHandle<VkQueue>();
+      *pQueue = queue;
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullCreateSwapchainKHR(
+            VkDevice                      device,
+      const VkSwapchainCreateInfoKHR*     pCreateInfo,
+      const VkAllocationCallbacks*        pAllocator,
+            VkSwapchainKHR*               pSwapchain) {
+      VkImageCreateInfo imageInfo;
+      imageInfo.sType                 = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+      imageInfo.pNext                 = nullptr;
+      imageInfo.flags                 = 0;
+      imageInfo.imageType             = VK_IMAGE_TYPE_2D;
+      imageInfo.format                = pCreateInfo->imageFormat;
+      imageInfo.extent                = { pCreateInfo->imageExtent.width, pCreateInfo->imageExtent.height, 1 };
+      imageInfo.mipLevels             = 1;
+      imageInfo.arrayLayers           = 1;
+      imageInfo.samples               = VK_SAMPLE_COUNT_1_BIT;
+      imageInfo.tiling                = VK_IMAGE_TILING_OPTIMAL;
+      imageInfo.usage                 = pCreateInfo->imageUsage;
+      imageInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+      imageInfo.queueFamilyIndexCount = 0;
+      imageInfo.pQueueFamilyIndices   = nullptr;
+      imageInfo.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
+      
+      NullSwapchain* swapchain = new NullSwapchain;
+      
+      for (uint32_t i = 0; i < pCreateInfo->minImageCount; i++)
+        swapchain->images.push_back(toHandle<VkImage>(new NullImage { imageInfo }));
+      
+      *pSwapchain = toHandle<VkSwapchainKHR>(swapchain);
+      return VK_SUCCESS;
+    }
+    
+    
+    VKAPI_ATTR void VKAPI_CALL nullDestroySwapchainKHR(
+            VkDevice                      device,
+            VkSwapchainKHR                swapchain,
+      const VkAllocationCallbacks*        pAllocator) {
+      NullSwapchain* object = fromHandle<NullSwapchain>(swapchain);
+      
+      if (object != nullptr) {
+        for (VkImage image : object->images)
+          delete fromHandle<NullImage>(image);
+        delete object;
+      }
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullGetSwapchainImagesKHR(
+            VkDevice                      device,
+            VkSwapchainKHR                swapchain,
+            uint32_t*                     pSwapchainImageCount,
+            VkImage*                      pSwapchainImages) {
+      const NullSwapchain* object = fromHandle<NullSwapchain>(swapchain);
+      
+      return writeArray(pSwapchainImageCount, pSwapchainImages,
+        object->images.data(), object->images.size());
+    }
+    
+    
+    VKAPI_ATTR VkResult VKAPI_CALL nullAcquireNextImageKHR(
+            VkDevice                      device,
+            VkSwapchainKHR                swapchain,
+            uint64_t                      timeout,
+            VkSemaphore                   semaphore,
+            VkFence                       fence,
+            uint32_t*                     pImageIndex) {
+      NullSwapchain* object = fromHandle<NullSwapchain>(swapchain);
+      
+      *pImageIndex = object->nextImage;
+      object->nextImage = (object->nextImage + 1) % object->images.size();
+      
+      if (fence != VK_NULL_HANDLE)
+        fromHandle<NullFence>(fence)->signalTime = getTimestamp();
+      
+      return VK_SUCCESS;
+    }
+    
+    
+    PFN_vkVoidFunction getNullDeviceProcAddr(
+            VkDevice  device,
+      const char*     name);
+    
+    
+    VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL nullGetDeviceProcAddr(
+            VkDevice                      device,
+      const char*                         pName) {
+      return getNullDeviceProcAddr(device, pName);
+    }
+    
+    
+    #define NULL_VK_FN(name, fn) \
+      { #name, reinterpret_cast<PFN_vkVoidFunction>(fn) }
+    #define NULL_VK_NOOP(name) \
+      NULL_VK_FN(name, &NullNoOp<PFN_ ## name>::call)
+    #define NULL_VK_CREATE(name) \
+      NULL_VK_FN(name, &NullCreate<PFN_ ## name>::call)
+    
+    using FunctionMap = std::unordered_map<std::string, PFN_vkVoidFunction>;
+    
+    const FunctionMap g_instanceFunctions = {
+      NULL_VK_FN    (vkCreateInstance,                              &nullCreateInstance),
+      NULL_VK_FN    (vkEnumerateInstanceLayerProperties,            &nullEnumerateInstanceLayerProperties),
+      NULL_VK_FN    (vkEnumerateInstanceExtensionProperties,        &nullEnumerateInstanceExtensionProperties),
+      NULL_VK_FN    (vkGetDeviceProcAddr,                           &nullGetDeviceProcAddr),
+      NULL_VK_CREATE(vkCreateDevice),
+      NULL_VK_NOOP  (vkDestroyInstance),
+      NULL_VK_FN    (vkEnumerateDeviceExtensionProperties,          &nullEnumerateDeviceExtensionProperties),
+      NULL_VK_FN    (vkEnumeratePhysicalDevices,                    &nullEnumeratePhysicalDevices),
+      NULL_VK_FN    (vkGetPhysicalDeviceFeatures,                   &nullGetPhysicalDeviceFeatures),
+      NULL_VK_FN    (vkGetPhysicalDeviceFormatProperties,           &nullGetPhysicalDeviceFormatProperties),
+      NULL_VK_FN    (vkGetPhysicalDeviceImageFormatProperties,      &nullGetPhysicalDeviceImageFormatProperties),
+      NULL_VK_FN    (vkGetPhysicalDeviceMemoryProperties,           &nullGetPhysicalDeviceMemoryProperties),
+      NULL_VK_FN    (vkGetPhysicalDeviceProperties,                 &nullGetPhysicalDeviceProperties),
+      NULL_VK_FN    (vkGetPhysicalDeviceQueueFamilyProperties,      &nullGetPhysicalDeviceQueueFamilyProperties),
+      NULL_VK_FN    (vkGetPhysicalDeviceSparseImageFormatProperties,&nullGetPhysicalDeviceSparseImageFormatProperties),
+      NULL_VK_CREATE(vkCreateWin32SurfaceKHR),
+      NULL_VK_FN    (vkGetPhysicalDeviceWin32PresentationSupportKHR,&nullGetPhysicalDeviceWin32PresentationSupportKHR),
+      NULL_VK_NOOP  (vkDestroySurfaceKHR),
+      NULL_VK_FN    (vkGetPhysicalDeviceSurfaceSupportKHR,          &nullGetPhysicalDeviceSurfaceSupportKHR),
+      NULL_VK_FN    (vkGetPhysicalDeviceSurfaceCapabilitiesKHR,     &nullGetPhysicalDeviceSurfaceCapabilitiesKHR),
+      NULL_VK_FN    (vkGetPhysicalDeviceSurfaceFormatsKHR,          &nullGetPhysicalDeviceSurfaceFormatsKHR),
+      NULL_VK_FN    (vkGetPhysicalDeviceSurfacePresentModesKHR,     &nullGetPhysicalDeviceSurfacePresentModesKHR),
+      NULL_VK_CREATE(vkCreateDebugReportCallbackEXT),
+      NULL_VK_NOOP  (vkDestroyDebugReportCallbackEXT),
+      NULL_VK_NOOP  (vkDebugReportMessageEXT),
+    };
+    
+    const FunctionMap g_deviceFunctions = {
+      NULL_VK_NOOP  (vkDestroyDevice),
+      NULL_VK_FN    (vkGetDeviceQueue,                              &nullGetDeviceQueue),
+      NULL_VK_FN    (vkQueueSubmit,                                 &nullQueueSubmit),
+      NULL_VK_NOOP  (vkQueueWaitIdle),
+      NULL_VK_NOOP  (vkDeviceWaitIdle),
+      NULL_VK_FN    (vkAllocateMemory,                              &nullAllocateMemory),
+      NULL_VK_FN    (vkFreeMemory,                                  &nullFreeMemory),
+      NULL_VK_FN    (vkMapMemory,                                   &nullMapMemory),
+      NULL_VK_NOOP  (vkUnmapMemory),
+      NULL_VK_NOOP  (vkFlushMappedMemoryRanges),
+      NULL_VK_NOOP  (vkInvalidateMappedMemoryRanges),
+      NULL_VK_NOOP  (vkGetDeviceMemoryCommitment),
+      NULL_VK_NOOP  (vkBindBufferMemory),
+      NULL_VK_NOOP  (vkBindImageMemory),
+      NULL_VK_FN    (vkGetBufferMemoryRequirements,                 &nullGetBufferMemoryRequirements),
+      NULL_VK_FN    (vkGetImageMemoryRequirements,                  &nullGetImageMemoryRequirements),
+      NULL_VK_NOOP  (vkQueueBindSparse),
+      NULL_VK_FN    (vkCreateFence,                                 &nullCreateFence),
+      NULL_VK_FN    (vkDestroyFence,                                &nullDestroyFence),
+      NULL_VK_FN    (vkResetFences,                                 &nullResetFences),
+      NULL_VK_FN    (vkGetFenceStatus,                              &nullGetFenceStatus),
+      NULL_VK_FN    (vkWaitForFences,                               &nullWaitForFences),
+      NULL_VK_CREATE(vkCreateSemaphore),
+      NULL_VK_NOOP  (vkDestroySemaphore),
+      NULL_VK_CREATE(vkCreateEvent),
+      NULL_VK_NOOP  (vkDestroyEvent),
+      NULL_VK_FN    (vkGetEventStatus,                              &nullGetEventStatus),
+      NULL_VK_NOOP  (vkSetEvent),
+      NULL_VK_NOOP  (vkResetEvent),
+      NULL_VK_CREATE(vkCreateQueryPool),
+      NULL_VK_NOOP  (vkDestroyQueryPool),
+      NULL_VK_FN    (vkGetQueryPoolResults,                         &nullGetQueryPoolResults),
+      NULL_VK_FN    (vkCreateBuffer,                                &nullCreateBuffer),
+      NULL_VK_FN    (vkDestroyBuffer,                               &nullDestroyBuffer),
+      NULL_VK_CREATE(vkCreateBufferView),
+      NULL_VK_NOOP  (vkDestroyBufferView),
+      NULL_VK_FN    (vkCreateImage,                                 &nullCreateImage),
+      NULL_VK_FN    (vkDestroyImage,                                &nullDestroyImage),
+      NULL_VK_FN    (vkGetImageSubresourceLayout,                   &nullGetImageSubresourceLayout),
+      NULL_VK_CREATE(vkCreateImageView),
+      NULL_VK_NOOP  (vkDestroyImageView),
+      NULL_VK_CREATE(vkCreateShaderModule),
+      NULL_VK_NOOP  (vkDestroyShaderModule),
+      NULL_VK_CREATE(vkCreatePipelineCache),
+      NULL_VK_NOOP  (vkDestroyPipelineCache),
+      NULL_VK_FN    (vkGetPipelineCacheData,                        &nullGetPipelineCacheData),
+      NULL_VK_NOOP  (vkMergePipelineCaches),
+      NULL_VK_FN    (vkCreateGraphicsPipelines,                     &nullCreateGraphicsPipelines),
+      NULL_VK_FN    (vkCreateComputePipelines,                      &nullCreateComputePipelines),
+      NULL_VK_NOOP  (vkDestroyPipeline),
+      NULL_VK_CREATE(vkCreatePipelineLayout),
+      NULL_VK_NOOP  (vkDestroyPipelineLayout),
+      NULL_VK_CREATE(vkCreateSampler),
+      NULL_VK_NOOP  (vkDestroySampler),
+      NULL_VK_CREATE(vkCreateDescriptorSetLayout),
+      NULL_VK_NOOP  (vkDestroyDescriptorSetLayout),
+      NULL_VK_CREATE(vkCreateDescriptorPool),
+      NULL_VK_NOOP  (vkDestroyDescriptorPool),
+      NULL_VK_NOOP  (vkResetDescriptorPool),
+      NULL_VK_FN    (vkAllocateDescriptorSets,                      &nullAllocateDescriptorSets),
+      NULL_VK_NOOP  (vkFreeDescriptorSets),
+      NULL_VK_NOOP  (vkUpdateDescriptorSets),
+      NULL_VK_CREATE(vkCreateFramebuffer),
+      NULL_VK_NOOP  (vkDestroyFramebuffer),
+      NULL_VK_CREATE(vkCreateRenderPass),
+      NULL_VK_NOOP  (vkDestroyRenderPass),
+      NULL_VK_FN    (vkGetRenderAreaGranularity,                    &nullGetRenderAreaGranularity),
+      NULL_VK_CREATE(vkCreateCommandPool),
+      NULL_VK_NOOP  (vkDestroyCommandPool),
+      NULL_VK_NOOP  (vkResetCommandPool),
+      NULL_VK_FN    (vkAllocateCommandBuffers,                      &nullAllocateCommandBuffers),
+      NULL_VK_NOOP  (vkFreeCommandBuffers),
+      NULL_VK_NOOP  (vkBeginCommandBuffer),
+      NULL_VK_NOOP  (vkEndCommandBuffer),
+      NULL_VK_NOOP  (vkResetCommandBuffer),
+      NULL_VK_NOOP  (vkCmdBindPipeline),
+      NULL_VK_NOOP  (vkCmdSetViewport),
+      NULL_VK_NOOP  (vkCmdSetScissor),
+      NULL_VK_NOOP  (vkCmdSetLineWidth),
+      NULL_VK_NOOP  (vkCmdSetDepthBias),
+      NULL_VK_NOOP  (vkCmdSetBlendConstants),
+      NULL_VK_NOOP  (vkCmdSetDepthBounds),
+      NULL_VK_NOOP  (vkCmdSetStencilCompareMask),
+      NULL_VK_NOOP  (vkCmdSetStencilWriteMask),
+      NULL_VK_NOOP  (vkCmdSetStencilReference),
+      NULL_VK_NOOP  (vkCmdBindDescriptorSets),
+      NULL_VK_NOOP  (vkCmdBindIndexBuffer),
+      NULL_VK_NOOP  (vkCmdBindVertexBuffers),
+      NULL_VK_NOOP  (vkCmdDraw),
+      NULL_VK_NOOP  (vkCmdDrawIndexed),
+      NULL_VK_NOOP  (vkCmdDrawIndirect),
+      NULL_VK_NOOP  (vkCmdDrawIndexedIndirect),
+      NULL_VK_NOOP  (vkCmdDispatch),
+      NULL_VK_NOOP  (vkCmdDispatchIndirect),
+      NULL_VK_NOOP  (vkCmdCopyBuffer),
+      NULL_VK_NOOP  (vkCmdCopyImage),
+      NULL_VK_NOOP  (vkCmdBlitImage),
+      NULL_VK_NOOP  (vkCmdCopyBufferToImage),
+      NULL_VK_NOOP  (vkCmdCopyImageToBuffer),
+      NULL_VK_NOOP  (vkCmdUpdateBuffer),
+      NULL_VK_NOOP  (vkCmdFillBuffer),
+      NULL_VK_NOOP  (vkCmdClearColorImage),
+      NULL_VK_NOOP  (vkCmdClearDepthStencilImage),
+      NULL_VK_NOOP  (vkCmdClearAttachments),
+      NULL_VK_NOOP  (vkCmdResolveImage),
+      NULL_VK_NOOP  (vkCmdSetEvent),
+      NULL_VK_NOOP  (vkCmdResetEvent),
+      NULL_VK_NOOP  (vkCmdWaitEvents),
+      NULL_VK_NOOP  (vkCmdPipelineBarrier),
+      NULL_VK_NOOP  (vkCmdBeginQuery),
+      NULL_VK_NOOP  (vkCmdEndQuery),
+      NULL_VK_NOOP  (vkCmdResetQueryPool),
+      NULL_VK_NOOP  (vkCmdWriteTimestamp),
+      NULL_VK_NOOP  (vkCmdCopyQueryPoolResults),
+      NULL_VK_NOOP  (vkCmdPushConstants),
+      NULL_VK_NOOP  (vkCmdBeginRenderPass),
+      NULL_VK_NOOP  (vkCmdNextSubpass),
+      NULL_VK_NOOP  (vkCmdEndRenderPass),
+      NULL_VK_NOOP  (vkCmdExecuteCommands),
+      NULL_VK_CREATE(vkCreateDescriptorUpdateTemplateKHR),
+      NULL_VK_NOOP  (vkDestroyDescriptorUpdateTemplateKHR),
+      NULL_VK_NOOP  (vkUpdateDescriptorSetWithTemplateKHR),
+      NULL_VK_NOOP  (vkCmdPushDescriptorSetWithTemplateKHR),
+      NULL_VK_FN    (vkCreateSwapchainKHR,                          &nullCreateSwapchainKHR),
+      NULL_VK_FN    (vkDestroySwapchainKHR,                         &nullDestroySwapchainKHR),
+      NULL_VK_FN    (vkGetSwapchainImagesKHR,                       &nullGetSwapchainImagesKHR),
+      NULL_VK_FN    (vkAcquireNextImageKHR,                         &nullAcquireNextImageKHR),
+      NULL_VK_NOOP  (vkQueuePresentKHR),
+    };
+    
+    #undef NULL_VK_CREATE
+    #undef NULL_VK_NOOP
+    #undef NULL_VK_FN
+    
+    
+    PFN_vkVoidFunction getNullDeviceProcAddr(
+            VkDevice  device,
+      const char*     name) {
+      auto entry = g_deviceFunctions.find(name);
+      
+      if (entry == g_deviceFunctions.end())
+        return nullptr;
+      
+      return entry->second;
+    }
+    
+  }
+  
+  
+  PFN_vkVoidFunction getNullInstanceProcAddr(
+          VkInstance  instance,
+    const char*       name) {
+    auto entry = g_instanceFunctions.find(name);
+    
+    if (entry != g_instanceFunctions.end())
+      return entry->second;
+    
+    // Like real implementations, we also
+    // return device-level entry points
+    if (instance != VK_NULL_HANDLE)
+      return getNullDeviceProcAddr(VK_NULL_HANDLE, name);
+    
+    return nullptr;
+  }
+  
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "dxvk_vulkan_loader_fn.h"
+
+namespace dxvk::vk {
+  
+  /**
+   * \brief Null Vulkan instance proc address
+   * 
+   * Replacement for \c vkGetInstanceProcAddr when DXVK
+   * is built with the \c enable_null_vulkan option. The
+   * returned functions implement a fake Vulkan device
+   * which does not execute any commands: handles are
+   * dummies, device memory is backed by system memory
+   * and fences get signaled once a configurable amount
+   * of time has passed after submission.
+   * 
+   * This allows running the entire D3D11 front end on
+   * systems without a GPU in order to measure the CPU
+   * overhead of API calls. Fence latency is set in
+   * microseconds with \c DXVK_NULL_FENCE_LATENCY.
+   * \param [in] instance Instance handle, may be null
+   * \param [in] name Function name
+   * \returns Function pointer, or \c nullptr
+   */
+  PFN_vkVoidFunction getNullInstanceProcAddr(
+          VkInstance  instance,
+    const char*       name);
+  
+}
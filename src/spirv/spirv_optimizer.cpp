@@ -0,0 +1,1549 @@
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+
+#include "spirv_optimizer.h"
+
+namespace dxvk {
+  
+  template<typename Fn>
+  void SpirvOptimizer::forEachId(uint32_t index, bool conservative, const Fn& fn) {
+    uint32_t* w = words(index);
+    uint32_t  n = m_ins[index].length;
+    
+    Layout layout;
+    
+    if (!getLayout(words(index), layout)) {
+      // Any operand of an unknown instruction may be an ID
+      for (uint32_t i = 1; i < n && conservative; i++)
+        fn(w[i]);
+      return;
+    }
+    
+    const uint32_t idEnd = layout.idCount != ~0u
+      ? std::min(n, layout.idFirst + layout.idCount)
+      : n;
+    
+    for (uint32_t i = layout.idFirst; i < idEnd; i++)
+      fn(w[i]);
+    
+    for (uint32_t i = layout.tailFirst; i < n && layout.tailFirst; i++)
+      fn(w[i]);
+  }
+  
+  
+  SpirvOptimizer::SpirvOptimizer(const SpirvCodeBuffer& code) {
+    const size_t wordCount = code.size() / sizeof(uint32_t);
+    m_words.assign(code.data(), code.data() + wordCount);
+    
+    if (wordCount < 5 || m_words[0] != spv::MagicNumber)
+      throw DxvkError("SpirvOptimizer: Invalid SPIR-V module");
+    
+    m_bound = m_words[3];
+    
+    for (uint32_t offset = 5; offset < wordCount; ) {
+      const uint32_t length = m_words[offset] >> spv::WordCountShift;
+      
+      if (length == 0 || offset + length > wordCount)
+        throw DxvkError("SpirvOptimizer: Invalid SPIR-V instruction");
+      
+      m_ins.push_back({ offset, length });
+      offset += length;
+    }
+    
+    m_insCount = m_ins.size();
+    m_removed.resize(m_bound, false);
+    
+    this->updateDefs();
+    
+    // Register existing constants so that folded
+    // values can reuse them instead of adding new ones
+    for (uint32_t i = 0; i < m_insCount; i++) {
+      const spv::Op op = opCode(i);
+      
+      if (op == spv::OpConstant
+       || op == spv::OpConstantTrue
+       || op == spv::OpConstantFalse
+       || op == spv::OpConstantComposite) {
+        const uint32_t* w = words(i);
+        
+        std::vector<uint32_t> key = { uint32_t(op), w[1] };
+        key.insert(key.end(), w + 3, w + m_ins[i].length);
+        m_constants.insert({ key, w[2] });
+      }
+    }
+  }
+  
+  
+  SpirvOptimizer::~SpirvOptimizer() {
+    
+  }
+  
+  
+  void SpirvOptimizer::run() {
+    this->promoteVariables();
+    this->forwardLoadsAndStores();
+    this->propagateCopies();
+    
+    // Each simplification can enable further ones, e.g.
+    // when bit-casting the result of a folded operation
+    for (uint32_t i = 0; i < 4 && this->simplifyInstructions(); i++)
+      this->propagateCopies();
+    
+    this->eliminateDeadCode();
+  }
+  
+  
+  SpirvCodeBuffer SpirvOptimizer::getCode() const {
+    std::vector<uint32_t> code(m_words.begin(), m_words.begin() + 5);
+    code[3] = m_bound;
+    
+    auto emitInstruction = [&] (uint32_t index) {
+      const uint32_t* w = words(index);
+      code.insert(code.end(), w, w + m_ins[index].length);
+    };
+    
+    bool emittedGlobals = false;
+    
+    for (uint32_t i = 0; i < m_insCount; i++) {
+      if (m_ins[i].length == 0)
+        continue;
+      
+      // New constants must be declared before they
+      // are used, so emit them before any functions
+      if (!emittedGlobals && opCode(i) == spv::OpFunction) {
+        for (uint32_t j : m_globals)
+          emitInstruction(j);
+        
+        emittedGlobals = true;
+      }
+      
+      emitInstruction(i);
+      
+      // Phi instructions added to a block
+      // directly follow the block label
+      auto insertions = m_insertions.find(i);
+      
+      if (insertions != m_insertions.end()) {
+        for (uint32_t j : insertions->second)
+          emitInstruction(j);
+      }
+    }
+    
+    if (!emittedGlobals) {
+      for (uint32_t j : m_globals)
+        emitInstruction(j);
+    }
+    
+    return SpirvCodeBuffer(code.size(), code.data());
+  }
+  
+  
+  void SpirvOptimizer::promoteVariables() {
+    std::vector<bool> variables;
+    this->findLocalVariables(variables);
+    
+    // Find the function that accesses each variable. Private
+    // variables retain their value between function calls,
+    // so they can only be promoted if they are used by a
+    // function that runs exactly once exclusively.
+    std::vector<uint32_t> functions(m_bound, 0);
+    std::vector<bool>     entryPoints(m_bound, false);
+    std::vector<bool>     hasLoops(m_bound, false);
+    std::vector<uint32_t> callCounts(m_bound, 0);
+    std::vector<uint32_t> callers(m_bound, 0);
+    
+    uint32_t functionId = 0;
+    
+    for (uint32_t i = 0; i < m_insCount; i++) {
+      if (m_ins[i].length == 0)
+        continue;
+      
+      const spv::Op   op = opCode(i);
+      const uint32_t* w  = words(i);
+      
+      if (op == spv::OpEntryPoint && w[2] < m_bound)
+        entryPoints[w[2]] = true;
+      
+      if (op == spv::OpFunction)
+        functionId = w[2];
+      
+      if (op == spv::OpLoopMerge)
+        hasLoops[functionId] = true;
+      
+      if (op == spv::OpFunctionCall && w[3] < m_bound) {
+        callCounts[w[3]] += 1;
+        callers[w[3]] = functionId;
+      }
+      
+      if (op == spv::OpLoad || op == spv::OpStore) {
+        const uint32_t varId = op == spv::OpLoad ? w[3] : w[1];
+        
+        if (variables[varId]) {
+          functions[varId] = functions[varId] == 0 || functions[varId] == functionId
+            ? functionId : ~0u;
+        }
+      }
+    }
+    
+    // The DXBC compiler emits the shader code into a function
+    // that the entry point calls exactly once. Such a function
+    // runs exactly once as well, unless the call is in a loop.
+    std::vector<bool> runsOnce = entryPoints;
+    
+    for (uint32_t i = 0; i < m_bound; i++) {
+      if (callCounts[i] == 1
+       && entryPoints[callers[i]]
+       && !hasLoops[callers[i]])
+        runsOnce[i] = true;
+    }
+    
+    std::vector<bool> promote(m_bound, false);
+    
+    for (uint32_t i = 0; i < m_insCount; i++) {
+      if (m_ins[i].length == 0 || opCode(i) != spv::OpVariable)
+        continue;
+      
+      const uint32_t* w = words(i);
+      const uint32_t  f = functions[w[2]];
+      
+      if (variables[w[2]] && f != 0 && f != ~0u) {
+        promote[w[2]] = w[3] == spv::StorageClassFunction
+                     || runsOnce[f];
+      }
+    }
+    
+    // Promote variables one function at a time
+    uint32_t first = 0;
+    
+    for (uint32_t i = 0; i < m_insCount; i++) {
+      if (m_ins[i].length == 0)
+        continue;
+      
+      if (opCode(i) == spv::OpFunction)
+        first = i;
+      
+      if (opCode(i) == spv::OpFunctionEnd)
+        this->promoteFunctionVariables(first, i, promote);
+    }
+    
+    // All loads and stores of the remaining
+    // variables have been replaced by now
+    for (uint32_t i = 0; i < m_insCount; i++) {
+      if (m_ins[i].length != 0
+       && opCode(i) == spv::OpVariable
+       && promote[words(i)[2]])
+        this->removeInstruction(i);
+    }
+  }
+  
+  
+  void SpirvOptimizer::promoteFunctionVariables(
+          uint32_t            first,
+          uint32_t            last,
+          std::vector<bool>&  promote) {
+    bool hasVariables = false;
+    
+    for (uint32_t i = first; i <= last && !hasVariables; i++) {
+      if (m_ins[i].length == 0)
+        continue;
+      
+      const uint32_t* w = words(i);
+      
+      hasVariables = (opCode(i) == spv::OpLoad  && promote[w[3]])
+                  || (opCode(i) == spv::OpStore && promote[w[1]]);
+    }
+    
+    if (!hasVariables)
+      return;
+    
+    // If we cannot figure out the control flow of the
+    // function, leave all variables used in it alone
+    Function function;
+    
+    if (!this->buildFunction(first, last, function)) {
+      for (uint32_t i = first; i <= last; i++) {
+        if (m_ins[i].length == 0)
+          continue;
+        
+        if (opCode(i) == spv::OpLoad)  promote[words(i)[3]] = false;
+        if (opCode(i) == spv::OpStore) promote[words(i)[1]] = false;
+      }
+      
+      return;
+    }
+    
+    // Record the value each block leaves in
+    // the variables that are written in it
+    for (auto& block : function.blocks) {
+      for (uint32_t i = block.labelIndex; i <= block.endIndex; i++) {
+        const uint32_t* w = words(i);
+        
+        if (m_ins[i].length != 0 && opCode(i) == spv::OpStore && promote[w[1]])
+          block.exitValues[w[1]] = w[2];
+      }
+    }
+    
+    // Replace loads with the value currently held by the
+    // variable, which may require inserting phi nodes
+    for (uint32_t b = 0; b < function.blocks.size(); b++) {
+      std::unordered_map<uint32_t, uint32_t> values;
+      
+      const uint32_t labelIndex = function.blocks[b].labelIndex;
+      const uint32_t endIndex   = function.blocks[b].endIndex;
+      
+      for (uint32_t i = labelIndex; i <= endIndex; i++) {
+        if (m_ins[i].length == 0)
+          continue;
+        
+        const spv::Op op = opCode(i);
+        
+        if (op == spv::OpStore && promote[words(i)[1]]) {
+          values[words(i)[1]] = words(i)[2];
+          this->removeInstruction(i);
+        } else if (op == spv::OpLoad && promote[words(i)[3]]) {
+          const uint32_t varId = words(i)[3];
+          
+          auto entry = values.find(varId);
+          
+          const uint32_t value = entry != values.end()
+            ? entry->second
+            : this->getBlockEntryValue(function, b, varId);
+          
+          values[varId] = value;
+          this->makeCopy(i, value);
+        }
+      }
+    }
+  }
+  
+  
+  bool SpirvOptimizer::buildFunction(
+          uint32_t            first,
+          uint32_t            last,
+          Function&           function) const {
+    std::vector<std::vector<uint32_t>> succLabels;
+    
+    uint32_t blockId = ~0u;
+    
+    for (uint32_t i = first; i <= last; i++) {
+      if (m_ins[i].length == 0)
+        continue;
+      
+      const spv::Op   op = opCode(i);
+      const uint32_t* w  = words(i);
+      const uint32_t  n  = m_ins[i].length;
+      
+      switch (op) {
+        case spv::OpLabel: {
+          if (blockId != ~0u)
+            return false;
+          
+          blockId = function.blocks.size();
+          function.blocks.emplace_back();
+          function.blocks[blockId].labelIndex = i;
+          function.blockIds.insert({ w[1], blockId });
+          succLabels.emplace_back();
+        } break;
+        
+        case spv::OpBranch:
+        case spv::OpBranchConditional:
+        case spv::OpSwitch:
+        case spv::OpReturn:
+        case spv::OpReturnValue:
+        case spv::OpKill:
+        case spv::OpUnreachable: {
+          if (blockId == ~0u)
+            return false;
+          
+          function.blocks[blockId].endIndex = i;
+          
+          if (op == spv::OpBranch)
+            succLabels[blockId].push_back(w[1]);
+          
+          if (op == spv::OpBranchConditional) {
+            succLabels[blockId].push_back(w[2]);
+            succLabels[blockId].push_back(w[3]);
+          }
+          
+          // Assumes 32-bit selectors, which
+          // is all the DXBC compiler emits
+          if (op == spv::OpSwitch) {
+            succLabels[blockId].push_back(w[2]);
+            
+            for (uint32_t j = 4; j < n; j += 2)
+              succLabels[blockId].push_back(w[j]);
+          }
+          
+          blockId = ~0u;
+        } break;
+        
+        default:
+          break;
+      }
+    }
+    
+    if (blockId != ~0u || function.blocks.empty())
+      return false;
+    
+    for (uint32_t b = 0; b < function.blocks.size(); b++) {
+      for (uint32_t label : succLabels[b]) {
+        auto entry = function.blockIds.find(label);
+        
+        if (entry == function.blockIds.end())
+          return false;
+        
+        auto& succs = function.blocks[b].succs;
+        
+        if (std::find(succs.begin(), succs.end(), entry->second) == succs.end()) {
+          succs.push_back(entry->second);
+          function.blocks[entry->second].preds.push_back(b);
+        }
+      }
+    }
+    
+    // Values in unreachable blocks are undefined
+    std::vector<uint32_t> worklist = { 0 };
+    function.blocks[0].reachable = true;
+    
+    while (!worklist.empty()) {
+      const uint32_t b = worklist.back();
+      worklist.pop_back();
+      
+      for (uint32_t s : function.blocks[b].succs) {
+        if (!function.blocks[s].reachable) {
+          function.blocks[s].reachable = true;
+          worklist.push_back(s);
+        }
+      }
+    }
+    
+    return true;
+  }
+  
+  
+  uint32_t SpirvOptimizer::getBlockEntryValue(
+          Function&           function,
+          uint32_t            blockId,
+          uint32_t            varId) {
+    const uint64_t key = (uint64_t(blockId) << 32) | varId;
+    
+    auto entry = function.entryValues.find(key);
+    
+    if (entry != function.entryValues.end())
+      return entry->second;
+    
+    const Block& block = function.blocks[blockId];
+    
+    uint32_t value = 0;
+    
+    if (!block.reachable || blockId == 0) {
+      value = this->getInitialValue(varId);
+    } else if (block.preds.size() == 1) {
+      value = this->getBlockExitValue(function, block.preds[0], varId);
+    } else {
+      // Register the phi before resolving its operands
+      // so that loops back to this block terminate
+      const uint32_t typeId = getDef(getDef(varId)[1])[3];
+      
+      value = this->allocateId();
+      function.entryValues.insert({ key, value });
+      
+      std::vector<uint32_t> phi = { 0, typeId, value };
+      
+      for (uint32_t pred : block.preds) {
+        phi.push_back(this->getBlockExitValue(function, pred, varId));
+        phi.push_back(words(function.blocks[pred].labelIndex)[1]);
+      }
+      
+      phi[0] = uint32_t(spv::OpPhi) | (uint32_t(phi.size()) << spv::WordCountShift);
+      
+      m_insertions[block.labelIndex].push_back(this->addInstruction(phi));
+    }
+    
+    function.entryValues[key] = value;
+    return value;
+  }
+  
+  
+  uint32_t SpirvOptimizer::getBlockExitValue(
+          Function&           function,
+          uint32_t            blockId,
+          uint32_t            varId) {
+    const auto& exitValues = function.blocks[blockId].exitValues;
+    
+    auto entry = exitValues.find(varId);
+    
+    return entry != exitValues.end()
+      ? entry->second
+      : this->getBlockEntryValue(function, blockId, varId);
+  }
+  
+  
+  uint32_t SpirvOptimizer::getInitialValue(
+          uint32_t            varId) {
+    const uint32_t* def = getDef(varId);
+    
+    if (getLength(def) >= 5)
+      return def[4];
+    
+    const uint32_t typeId = getDef(def[1])[3];
+    return this->defineConstant(spv::OpUndef, typeId, 0, nullptr);
+  }
+  
+  
+  void SpirvOptimizer::forwardLoadsAndStores() {
+    std::vector<bool> variables;
+    this->findLocalVariables(variables);
+    
+    // Value currently held by each variable, and the most
+    // recent store to each variable within the block. The
+    // stored value is always available to subsequent loads
+    // in the same block, so these loads can be replaced.
+    std::unordered_map<uint32_t, uint32_t> values;
+    std::unordered_map<uint32_t, uint32_t> stores;
+    
+    for (uint32_t i = 0; i < m_insCount; i++) {
+      if (m_ins[i].length == 0)
+        continue;
+      
+      const uint32_t* w = words(i);
+      
+      switch (opCode(i)) {
+        // Functions may read or write private variables, so
+        // any knowledge about variable contents is lost here
+        case spv::OpLabel:
+        case spv::OpFunction:
+        case spv::OpFunctionEnd:
+        case spv::OpFunctionCall:
+          values.clear();
+          stores.clear();
+          break;
+        
+        case spv::OpLoad: {
+          if (!variables[w[3]])
+            break;
+          
+          auto value = values.find(w[3]);
+          
+          if (value != values.end()) {
+            this->makeCopy(i, value->second);
+          } else {
+            values.insert({ w[3], w[2] });
+            stores.erase(w[3]);
+          }
+        } break;
+        
+        case spv::OpStore: {
+          if (!variables[w[1]])
+            break;
+          
+          // If the variable has been written before within
+          // the block without being read from memory, the
+          // previous store is dead and can be removed.
+          auto store = stores.find(w[1]);
+          
+          if (store != stores.end())
+            this->removeInstruction(store->second);
+          
+          values[w[1]] = w[2];
+          stores[w[1]] = i;
+        } break;
+        
+        default:
+          break;
+      }
+    }
+  }
+  
+  
+  void SpirvOptimizer::propagateCopies() {
+    for (uint32_t i = 0; i < m_ins.size(); i++) {
+      Layout layout;
+      
+      if (m_ins[i].length == 0
+       || !getLayout(words(i), layout)
+       || layout.isDebug)
+        continue;
+      
+      this->forEachId(i, false, [this] (uint32_t& id) {
+        const uint32_t* def = this->getDef(id);
+        
+        while (def != nullptr && getOpCode(def) == spv::OpCopyObject) {
+          id  = def[3];
+          def = this->getDef(id);
+        }
+      });
+    }
+  }
+  
+  
+  bool SpirvOptimizer::simplifyInstructions() {
+    bool progress = false;
+    
+    for (uint32_t i = 0; i < m_ins.size(); i++) {
+      if (m_ins[i].length == 0)
+        continue;
+      
+      switch (opCode(i)) {
+        case spv::OpBitcast:            progress |= this->simplifyBitcast(i);            break;
+        case spv::OpCompositeExtract:   progress |= this->simplifyCompositeExtract(i);   break;
+        case spv::OpCompositeConstruct: progress |= this->simplifyCompositeConstruct(i); break;
+        case spv::OpVectorShuffle:      progress |= this->simplifyVectorShuffle(i);      break;
+        case spv::OpSelect:             progress |= this->simplifySelect(i);             break;
+        case spv::OpPhi:                progress |= this->simplifyPhi(i);                break;
+        default: break;
+      }
+    }
+    
+    return progress;
+  }
+  
+  
+  void SpirvOptimizer::eliminateDeadCode() {
+    // Remove private and function variables that are never
+    // read, along with all stores to those variables
+    std::vector<bool> variables;
+    this->findLocalVariables(variables);
+    
+    std::vector<uint32_t> loadCounts(m_bound, 0);
+    
+    for (uint32_t i = 0; i < m_insCount; i++) {
+      if (m_ins[i].length != 0 && opCode(i) == spv::OpLoad)
+        loadCounts[words(i)[3]] += 1;
+    }
+    
+    for (uint32_t i = 0; i < m_insCount; i++) {
+      if (m_ins[i].length == 0)
+        continue;
+      
+      const spv::Op   op = opCode(i);
+      const uint32_t* w  = words(i);
+      
+      if ((op == spv::OpStore    && variables[w[1]] && !loadCounts[w[1]])
+       || (op == spv::OpVariable && variables[w[2]] && !loadCounts[w[2]]))
+        this->removeInstruction(i);
+    }
+    
+    // Remove instructions without side effects whose results
+    // are never used. Debug instructions do not count as use.
+    std::vector<uint32_t> useCounts(m_bound, 0);
+    
+    for (uint32_t i = 0; i < m_ins.size(); i++) {
+      Layout layout;
+      
+      if (m_ins[i].length == 0
+       || (getLayout(words(i), layout) && layout.isDebug))
+        continue;
+      
+      this->forEachId(i, true, [&] (uint32_t id) {
+        if (id < m_bound)
+          useCounts[id] += 1;
+      });
+    }
+    
+    std::vector<uint32_t> worklist;
+    
+    for (uint32_t i = 0; i < m_ins.size(); i++) {
+      Layout layout;
+      
+      if (m_ins[i].length != 0
+       && getLayout(words(i), layout)
+       && layout.isPure && !useCounts[getResultId(i)])
+        worklist.push_back(i);
+    }
+    
+    while (!worklist.empty()) {
+      const uint32_t index = worklist.back();
+      worklist.pop_back();
+      
+      if (m_ins[index].length == 0)
+        continue;
+      
+      this->forEachId(index, true, [&] (uint32_t id) {
+        if (id >= m_bound || --useCounts[id] != 0)
+          return;
+        
+        const uint32_t def = m_defs[id];
+        Layout layout;
+        
+        if (def != ~0u && m_ins[def].length != 0
+         && getLayout(words(def), layout) && layout.isPure)
+          worklist.push_back(def);
+      });
+      
+      this->removeInstruction(index);
+    }
+    
+    // Names and decorations must not refer to removed IDs
+    for (uint32_t i = 0; i < m_insCount; i++) {
+      Layout layout;
+      
+      if (m_ins[i].length != 0
+       && getLayout(words(i), layout) && layout.isDebug
+       && words(i)[1] < m_bound && m_removed[words(i)[1]])
+        m_ins[i].length = 0;
+    }
+  }
+  
+  
+  bool SpirvOptimizer::simplifyBitcast(uint32_t index) {
+    uint32_t* w = words(index);
+    
+    const uint32_t typeId = w[1];
+    bool progress = false;
+    
+    // Bit-casting the result of another bit-cast
+    // is the same as casting the original value
+    const uint32_t* def = getDef(w[3]);
+    
+    while (def != nullptr && getOpCode(def) == spv::OpBitcast) {
+      w[3] = def[3];
+      def  = getDef(w[3]);
+      progress = true;
+    }
+    
+    const uint32_t srcId = w[3];
+    
+    if (getTypeId(srcId) == typeId) {
+      this->makeCopy(index, srcId);
+      return true;
+    }
+    
+    if (def == nullptr)
+      return progress;
+    
+    // Constants can be re-interpreted directly, as long as all
+    // components are 32-bit scalars on both ends of the cast
+    if (getOpCode(def) == spv::OpConstant && getLength(def) == 4
+     && is32BitScalarType(typeId) && is32BitScalarType(def[1])) {
+      const uint32_t bits = def[3];
+      this->makeCopy(index, defineConstant(spv::OpConstant, typeId, 1, &bits));
+      return true;
+    }
+    
+    uint32_t componentCount = 0;
+    uint32_t componentType  = getVectorComponentType(typeId, componentCount);
+    
+    if (getOpCode(def) != spv::OpConstantComposite
+     || getLength(def) != 3 + componentCount
+     || componentCount > 4
+     || !is32BitScalarType(componentType))
+      return progress;
+    
+    std::array<uint32_t, 4> bits;
+    
+    for (uint32_t i = 0; i < componentCount; i++) {
+      const uint32_t* component = getDef(def[3 + i]);
+      
+      if (component == nullptr
+       || getOpCode(component) != spv::OpConstant
+       || getLength(component) != 4
+       || !is32BitScalarType(component[1]))
+        return progress;
+      
+      bits[i] = component[3];
+    }
+    
+    std::array<uint32_t, 4> components;
+    
+    for (uint32_t i = 0; i < componentCount; i++)
+      components[i] = defineConstant(spv::OpConstant, componentType, 1, &bits[i]);
+    
+    this->makeCopy(index, defineConstant(spv::OpConstantComposite,
+      typeId, componentCount, components.data()));
+    return true;
+  }
+  
+  
+  bool SpirvOptimizer::simplifyCompositeExtract(uint32_t index) {
+    if (m_ins[index].length != 5)
+      return false;
+    
+    uint32_t* w = words(index);
+    
+    const uint32_t  member = w[4];
+    const uint32_t* def    = getDef(w[3]);
+    
+    if (def == nullptr)
+      return false;
+    
+    switch (getOpCode(def)) {
+      case spv::OpConstantComposite:
+      case spv::OpCompositeConstruct: {
+        // Vectors can be constructed from smaller vectors,
+        // in which case members do not map to operands
+        uint32_t componentCount = 0;
+        
+        if (getVectorComponentType(def[1], componentCount)
+         && getLength(def) != 3 + componentCount)
+          return false;
+        
+        if (member >= getLength(def) - 3)
+          return false;
+        
+        this->makeCopy(index, def[3 + member]);
+      } return true;
+      
+      case spv::OpVectorShuffle: {
+        if (member >= getLength(def) - 5 || def[5 + member] == ~0u)
+          return false;
+        
+        uint32_t componentCount = 0;
+        
+        if (!getVectorComponentType(getTypeId(def[3]), componentCount))
+          return false;
+        
+        const uint32_t component = def[5 + member];
+        
+        if (component < componentCount) {
+          w[3] = def[3];
+          w[4] = component;
+        } else {
+          w[3] = def[4];
+          w[4] = component - componentCount;
+        }
+      } return true;
+      
+      case spv::OpCompositeInsert: {
+        if (getLength(def) != 6)
+          return false;
+        
+        if (def[5] == member)
+          this->makeCopy(index, def[3]);
+        else
+          w[3] = def[4];
+      } return true;
+      
+      default:
+        return false;
+    }
+  }
+  
+  
+  bool SpirvOptimizer::simplifyCompositeConstruct(uint32_t index) {
+    const uint32_t* w = words(index);
+    
+    uint32_t componentCount = 0;
+    
+    if (!getVectorComponentType(w[1], componentCount)
+     || m_ins[index].length != 3 + componentCount
+     || componentCount > 4)
+      return false;
+    
+    // Re-assembling a vector from its own components
+    const uint32_t* first = getDef(w[3]);
+    
+    if (first != nullptr
+     && getOpCode(first) == spv::OpCompositeExtract
+     && getLength(first) == 5
+     && getTypeId(first[3]) == w[1]) {
+      bool identity = true;
+      
+      for (uint32_t i = 0; i < componentCount && identity; i++) {
+        const uint32_t* def = getDef(w[3 + i]);
+        
+        identity = def != nullptr
+          && getOpCode(def) == spv::OpCompositeExtract
+          && getLength(def) == 5
+          && def[3] == first[3]
+          && def[4] == i;
+      }
+      
+      if (identity) {
+        this->makeCopy(index, first[3]);
+        return true;
+      }
+    }
+    
+    // Vectors built from constant scalars are constant
+    std::array<uint32_t, 4> components;
+    
+    for (uint32_t i = 0; i < componentCount; i++) {
+      if (!isScalarConstant(w[3 + i]))
+        return false;
+      
+      components[i] = w[3 + i];
+    }
+    
+    const uint32_t typeId = w[1];
+    
+    this->makeCopy(index, defineConstant(spv::OpConstantComposite,
+      typeId, componentCount, components.data()));
+    return true;
+  }
+  
+  
+  bool SpirvOptimizer::simplifyVectorShuffle(uint32_t index) {
+    const uint32_t* w = words(index);
+    
+    uint32_t countA = 0;
+    uint32_t countB = 0;
+    uint32_t countR = 0;
+    
+    if (!getVectorComponentType(getTypeId(w[3]), countA)
+     || !getVectorComponentType(getTypeId(w[4]), countB)
+     || !getVectorComponentType(w[1], countR)
+     || m_ins[index].length != 5 + countR
+     || countR > 4)
+      return false;
+    
+    // Shuffles that return one of the vectors unmodified
+    bool identityA = getTypeId(w[3]) == w[1];
+    bool identityB = getTypeId(w[4]) == w[1];
+    
+    for (uint32_t i = 0; i < countR; i++) {
+      identityA &= w[5 + i] == i;
+      identityB &= w[5 + i] == i + countA;
+    }
+    
+    if (identityA || identityB) {
+      this->makeCopy(index, identityA ? w[3] : w[4]);
+      return true;
+    }
+    
+    // Shuffles of constant vectors are constant
+    if (!isCompositeConstant(w[3]) || !isCompositeConstant(w[4]))
+      return false;
+    
+    const uint32_t* a = getDef(w[3]);
+    const uint32_t* b = getDef(w[4]);
+    
+    if (getLength(a) != 3 + countA || getLength(b) != 3 + countB)
+      return false;
+    
+    std::array<uint32_t, 4> components;
+    
+    for (uint32_t i = 0; i < countR; i++) {
+      const uint32_t component = w[5 + i];
+      
+      if (component >= countA + countB)
+        return false;
+      
+      components[i] = component < countA
+        ? a[3 + component]
+        : b[3 + component - countA];
+    }
+    
+    const uint32_t typeId = w[1];
+    
+    this->makeCopy(index, defineConstant(spv::OpConstantComposite,
+      typeId, countR, components.data()));
+    return true;
+  }
+  
+  
+  bool SpirvOptimizer::simplifySelect(uint32_t index) {
+    const uint32_t* w = words(index);
+    
+    if (w[4] == w[5]) {
+      this->makeCopy(index, w[4]);
+      return true;
+    }
+    
+    // Vector conditions can be folded if all
+    // components select the same operand
+    const uint32_t* def = getDef(w[3]);
+    
+    if (def == nullptr)
+      return false;
+    
+    spv::Op condition = getOpCode(def);
+    
+    if (condition == spv::OpConstantComposite) {
+      const uint32_t* first = getDef(def[3]);
+      
+      if (first == nullptr)
+        return false;
+      
+      condition = getOpCode(first);
+      
+      for (uint32_t i = 4; i < getLength(def); i++) {
+        const uint32_t* component = getDef(def[i]);
+        
+        if (component == nullptr || getOpCode(component) != condition)
+          return false;
+      }
+    }
+    
+    if (condition == spv::OpConstantTrue) {
+      this->makeCopy(index, w[4]);
+      return true;
+    }
+    
+    if (condition == spv::OpConstantFalse) {
+      this->makeCopy(index, w[5]);
+      return true;
+    }
+    
+    return false;
+  }
+  
+  
+  bool SpirvOptimizer::simplifyPhi(uint32_t index) {
+    const uint32_t* w = words(index);
+    
+    // Phis that merge a single value, or a single value and
+    // the phi itself in case of loops, are not needed
+    uint32_t value = 0;
+    
+    for (uint32_t i = 3; i < m_ins[index].length; i += 2) {
+      if (w[i] == w[2] || w[i] == value)
+        continue;
+      
+      if (value != 0)
+        return false;
+      
+      value = w[i];
+    }
+    
+    if (value == 0)
+      return false;
+    
+    this->makeCopy(index, value);
+    return true;
+  }
+  
+  
+  void SpirvOptimizer::findLocalVariables(
+          std::vector<bool>&  variables) {
+    variables.assign(m_bound, false);
+    
+    for (uint32_t i = 0; i < m_insCount; i++) {
+      if (m_ins[i].length == 0 || opCode(i) != spv::OpVariable)
+        continue;
+      
+      const uint32_t* w = words(i);
+      
+      if (w[3] == spv::StorageClassPrivate
+       || w[3] == spv::StorageClassFunction)
+        variables[w[2]] = true;
+    }
+    
+    // Variables that are accessed through anything other than
+    // a plain load or store, e.g. access chains, or passed to
+    // functions, cannot be tracked and are ignored entirely.
+    std::vector<bool> escaped(m_bound, false);
+    
+    for (uint32_t i = 0; i < m_insCount; i++) {
+      if (m_ins[i].length == 0)
+        continue;
+      
+      const spv::Op   op = opCode(i);
+      const uint32_t* w  = words(i);
+      
+      if (op == spv::OpLoad)
+        continue;
+      
+      if (op == spv::OpStore) {
+        if (w[2] < m_bound)
+          escaped[w[2]] = true;
+        continue;
+      }
+      
+      Layout layout;
+      
+      if (getLayout(w, layout) && layout.isDebug)
+        continue;
+      
+      this->forEachId(i, true, [&] (uint32_t id) {
+        if (id < m_bound)
+          escaped[id] = true;
+      });
+    }
+    
+    for (uint32_t i = 0; i < m_bound; i++)
+      variables[i] = variables[i] && !escaped[i];
+  }
+  
+  
+  void SpirvOptimizer::updateDefs() {
+    m_defs.assign(m_bound, ~0u);
+    
+    for (uint32_t i = 0; i < m_ins.size(); i++) {
+      if (m_ins[i].length == 0)
+        continue;
+      
+      const uint32_t id = getResultId(i);
+      
+      if (id != 0 && id < m_bound)
+        m_defs[id] = i;
+    }
+  }
+  
+  
+  uint32_t SpirvOptimizer::defineConstant(
+          spv::Op             op,
+          uint32_t            typeId,
+          uint32_t            argCount,
+    const uint32_t*           args) {
+    std::vector<uint32_t> key = { uint32_t(op), typeId };
+    key.insert(key.end(), args, args + argCount);
+    
+    auto entry = m_constants.find(key);
+    
+    if (entry != m_constants.end())
+      return entry->second;
+    
+    const uint32_t resultId = this->allocateId();
+    
+    std::vector<uint32_t> ins = { uint32_t(op) | ((3 + argCount) << spv::WordCountShift), typeId, resultId };
+    ins.insert(ins.end(), key.begin() + 2, key.end());
+    m_globals.push_back(this->addInstruction(ins));
+    
+    m_constants.insert({ key, resultId });
+    return resultId;
+  }
+  
+  
+  uint32_t SpirvOptimizer::addInstruction(
+    const std::vector<uint32_t>& words) {
+    const uint32_t index = m_ins.size();
+    
+    m_ins.push_back({ uint32_t(m_words.size()), uint32_t(words.size()) });
+    m_words.insert(m_words.end(), words.begin(), words.end());
+    
+    const uint32_t id = getResultId(index);
+    
+    if (id != 0 && id < m_bound)
+      m_defs[id] = index;
+    
+    return index;
+  }
+  
+  
+  uint32_t SpirvOptimizer::allocateId() {
+    m_defs.push_back(~0u);
+    m_removed.push_back(false);
+    return m_bound++;
+  }
+  
+  
+  uint32_t SpirvOptimizer::getVectorComponentType(
+          uint32_t            typeId,
+          uint32_t&           count) const {
+    const uint32_t* def = getDef(typeId);
+    
+    if (def == nullptr || getOpCode(def) != spv::OpTypeVector)
+      return 0;
+    
+    count = def[3];
+    return def[2];
+  }
+  
+  
+  bool SpirvOptimizer::is32BitScalarType(
+          uint32_t            typeId) const {
+    const uint32_t* def = getDef(typeId);
+    
+    return def != nullptr
+        && (getOpCode(def) == spv::OpTypeInt || getOpCode(def) == spv::OpTypeFloat)
+        && def[2] == 32;
+  }
+  
+  
+  bool SpirvOptimizer::isScalarConstant(
+          uint32_t            id) const {
+    const uint32_t* def = getDef(id);
+    
+    return def != nullptr
+        && (getOpCode(def) == spv::OpConstant
+         || getOpCode(def) == spv::OpConstantTrue
+         || getOpCode(def) == spv::OpConstantFalse);
+  }
+  
+  
+  bool SpirvOptimizer::isCompositeConstant(
+          uint32_t            id) const {
+    const uint32_t* def = getDef(id);
+    
+    return def != nullptr
+        && getOpCode(def) == spv::OpConstantComposite;
+  }
+  
+  
+  const uint32_t* SpirvOptimizer::getDef(
+          uint32_t            id) const {
+    if (id >= m_defs.size() || m_defs[id] == ~0u)
+      return nullptr;
+    
+    const uint32_t index = m_defs[id];
+    
+    return m_ins[index].length != 0
+      ? words(index)
+      : nullptr;
+  }
+  
+  
+  uint32_t SpirvOptimizer::getTypeId(
+          uint32_t            id) const {
+    const uint32_t* def = getDef(id);
+    Layout layout;
+    
+    if (def == nullptr
+     || !getLayout(def, layout)
+     || !layout.hasType)
+      return 0;
+    
+    return def[1];
+  }
+  
+  
+  void SpirvOptimizer::makeCopy(
+          uint32_t            index,
+          uint32_t            valueId) {
+    // All instructions that can be replaced with a copy have a
+    // result type and ID, followed by at least one operand
+    uint32_t* w = words(index);
+    w[0] = uint32_t(spv::OpCopyObject) | (4u << spv::WordCountShift);
+    w[3] = valueId;
+    
+    m_ins[index].length = 4;
+  }
+  
+  
+  void SpirvOptimizer::removeInstruction(
+          uint32_t            index) {
+    const uint32_t id = getResultId(index);
+    
+    if (id != 0 && id < m_bound)
+      m_removed[id] = true;
+    
+    m_ins[index].length = 0;
+  }
+  
+  
+  uint32_t SpirvOptimizer::getResultId(uint32_t index) const {
+    Layout layout;
+    
+    if (!getLayout(words(index), layout) || !layout.hasResult)
+      return 0;
+    
+    return words(index)[layout.hasType ? 2 : 1];
+  }
+  
+  
+  bool SpirvOptimizer::getLayout(
+    const uint32_t*           ins,
+          Layout&             layout) {
+    layout = Layout();
+    
+    switch (getOpCode(ins)) {
+      // Operations without side effects where
+      // all operands are IDs of other values
+      case spv::OpConvertFToU:
+      case spv::OpConvertFToS:
+      case spv::OpConvertSToF:
+      case spv::OpConvertUToF:
+      case spv::OpBitcast:
+      case spv::OpSNegate:
+      case spv::OpFNegate:
+      case spv::OpIAdd:
+      case spv::OpFAdd:
+      case spv::OpISub:
+      case spv::OpFSub:
+      case spv::OpIMul:
+      case spv::OpFMul:
+      case spv::OpUDiv:
+      case spv::OpSDiv:
+      case spv::OpFDiv:
+      case spv::OpUMod:
+      case spv::OpSRem:
+      case spv::OpSMod:
+      case spv::OpFRem:
+      case spv::OpFMod:
+      case spv::OpVectorTimesScalar:
+      case spv::OpDot:
+      case spv::OpAny:
+      case spv::OpAll:
+      case spv::OpIsNan:
+      case spv::OpIsInf:
+      case spv::OpLogicalEqual:
+      case spv::OpLogicalNotEqual:
+      case spv::OpLogicalOr:
+      case spv::OpLogicalAnd:
+      case spv::OpLogicalNot:
+      case spv::OpSelect:
+      case spv::OpIEqual:
+      case spv::OpINotEqual:
+      case spv::OpUGreaterThan:
+      case spv::OpSGreaterThan:
+      case spv::OpUGreaterThanEqual:
+      case spv::OpSGreaterThanEqual:
+      case spv::OpULessThan:
+      case spv::OpSLessThan:
+      case spv::OpULessThanEqual:
+      case spv::OpSLessThanEqual:
+      case spv::OpFOrdEqual:
+      case spv::OpFOrdNotEqual:
+      case spv::OpFOrdLessThan:
+      case spv::OpFOrdGreaterThan:
+      case spv::OpFOrdLessThanEqual:
+      case spv::OpFOrdGreaterThanEqual:
+      case spv::OpShiftRightLogical:
+      case spv::OpShiftRightArithmetic:
+      case spv::OpShiftLeftLogical:
+      case spv::OpBitwiseOr:
+      case spv::OpBitwiseXor:
+      case spv::OpBitwiseAnd:
+      case spv::OpNot:
+      case spv::OpBitFieldInsert:
+      case spv::OpBitFieldSExtract:
+      case spv::OpBitFieldUExtract:
+      case spv::OpBitReverse:
+      case spv::OpBitCount:
+      case spv::OpDPdx:
+      case spv::OpDPdy:
+      case spv::OpFwidth:
+      case spv::OpDPdxFine:
+      case spv::OpDPdyFine:
+      case spv::OpFwidthFine:
+      case spv::OpDPdxCoarse:
+      case spv::OpDPdyCoarse:
+      case spv::OpFwidthCoarse:
+      case spv::OpCompositeConstruct:
+      case spv::OpCopyObject:
+      case spv::OpAccessChain:
+      case spv::OpInBoundsAccessChain:
+      case spv::OpSampledImage:
+      case spv::OpImage:
+      case spv::OpImageQuerySizeLod:
+      case spv::OpImageQuerySize:
+      case spv::OpImageQueryLod:
+      case spv::OpImageQueryLevels:
+      case spv::OpImageQuerySamples:
+      case spv::OpImageTexelPointer:
+      case spv::OpPhi:
+      case spv::OpConstantComposite:
+        layout.isPure  = true;
+        /* fall through */
+      
+      case spv::OpFunctionCall:
+      case spv::OpAtomicLoad:
+      case spv::OpAtomicExchange:
+      case spv::OpAtomicCompareExchange:
+      case spv::OpAtomicIIncrement:
+      case spv::OpAtomicIDecrement:
+      case spv::OpAtomicIAdd:
+      case spv::OpAtomicISub:
+      case spv::OpAtomicSMin:
+      case spv::OpAtomicUMin:
+      case spv::OpAtomicSMax:
+      case spv::OpAtomicUMax:
+      case spv::OpAtomicAnd:
+      case spv::OpAtomicOr:
+      case spv::OpAtomicXor:
+      case spv::OpSpecConstantComposite:
+        layout.hasType   = true;
+        layout.hasResult = true;
+        layout.idFirst   = 3;
+        layout.idCount   = ~0u;
+        return true;
+      
+      // Operations with literal operands
+      case spv::OpLoad:
+      case spv::OpCompositeExtract:
+        layout.hasType   = true;
+        layout.hasResult = true;
+        layout.isPure    = true;
+        layout.idFirst   = 3;
+        layout.idCount   = 1;
+        return true;
+      
+      case spv::OpCompositeInsert:
+      case spv::OpVectorShuffle:
+        layout.hasType   = true;
+        layout.hasResult = true;
+        layout.isPure    = true;
+        layout.idFirst   = 3;
+        layout.idCount   = 2;
+        return true;
+      
+      case spv::OpExtInst:
+        layout.hasType   = true;
+        layout.hasResult = true;
+        layout.isPure    = true;
+        layout.idFirst   = 3;
+        layout.idCount   = 1;
+        layout.tailFirst = 5;
+        return true;
+      
+      // Image operations, followed by an optional
+      // image operand mask and additional operands
+      case spv::OpImageSampleImplicitLod:
+      case spv::OpImageSampleExplicitLod:
+      case spv::OpImageFetch:
+      case spv::OpImageRead:
+        layout.hasType   = true;
+        layout.hasResult = true;
+        layout.isPure    = true;
+        layout.idFirst   = 3;
+        layout.idCount   = 2;
+        layout.tailFirst = 6;
+        return true;
+      
+      case spv::OpImageSampleDrefImplicitLod:
+      case spv::OpImageSampleDrefExplicitLod:
+      case spv::OpImageGather:
+      case spv::OpImageDrefGather:
+        layout.hasType   = true;
+        layout.hasResult = true;
+        layout.isPure    = true;
+        layout.idFirst   = 3;
+        layout.idCount   = 3;
+        layout.tailFirst = 7;
+        return true;
+      
+      case spv::OpImageWrite:
+        layout.idFirst   = 1;
+        layout.idCount   = 3;
+        layout.tailFirst = 5;
+        return true;
+      
+      // Declarations. Unused constants can be removed,
+      // but specialization constants are part of the
+      // shader interface and must be preserved.
+      case spv::OpConstant:
+      case spv::OpConstantTrue:
+      case spv::OpConstantFalse:
+      case spv::OpConstantNull:
+      case spv::OpUndef:
+        layout.hasType   = true;
+        layout.hasResult = true;
+        layout.isPure    = true;
+        return true;
+      
+      case spv::OpSpecConstant:
+      case spv::OpSpecConstantTrue:
+      case spv::OpSpecConstantFalse:
+      case spv::OpFunctionParameter:
+        layout.hasType   = true;
+        layout.hasResult = true;
+        return true;
+      
+      case spv::OpVariable:
+      case spv::OpFunction:
+        layout.hasType   = true;
+        layout.hasResult = true;
+        layout.idFirst   = 4;
+        layout.idCount   = 1;
+        return true;
+      
+      case spv::OpLabel:
+      case spv::OpExtInstImport:
+      case spv::OpString:
+      case spv::OpTypeVoid:
+      case spv::OpTypeBool:
+      case spv::OpTypeInt:
+      case spv::OpTypeFloat:
+      case spv::OpTypeSampler:
+        layout.hasResult = true;
+        return true;
+      
+      case spv::OpTypeVector:
+      case spv::OpTypeMatrix:
+      case spv::OpTypeImage:
+      case spv::OpTypeSampledImage:
+      case spv::OpTypeRuntimeArray:
+        layout.hasResult = true;
+        layout.idFirst   = 2;
+        layout.idCount   = 1;
+        return true;
+      
+      case spv::OpTypeArray:
+        layout.hasResult = true;
+        layout.idFirst   = 2;
+        layout.idCount   = 2;
+        return true;
+      
+      case spv::OpTypeStruct:
+      case spv::OpTypeFunction:
+        layout.hasResult = true;
+        layout.idFirst   = 2;
+        layout.idCount   = ~0u;
+        return true;
+      
+      case spv::OpTypePointer:
+        layout.hasResult = true;
+        layout.idFirst   = 3;
+        layout.idCount   = 1;
+        return true;
+      
+      // Instructions without a result
+      case spv::OpStore:
+      case spv::OpLoopMerge:
+      case spv::OpSwitch:
+        layout.idFirst   = 1;
+        layout.idCount   = 2;
+        return true;
+      
+      case spv::OpBranch:
+      case spv::OpSelectionMerge:
+      case spv::OpReturnValue:
+      case spv::OpEmitStreamVertex:
+      case spv::OpEndStreamPrimitive:
+        layout.idFirst   = 1;
+        layout.idCount   = 1;
+        return true;
+      
+      case spv::OpBranchConditional:
+        layout.idFirst   = 1;
+        layout.idCount   = 3;
+        return true;
+      
+      case spv::OpAtomicStore:
+      case spv::OpControlBarrier:
+      case spv::OpMemoryBarrier:
+        layout.idFirst   = 1;
+        layout.idCount   = ~0u;
+        return true;
+      
+      case spv::OpReturn:
+      case spv::OpKill:
+      case spv::OpUnreachable:
+      case spv::OpEmitVertex:
+      case spv::OpEndPrimitive:
+      case spv::OpFunctionEnd:
+        return true;
+      
+      // Module-level instructions
+      case spv::OpCapability:
+      case spv::OpExtension:
+      case spv::OpMemoryModel:
+      case spv::OpSource:
+      case spv::OpSourceExtension:
+        return true;
+      
+      case spv::OpExecutionMode:
+        layout.idFirst   = 1;
+        layout.idCount   = 1;
+        return true;
+      
+      case spv::OpEntryPoint: {
+        // The interface IDs follow the entry point name
+        uint32_t nameEnd = 3;
+        
+        while (nameEnd < getLength(ins) && !hasNullByte(ins[nameEnd]))
+          nameEnd += 1;
+        
+        layout.idFirst   = 2;
+        layout.idCount   = 1;
+        layout.tailFirst = nameEnd + 1;
+      } return true;
+      
+      // Debug instructions and annotations
+      case spv::OpName:
+      case spv::OpMemberName:
+      case spv::OpDecorate:
+      case spv::OpMemberDecorate:
+        layout.isDebug   = true;
+        layout.idFirst   = 1;
+        layout.idCount   = 1;
+        return true;
+      
+      default:
+        return false;
+    }
+  }
+  
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "spirv_code_buffer.h"
+
+namespace dxvk {
+  
+  /**
+   * \brief SPIR-V optimizer
+   * 
+   * Removes some of the redundancy that the DXBC compiler
+   * generates, so that drivers do not have to do so every
+   * time a pipeline is compiled. Variables that are only
+   * accessed through plain loads and stores are promoted
+   * to SSA values where possible. The remaining passes
+   * remove redundant loads and stores within a block,
+   * bit-cast chains, operations on constant values, and
+   * dead code.
+   * 
+   * The optimizer does not understand every instruction.
+   * Instructions it does not know are left untouched, and
+   * any ID they might reference is treated as being used.
+   */
+  class SpirvOptimizer {
+    
+  public:
+    
+    SpirvOptimizer(const SpirvCodeBuffer& code);
+    ~SpirvOptimizer();
+    
+    /**
+     * \brief Runs all optimization passes
+     */
+    void run();
+    
+    /**
+     * \brief Retrieves optimized code
+     * \returns Code buffer for the optimized module
+     */
+    SpirvCodeBuffer getCode() const;
+    
+  private:
+    
+    struct Instruction {
+      uint32_t offset;
+      uint32_t length;
+    };
+    
+    struct Layout {
+      bool     hasType    = false;
+      bool     hasResult  = false;
+      bool     isPure     = false;
+      bool     isDebug    = false;
+      uint32_t idFirst    = 0;
+      uint32_t idCount    = 0;
+      uint32_t tailFirst  = 0;
+    };
+    
+    struct Block {
+      uint32_t              labelIndex = 0;
+      uint32_t              endIndex   = 0;
+      bool                  reachable  = false;
+      std::vector<uint32_t> preds;
+      std::vector<uint32_t> succs;
+      std::unordered_map<uint32_t, uint32_t> exitValues;
+    };
+    
+    struct Function {
+      std::vector<Block>                     blocks;
+      std::unordered_map<uint32_t, uint32_t> blockIds;
+      std::unordered_map<uint64_t, uint32_t> entryValues;
+    };
+    
+    std::vector<uint32_t>     m_words;
+    std::vector<Instruction>  m_ins;
+    
+    uint32_t m_bound    = 0;
+    uint32_t m_insCount = 0;
+    
+    std::vector<uint32_t>     m_defs;
+    std::vector<bool>         m_removed;
+    
+    std::map<std::vector<uint32_t>, uint32_t> m_constants;
+    
+    std::vector<uint32_t> m_globals;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_insertions;
+    
+    void promoteVariables();
+    
+    void promoteFunctionVariables(
+            uint32_t            first,
+            uint32_t            last,
+            std::vector<bool>&  promote);
+    
+    bool buildFunction(
+            uint32_t            first,
+            uint32_t            last,
+            Function&           function) const;
+    
+    uint32_t getBlockEntryValue(
+            Function&           function,
+            uint32_t            blockId,
+            uint32_t            varId);
+    
+    uint32_t getBlockExitValue(
+            Function&           function,
+            uint32_t            blockId,
+            uint32_t            varId);
+    
+    uint32_t getInitialValue(
+            uint32_t            varId);
+    
+    void forwardLoadsAndStores();
+    
+    void propagateCopies();
+    
+    bool simplifyInstructions();
+    
+    void eliminateDeadCode();
+    
+    bool simplifyBitcast(uint32_t index);
+    
+    bool simplifyCompositeExtract(uint32_t index);
+    
+    bool simplifyCompositeConstruct(uint32_t index);
+    
+    bool simplifyVectorShuffle(uint32_t index);
+    
+    bool simplifySelect(uint32_t index);
+    
+    bool simplifyPhi(uint32_t index);
+    
+    void findLocalVariables(
+            std::vector<bool>&  variables);
+    
+    void updateDefs();
+    
+    uint32_t addInstruction(
+      const std::vector<uint32_t>& words);
+    
+    uint32_t allocateId();
+    
+    uint32_t defineConstant(
+            spv::Op             op,
+            uint32_t            typeId,
+            uint32_t            argCount,
+      const uint32_t*           args);
+    
+    uint32_t getVectorComponentType(
+            uint32_t            typeId,
+            uint32_t&           count) const;
+    
+    bool is32BitScalarType(
+            uint32_t            typeId) const;
+    
+    bool isScalarConstant(
+            uint32_t            id) const;
+    
+    bool isCompositeConstant(
+            uint32_t            id) const;
+    
+    const uint32_t* getDef(
+            uint32_t            id) const;
+    
+    uint32_t getTypeId(
+            uint32_t            id) const;
+    
+    void makeCopy(
+            uint32_t            index,
+            uint32_t            valueId);
+    
+    void removeInstruction(
+            uint32_t            index);
+    
+    spv::Op opCode(uint32_t index) const {
+      return spv::Op(m_words[m_ins[index].offset] & spv::OpCodeMask);
+    }
+    
+    uint32_t* words(uint32_t index) {
+      return &m_words[m_ins[index].offset];
+    }
+    
+    const uint32_t* words(uint32_t index) const {
+      return &m_words[m_ins[index].offset];
+    }
+    
+    uint32_t getResultId(uint32_t index) const;
+    
+    template<typename Fn>
+    void forEachId(uint32_t index, bool conservative, const Fn& fn);
+    
+    static bool getLayout(
+      const uint32_t*           ins,
+            Layout&             layout);
+    
+    static bool hasNullByte(uint32_t word) {
+      return !(word & 0x000000FF) || !(word & 0x0000FF00)
+          || !(word & 0x00FF0000) || !(word & 0xFF000000);
+    }
+    
+    static spv::Op getOpCode(const uint32_t* ins) {
+      return spv::Op(ins[0] & spv::OpCodeMask);
+    }
+    
+    static uint32_t getLength(const uint32_t* ins) {
+      return ins[0] >> spv::WordCountShift;
+    }
+    
+  };
+  
+}
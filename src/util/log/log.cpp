@@ -1,17 +1,156 @@
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
 #include "log.h"
 
+#include "../com/com_include.h"
+
+#include "../prof/prof.h"
+
 #include "../util_env.h"
+#include "../util_string.h"
 
 namespace dxvk {
   
+  /**
+   * \brief Log writer
+   * 
+   * Owns the message queue and output file. Shared
+   * between the logger and the writer thread, which
+   * is detached, so that unloading the DLL does not
+   * have to wait for the thread to exit. The module
+   * is pinned instead, since the thread runs its code.
+   */
+  class LogWriter {
+    constexpr static uint32_t QueueSize = 4096;
+  public:
+    
+    LogWriter(const std::string& fileName)
+    : m_queue(QueueSize), m_fileStream(fileName) { }
+    
+    void start(const std::shared_ptr<LogWriter>& self) {
+      pinModule();
+      std::thread([self] { self->run(); }).detach();
+    }
+    
+    void stop() {
+      // The module is pinned, so this only runs at process
+      // exit, when the writer thread has been terminated. It
+      // may have been killed while holding the read lock, in
+      // which case we must not wait for the lock either.
+      std::unique_lock<std::mutex> lock(m_readLock, std::try_to_lock);
+      this->drain();
+    }
+    
+    void push(LogLevel level, const std::string& message) {
+      m_queue.push(level, std::string(message));
+      
+      if (level >= LogLevel::Error) {
+        this->flush();
+      } else if (!m_pending.exchange(true)) {
+        // Only the first message after the writer thread
+        // has woken up needs to notify it. Doing so under
+        // the lock ensures that the wakeup cannot be lost.
+        std::lock_guard<std::mutex> lock(m_waitLock);
+        m_cond.notify_one();
+      }
+    }
+    
+    void flush() {
+      std::lock_guard<std::mutex> lock(m_readLock);
+      this->drain();
+    }
+    
+  private:
+    
+    LogQueue          m_queue;
+    
+    std::mutex        m_readLock;
+    std::ofstream     m_fileStream;
+    
+    std::atomic<bool>       m_pending = { false };
+    std::mutex              m_waitLock;
+    std::condition_variable m_cond;
+    
+    static void pinModule() {
+      // Keeps the module that contains this function loaded
+      // until the process exits, since FreeLibrary would
+      // otherwise unmap code that the thread is running
+      HMODULE module = nullptr;
+      
+      if (!::GetModuleHandleExW(
+            GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS
+          | GET_MODULE_HANDLE_EX_FLAG_PIN,
+            reinterpret_cast<LPCWSTR>(&LogWriter::pinModule),
+            &module))
+        std::cerr << "Logger: Failed to pin module" << std::endl;
+    }
+    
+    void run() {
+      Profiler::setThreadName("dxvk-log");
+      
+      // The thread runs until the process exits. Messages
+      // pushed after the pending flag is reset will set it
+      // again, so that they get written in the next batch.
+      while (true) {
+        { std::unique_lock<std::mutex> lock(m_waitLock);
+          m_cond.wait(lock, [this] { return m_pending.load(); });
+        }
+        
+        m_pending.store(false);
+        this->flush();
+      }
+    }
+    
+    void drain() {
+      LogMessage message;
+      bool       written = false;
+      
+      while (m_queue.pop(message)) {
+        this->write(message.level, message.text);
+        written = true;
+      }
+      
+      const uint64_t dropCount = m_queue.takeDropCount();
+      
+      if (dropCount != 0) {
+        this->write(LogLevel::Warn, str::format("Logger: Dropped ", dropCount, " messages"));
+        written = true;
+      }
+      
+      if (written) {
+        std::cerr.flush();
+        m_fileStream.flush();
+      }
+    }
+    
+    void write(LogLevel level, const std::string& message) {
+      static std::array<const char*, 5> s_prefixes
+        = {{ "trace: ", "debug: ", "info:  ", "warn:  ", "err:   " }};
+      
+      const char* prefix = s_prefixes.at(static_cast<uint32_t>(level));
+      std::cerr    << prefix << message << '\n';
+      m_fileStream << prefix << message << '\n';
+    }
+    
+  };
+  
+  
   Logger::Logger(const std::string& file_name)
   : m_minLevel(getMinLogLevel()) {
-    if (m_minLevel != LogLevel::None)
-      m_fileStream = std::ofstream(getFileName(file_name));
+    if (m_minLevel != LogLevel::None) {
+      m_writer = std::make_shared<LogWriter>(getFileName(file_name));
+      m_writer->start(m_writer);
+    }
   }
   
   
-  Logger::~Logger() { }
+  Logger::~Logger() {
+    if (m_writer != nullptr)
+      m_writer->stop();
+  }
   
   
   void Logger::trace(const std::string& message) {
@@ -44,17 +183,15 @@ namespace dxvk {
   }
   
   
+  void Logger::flush() {
+    if (s_instance.m_writer != nullptr)
+      s_instance.m_writer->flush();
+  }
+  
+  
   void Logger::emitMsg(LogLevel level, const std::string& message) {
-    if (level >= m_minLevel) {
-      std::lock_guard<std::mutex> lock(m_mutex);
-      
-      static std::array<const char*, 5> s_prefixes
-        = {{ "trace: ", "debug: ", "info:  ", "warn:  ", "err:   " }};
-      
-      const char* prefix = s_prefixes.at(static_cast<uint32_t>(level));
-      std::cerr    << prefix << message << std::endl;
-      m_fileStream << prefix << message << std::endl;
-    }
+    if (level >= m_minLevel)
+      m_writer->push(level, message);
   }
   
   
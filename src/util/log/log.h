@@ -3,9 +3,12 @@
 #include <array>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <string>
 
+#include "log_queue.h"
+
 namespace dxvk {
   
   enum class LogLevel : uint32_t {
@@ -17,11 +20,21 @@ namespace dxvk {
     None  = 5,
   };
   
+  class LogWriter;
+  
   /**
    * \brief Logger
    * 
    * Logger for one DLL. Creates a text file and
    * writes all log messages to that file.
+   * 
+   * Messages are queued and written by a background
+   * thread, so that logging does not block on I/O.
+   * Error messages, and all messages queued before
+   * them, are written immediately so that they are
+   * not lost if the application crashes. Callers
+   * should check \ref logLevel before formatting
+   * messages on hot paths.
    */
   class Logger {
     
@@ -41,21 +54,28 @@ namespace dxvk {
       return s_instance.m_minLevel;
     }
     
+    /**
+     * \brief Writes all queued messages
+     * 
+     * Blocks until all messages that have been
+     * queued so far are written to the log.
+     */
+    static void flush();
+    
+    static std::string getFileName(
+      const std::string& base);
+    
   private:
     
     static Logger s_instance;
     
     const LogLevel m_minLevel;
     
-    std::mutex    m_mutex;
-    std::ofstream m_fileStream;
+    std::shared_ptr<LogWriter> m_writer;
     
     void emitMsg(LogLevel level, const std::string& message);
     
     static LogLevel getMinLogLevel();
-    
-    static std::string getFileName(
-      const std::string& base);
 
   };
   
@@ -0,0 +1,67 @@
+#include "log_queue.h"
+
+namespace dxvk {
+  
+  LogQueue::LogQueue(uint32_t capacity)
+  : m_mask  (capacity - 1),
+    m_slots (new Slot[capacity]) {
+    // A slot can be written at position p if its sequence
+    // number is p, and read once it has been set to p + 1
+    for (uint32_t i = 0; i < capacity; i++)
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  
+  
+  LogQueue::~LogQueue() {
+    
+  }
+  
+  
+  bool LogQueue::push(
+          LogLevel      level,
+          std::string&& text) {
+    uint64_t pos = m_writePos.load(std::memory_order_relaxed);
+    Slot*   slot = nullptr;
+    
+    while (true) {
+      slot = &m_slots[pos & m_mask];
+      
+      const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const int64_t  distance = int64_t(sequence - pos);
+      
+      if (distance == 0) {
+        if (m_writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      } else if (distance < 0) {
+        // The consumer has not read the message
+        // that was written to this slot last
+        m_dropCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        pos = m_writePos.load(std::memory_order_relaxed);
+      }
+    }
+    
+    slot->message.level = level;
+    slot->message.text  = std::move(text);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+  
+  
+  bool LogQueue::pop(
+          LogMessage&   message) {
+    Slot* slot = &m_slots[m_readPos & m_mask];
+    
+    if (slot->sequence.load(std::memory_order_acquire) != m_readPos + 1)
+      return false;
+    
+    message = std::move(slot->message);
+    slot->message.text.clear();
+    slot->sequence.store(m_readPos + m_mask + 1, std::memory_order_release);
+    
+    m_readPos += 1;
+    return true;
+  }
+  
+}
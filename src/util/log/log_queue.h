@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace dxvk {
+  
+  enum class LogLevel : uint32_t;
+  
+  /**
+   * \brief Log message
+   */
+  struct LogMessage {
+    LogLevel    level;
+    std::string text;
+  };
+  
+  
+  /**
+   * \brief Log message queue
+   * 
+   * Bounded multi-producer, single-consumer queue. Adding
+   * a message does not take any locks, so that threads
+   * logging at a high rate do not serialize on each other.
+   * If the queue is full, messages are dropped and counted
+   * rather than blocking the calling thread.
+   * 
+   * Consumers must be serialized by the caller.
+   */
+  class LogQueue {
+    
+  public:
+    
+    /**
+     * \brief Creates a log queue
+     * \param [in] capacity Maximum number of messages,
+     *        must be a power of two
+     */
+    LogQueue(uint32_t capacity);
+    ~LogQueue();
+    
+    LogQueue             (const LogQueue&) = delete;
+    LogQueue& operator = (const LogQueue&) = delete;
+    
+    /**
+     * \brief Adds a message
+     * 
+     * \param [in] level Message level
+     * \param [in] text Message text
+     * \returns \c false if the queue was full
+     */
+    bool push(
+            LogLevel      level,
+            std::string&& text);
+    
+    /**
+     * \brief Removes the oldest message
+     * 
+     * \param [out] message The message
+     * \returns \c false if the queue was empty
+     */
+    bool pop(
+            LogMessage&   message);
+    
+    /**
+     * \brief Retrieves and resets drop count
+     * \returns Number of messages dropped since the last call
+     */
+    uint64_t takeDropCount() {
+      return m_dropCount.exchange(0, std::memory_order_relaxed);
+    }
+    
+  private:
+    
+    struct Slot {
+      std::atomic<uint64_t> sequence;
+      LogMessage            message;
+    };
+    
+    const uint64_t          m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+    
+    std::atomic<uint64_t>   m_writePos  = { 0ull };
+    uint64_t                m_readPos   = 0;
+    
+    std::atomic<uint64_t>   m_dropCount = { 0ull };
+    
+  };
+  
+}
@@ -0,0 +1,161 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+#include "prof.h"
+
+#include "../log/log.h"
+
+#include "../util_env.h"
+#include "../util_string.h"
+
+#include "../com/com_include.h"
+
+namespace dxvk {
+  
+  static thread_local ProfilerThreadBuffer* t_threadBuffer = nullptr;
+  static thread_local const char*           t_threadName   = nullptr;
+  
+  
+  Profiler::Profiler(const std::string& file_name)
+  : m_frameLimit(getFrameLimit()),
+    m_fileName  (Logger::getFileName(file_name)) {
+    m_recording.store(m_frameLimit != 0);
+  }
+  
+  
+  Profiler::~Profiler() {
+    // Write whatever we have if the application
+    // exits before reaching the frame limit
+    if (m_recording.exchange(false))
+      this->writeTrace();
+  }
+  
+  
+  int64_t Profiler::timestamp() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+  
+  
+  void Profiler::recordZone(
+    const char*   name,
+          int64_t start,
+          int64_t end) {
+    ProfilerThreadBuffer* buffer = t_threadBuffer;
+    
+    if (buffer == nullptr)
+      buffer = s_instance.getThreadBuffer();
+    
+    const uint32_t index = buffer->eventCount.load(std::memory_order_relaxed);
+    
+    if (index < ProfilerThreadBuffer::MaxEventCount) {
+      buffer->events[index] = { name, start, end };
+      buffer->eventCount.store(index + 1, std::memory_order_release);
+    }
+  }
+  
+  
+  void Profiler::setThreadName(
+    const char*   name) {
+    t_threadName = name;
+    
+    if (t_threadBuffer != nullptr) {
+      std::lock_guard<std::mutex> lock(s_instance.m_mutex);
+      t_threadBuffer->threadName = name;
+    }
+  }
+  
+  
+  void Profiler::endFrame() {
+    if (!enabled())
+      return;
+    
+    const int64_t now = timestamp();
+    recordZone("Frame", now, now);
+    
+    if (s_instance.m_frameId.fetch_add(1) + 1 == s_instance.m_frameLimit) {
+      if (s_instance.m_recording.exchange(false))
+        s_instance.writeTrace();
+    }
+  }
+  
+  
+  ProfilerThreadBuffer* Profiler::getThreadBuffer() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    auto buffer = std::make_unique<ProfilerThreadBuffer>();
+    buffer->threadId   = ::GetCurrentThreadId();
+    buffer->threadName = t_threadName != nullptr ? t_threadName : "";
+    buffer->events.resize(ProfilerThreadBuffer::MaxEventCount);
+    
+    t_threadBuffer = buffer.get();
+    m_threads.push_back(std::move(buffer));
+    return t_threadBuffer;
+  }
+  
+  
+  void Profiler::writeTrace() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    std::ofstream file(m_fileName);
+    
+    if (!file) {
+      Logger::err(str::format("Profiler: Failed to open ", m_fileName));
+      return;
+    }
+    
+    const uint32_t processId = ::GetCurrentProcessId();
+    
+    file << "{\"traceEvents\":[" << std::endl;
+    file << std::fixed << std::setprecision(3);
+    
+    bool first = true;
+    
+    for (const auto& thread : m_threads) {
+      if (!thread->threadName.empty()) {
+        file << (first ? "" : ",\n")
+             << "{\"name\":\"thread_name\",\"ph\":\"M\""
+             << ",\"pid\":" << processId
+             << ",\"tid\":" << thread->threadId
+             << ",\"args\":{\"name\":\"" << thread->threadName << "\"}}";
+        first = false;
+      }
+      
+      const uint32_t eventCount = thread->eventCount.load(std::memory_order_acquire);
+      
+      for (uint32_t i = 0; i < eventCount; i++) {
+        const ProfilerEvent& e = thread->events[i];
+        
+        // Zero-length zones are frame markers
+        file << (first ? "" : ",\n")
+             << "{\"name\":\"" << e.name << "\""
+             << ",\"ph\":\"" << (e.start == e.end ? "i\",\"s\":\"p" : "X") << "\""
+             << ",\"pid\":" << processId
+             << ",\"tid\":" << thread->threadId
+             << ",\"ts\":" << double(e.start) / 1000.0;
+        
+        if (e.start != e.end)
+          file << ",\"dur\":" << double(e.end - e.start) / 1000.0;
+        
+        file << "}";
+        first = false;
+      }
+      
+      if (eventCount == ProfilerThreadBuffer::MaxEventCount)
+        Logger::warn(str::format("Profiler: Event buffer full on thread ", thread->threadId));
+    }
+    
+    file << std::endl << "]}" << std::endl;
+    
+    Logger::info(str::format("Profiler: Wrote ", m_frameId.load(), " frames to ", m_fileName));
+  }
+  
+  
+  uint32_t Profiler::getFrameLimit() {
+    const std::string frameCount = env::getEnvVar(L"DXVK_PROFILE_FRAMES");
+    return frameCount.empty() ? 0 : std::strtoul(frameCount.c_str(), nullptr, 10);
+  }
+  
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dxvk {
+  
+  /**
+   * \brief Profiler zone
+   * 
+   * A named time interval on a single thread.
+   * Zone names must be string literals, since
+   * only the pointer is stored.
+   */
+  struct ProfilerEvent {
+    const char* name;
+    int64_t     start;
+    int64_t     end;
+  };
+  
+  
+  /**
+   * \brief Per-thread event buffer
+   * 
+   * Only written by the thread that owns it, so
+   * recording an event does not require locking.
+   * The event count is published with release
+   * semantics so that the trace writer can read
+   * all events up to that count.
+   */
+  struct ProfilerThreadBuffer {
+    constexpr static uint32_t MaxEventCount = 1 << 16;
+    
+    uint32_t                      threadId;
+    std::string                   threadName;
+    std::vector<ProfilerEvent>    events;
+    std::atomic<uint32_t>         eventCount = { 0u };
+  };
+  
+  
+  /**
+   * \brief CPU profiler
+   * 
+   * Profiler for one DLL. When \c DXVK_PROFILE_FRAMES
+   * is set to a non-zero value, records scoped zones
+   * on all threads until the given number of frames
+   * have been presented, and then writes the result
+   * to a Chrome trace file which can be loaded in
+   * \c chrome://tracing or Perfetto.
+   * 
+   * Zones can be removed at compile time by building
+   * with \c DXVK_NO_PROFILER defined.
+   */
+  class Profiler {
+    
+  public:
+    
+    Profiler(const std::string& file_name);
+    ~Profiler();
+    
+    /**
+     * \brief Checks whether the profiler is recording
+     * \returns \c true if zones should be recorded
+     */
+    static bool enabled() {
+      return s_instance.m_recording.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * \brief Current timestamp
+     * \returns Timestamp in nanoseconds
+     */
+    static int64_t timestamp();
+    
+    /**
+     * \brief Records a zone on the calling thread
+     * 
+     * \param [in] name Zone name
+     * \param [in] start Start timestamp
+     * \param [in] end End timestamp
+     */
+    static void recordZone(
+      const char*   name,
+            int64_t start,
+            int64_t end);
+    
+    /**
+     * \brief Sets name of the calling thread
+     * 
+     * The name shows up in the trace viewer.
+     * \param [in] name Thread name
+     */
+    static void setThreadName(
+      const char*   name);
+    
+    /**
+     * \brief Marks the end of a frame
+     * 
+     * Writes the trace once the requested
+     * number of frames has been recorded.
+     */
+    static void endFrame();
+    
+  private:
+    
+    static Profiler s_instance;
+    
+    const uint32_t    m_frameLimit;
+    const std::string m_fileName;
+    
+    std::atomic<bool>     m_recording = { false };
+    std::atomic<uint32_t> m_frameId   = { 0u };
+    
+    std::mutex            m_mutex;
+    std::vector<std::unique_ptr<ProfilerThreadBuffer>> m_threads;
+    
+    ProfilerThreadBuffer* getThreadBuffer();
+    
+    void writeTrace();
+    
+    static uint32_t getFrameLimit();
+    
+  };
+  
+  
+  /**
+   * \brief Scoped profiler zone
+   * 
+   * Records the time between construction and
+   * destruction if the profiler is enabled.
+   */
+  class ProfilerZone {
+    
+  public:
+    
+    ProfilerZone(const char* name)
+    : m_name (name),
+      m_start(Profiler::enabled() ? Profiler::timestamp() : 0) { }
+    
+    ~ProfilerZone() {
+      if (m_start != 0)
+        Profiler::recordZone(m_name, m_start, Profiler::timestamp());
+    }
+    
+    ProfilerZone             (const ProfilerZone&) = delete;
+    ProfilerZone& operator = (const ProfilerZone&) = delete;
+    
+  private:
+    
+    const char* m_name;
+    int64_t     m_start;
+    
+  };
+  
+}
+
+#ifdef DXVK_NO_PROFILER
+#define DXVK_PROFILE_ZONE(name) \
+  do { } while (0)
+#else
+#define DXVK_PROFILE_ZONE_NAME2(line) dxvkProfilerZone ## line
+#define DXVK_PROFILE_ZONE_NAME(line)  DXVK_PROFILE_ZONE_NAME2(line)
+#define DXVK_PROFILE_ZONE(name) \
+  dxvk::ProfilerZone DXVK_PROFILE_ZONE_NAME(__LINE__)(name)
+#endif
@@ -0,0 +1,253 @@
+#include <array>
+#include <chrono>
+#include <cstring>
+
+#include <d3dcompiler.h>
+#include <d3d11.h>
+
+#include <windows.h>
+#include <windowsx.h>
+
+#include "../test_utils.h"
+
+using namespace dxvk;
+
+// Renders a number of render passes with many small draws
+// per frame and measures how long it takes to get them all
+// through the immediate context. Meant to be run on a build
+// configured with -Denable_null_vulkan=true and
+// -Denable_cs_workers=true, so that only CPU
+// overhead is measured, with different values for
+// DXVK_CS_WORKERS to compare the single-threaded CS thread
+// with parallel recording of command stream segments.
+
+const uint32_t g_frameCount     = 200;
+const uint32_t g_passesPerFrame = 16;
+const uint32_t g_drawsPerPass   = 128;
+const uint32_t g_renderTargets  = 4;
+
+const std::string g_vertexShaderCode =
+  "cbuffer c_draw : register(b0) {\n"
+  "  float4 offset;\n"
+  "};\n"
+  "float4 main(uint id : SV_VertexID) : SV_POSITION {\n"
+  "  float2 pos = float2(id & 1, id >> 1);\n"
+  "  return float4(0.1f * pos + offset.xy, 0.0f, 1.0f);\n"
+  "}\n";
+
+const std::string g_pixelShaderCode =
+  "cbuffer c_draw : register(b0) {\n"
+  "  float4 offset;\n"
+  "};\n"
+  "float4 main() : SV_TARGET {\n"
+  "  return float4(offset.zw, 0.0f, 1.0f);\n"
+  "}\n";
+
+class CsScalingApp {
+  
+public:
+  
+  bool init() {
+    if (FAILED(D3D11CreateDevice(
+          nullptr, D3D_DRIVER_TYPE_HARDWARE,
+          nullptr, 0, nullptr, 0, D3D11_SDK_VERSION,
+          &m_device, nullptr, &m_context))) {
+      std::cerr << "Failed to create D3D11 device" << std::endl;
+      return false;
+    }
+    
+    Com<ID3DBlob> vertexShaderBlob;
+    Com<ID3DBlob> pixelShaderBlob;
+    
+    if (FAILED(D3DCompile(
+          g_vertexShaderCode.data(),
+          g_vertexShaderCode.size(),
+          "Vertex shader",
+          nullptr, nullptr,
+          "main", "vs_5_0", 0, 0,
+          &vertexShaderBlob,
+          nullptr))) {
+      std::cerr << "Failed to compile vertex shader" << std::endl;
+      return false;
+    }
+    
+    if (FAILED(D3DCompile(
+          g_pixelShaderCode.data(),
+          g_pixelShaderCode.size(),
+          "Pixel shader",
+          nullptr, nullptr,
+          "main", "ps_5_0", 0, 0,
+          &pixelShaderBlob,
+          nullptr))) {
+      std::cerr << "Failed to compile pixel shader" << std::endl;
+      return false;
+    }
+    
+    if (FAILED(m_device->CreateVertexShader(
+          vertexShaderBlob->GetBufferPointer(),
+          vertexShaderBlob->GetBufferSize(),
+          nullptr, &m_vertexShader))) {
+      std::cerr << "Failed to create vertex shader" << std::endl;
+      return false;
+    }
+    
+    if (FAILED(m_device->CreatePixelShader(
+          pixelShaderBlob->GetBufferPointer(),
+          pixelShaderBlob->GetBufferSize(),
+          nullptr, &m_pixelShader))) {
+      std::cerr << "Failed to create pixel shader" << std::endl;
+      return false;
+    }
+    
+    D3D11_BUFFER_DESC cbDesc;
+    cbDesc.ByteWidth            = 4 * sizeof(float);
+    cbDesc.Usage                = D3D11_USAGE_DYNAMIC;
+    cbDesc.BindFlags            = D3D11_BIND_CONSTANT_BUFFER;
+    cbDesc.CPUAccessFlags       = D3D11_CPU_ACCESS_WRITE;
+    cbDesc.MiscFlags            = 0;
+    cbDesc.StructureByteStride  = 0;
+    
+    if (FAILED(m_device->CreateBuffer(&cbDesc, nullptr, &m_constantBuffer))) {
+      std::cerr << "Failed to create constant buffer" << std::endl;
+      return false;
+    }
+    
+    D3D11_TEXTURE2D_DESC rtDesc;
+    rtDesc.Width              = 256;
+    rtDesc.Height             = 256;
+    rtDesc.MipLevels          = 1;
+    rtDesc.ArraySize          = 1;
+    rtDesc.Format             = DXGI_FORMAT_R8G8B8A8_UNORM;
+    rtDesc.SampleDesc.Count   = 1;
+    rtDesc.SampleDesc.Quality = 0;
+    rtDesc.Usage              = D3D11_USAGE_DEFAULT;
+    rtDesc.BindFlags          = D3D11_BIND_RENDER_TARGET;
+    rtDesc.CPUAccessFlags     = 0;
+    rtDesc.MiscFlags          = 0;
+    
+    for (uint32_t i = 0; i < g_renderTargets; i++) {
+      if (FAILED(m_device->CreateTexture2D(&rtDesc, nullptr, &m_renderTargets[i]))
+       || FAILED(m_device->CreateRenderTargetView(m_renderTargets[i].ptr(), nullptr, &m_renderTargetViews[i]))) {
+        std::cerr << "Failed to create render target" << std::endl;
+        return false;
+      }
+    }
+    
+    D3D11_QUERY_DESC queryDesc;
+    queryDesc.Query     = D3D11_QUERY_EVENT;
+    queryDesc.MiscFlags = 0;
+    
+    if (FAILED(m_device->CreateQuery(&queryDesc, &m_query))) {
+      std::cerr << "Failed to create event query" << std::endl;
+      return false;
+    }
+    
+    return true;
+  }
+  
+  
+  void run() {
+    // The first frame compiles all pipelines
+    // and should not be part of the result
+    renderFrame();
+    waitForIdle();
+    
+    auto t0 = std::chrono::high_resolution_clock::now();
+    
+    for (uint32_t i = 0; i < g_frameCount; i++)
+      renderFrame();
+    
+    waitForIdle();
+    
+    auto t1 = std::chrono::high_resolution_clock::now();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0);
+    
+    const uint32_t drawCount = g_frameCount * g_passesPerFrame * g_drawsPerPass;
+    
+    std::cout << "Frames:     " << g_frameCount << std::endl;
+    std::cout << "Draws:      " << drawCount << std::endl;
+    std::cout << "Frame time: " << (double(us.count()) / double(1000 * g_frameCount)) << " ms" << std::endl;
+    std::cout << "Draws/s:    " << uint64_t(double(drawCount) * 1000000.0 / double(us.count())) << std::endl;
+  }
+  
+private:
+  
+  Com<ID3D11Device>         m_device;
+  Com<ID3D11DeviceContext>  m_context;
+  
+  Com<ID3D11VertexShader>   m_vertexShader;
+  Com<ID3D11PixelShader>    m_pixelShader;
+  Com<ID3D11Buffer>         m_constantBuffer;
+  Com<ID3D11Query>          m_query;
+  
+  std::array<Com<ID3D11Texture2D>,        g_renderTargets> m_renderTargets;
+  std::array<Com<ID3D11RenderTargetView>, g_renderTargets> m_renderTargetViews;
+  
+  void renderFrame() {
+    const float color[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    
+    D3D11_VIEWPORT viewport;
+    viewport.TopLeftX = 0.0f;
+    viewport.TopLeftY = 0.0f;
+    viewport.Width    = 256.0f;
+    viewport.Height   = 256.0f;
+    viewport.MinDepth = 0.0f;
+    viewport.MaxDepth = 1.0f;
+    
+    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    m_context->VSSetShader(m_vertexShader.ptr(), nullptr, 0);
+    m_context->PSSetShader(m_pixelShader.ptr(), nullptr, 0);
+    m_context->VSSetConstantBuffers(0, 1, &m_constantBuffer);
+    m_context->PSSetConstantBuffers(0, 1, &m_constantBuffer);
+    m_context->RSSetViewports(1, &viewport);
+    
+    for (uint32_t p = 0; p < g_passesPerFrame; p++) {
+      ID3D11RenderTargetView* rtv = m_renderTargetViews[p % g_renderTargets].ptr();
+      
+      m_context->OMSetRenderTargets(1, &rtv, nullptr);
+      m_context->ClearRenderTargetView(rtv, color);
+      
+      for (uint32_t d = 0; d < g_drawsPerPass; d++) {
+        D3D11_MAPPED_SUBRESOURCE mappedResource;
+        
+        if (FAILED(m_context->Map(m_constantBuffer.ptr(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource)))
+          continue;
+        
+        const float data[4] = {
+          float(d % 16) / 8.0f - 1.0f,
+          float(d / 16) / 8.0f - 1.0f,
+          float(p) / float(g_passesPerFrame),
+          float(d) / float(g_drawsPerPass) };
+        
+        std::memcpy(mappedResource.pData, data, sizeof(data));
+        m_context->Unmap(m_constantBuffer.ptr(), 0);
+        m_context->Draw(4, 0);
+      }
+    }
+    
+    m_context->Flush();
+  }
+  
+  
+  void waitForIdle() {
+    m_context->End(m_query.ptr());
+    
+    while (m_context->GetData(m_query.ptr(), nullptr, 0, 0) != S_OK)
+      continue;
+  }
+  
+};
+
+
+int WINAPI WinMain(HINSTANCE hInstance,
+                   HINSTANCE hPrevInstance,
+                   LPSTR lpCmdLine,
+                   int nCmdShow) {
+  CsScalingApp app;
+  
+  if (!app.init())
+    return 1;
+  
+  app.run();
+  return 0;
+}
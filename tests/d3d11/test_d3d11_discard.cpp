@@ -0,0 +1,201 @@
+#include <array>
+#include <cstring>
+
+#include <d3dcompiler.h>
+#include <d3d11_1.h>
+
+#include <windows.h>
+#include <windowsx.h>
+
+#include "../test_utils.h"
+
+using namespace dxvk;
+
+// Discards a bound render target, overwrites it with a copy and
+// then draws into the bottom left quarter of it. The rest of the
+// image must keep the copied contents, i.e. the render pass
+// must not use the discard to skip loading the image.
+
+const uint32_t g_imageSize = 16;
+
+const uint32_t g_colorCopied = 0xFF00FF00u;
+const uint32_t g_colorDrawn  = 0xFF0000FFu;
+
+const std::string g_vertexShaderCode =
+  "float4 main(uint id : SV_VertexID) : SV_POSITION {\n"
+  "  float2 pos = float2(id & 1, id >> 1);\n"
+  "  return float4(pos - 1.0f, 0.0f, 1.0f);\n"
+  "}\n";
+
+const std::string g_pixelShaderCode =
+  "float4 main() : SV_TARGET {\n"
+  "  return float4(1.0f, 0.0f, 0.0f, 1.0f);\n"
+  "}\n";
+
+int WINAPI WinMain(HINSTANCE hInstance,
+                   HINSTANCE hPrevInstance,
+                   LPSTR lpCmdLine,
+                   int nCmdShow) {
+  Com<ID3D11Device>         device;
+  Com<ID3D11DeviceContext>  context;
+  Com<ID3D11DeviceContext1> context1;
+  Com<ID3D11VertexShader>   vertexShader;
+  Com<ID3D11PixelShader>    pixelShader;
+  
+  Com<ID3D11Texture2D>        renderTarget;
+  Com<ID3D11Texture2D>        copySource;
+  Com<ID3D11Texture2D>        readback;
+  Com<ID3D11RenderTargetView> renderTargetView;
+  
+  if (FAILED(D3D11CreateDevice(
+        nullptr, D3D_DRIVER_TYPE_HARDWARE,
+        nullptr, 0, nullptr, 0, D3D11_SDK_VERSION,
+        &device, nullptr, &context))) {
+    std::cerr << "Failed to create D3D11 device" << std::endl;
+    return 1;
+  }
+  
+  if (FAILED(context->QueryInterface(__uuidof(ID3D11DeviceContext1),
+        reinterpret_cast<void**>(&context1)))) {
+    std::cerr << "Failed to query ID3D11DeviceContext1" << std::endl;
+    return 1;
+  }
+  
+  Com<ID3DBlob> vertexShaderBlob;
+  Com<ID3DBlob> pixelShaderBlob;
+  
+  if (FAILED(D3DCompile(
+        g_vertexShaderCode.data(),
+        g_vertexShaderCode.size(),
+        "Vertex shader",
+        nullptr, nullptr,
+        "main", "vs_5_0", 0, 0,
+        &vertexShaderBlob,
+        nullptr))) {
+    std::cerr << "Failed to compile vertex shader" << std::endl;
+    return 1;
+  }
+  
+  if (FAILED(D3DCompile(
+        g_pixelShaderCode.data(),
+        g_pixelShaderCode.size(),
+        "Pixel shader",
+        nullptr, nullptr,
+        "main", "ps_5_0", 0, 0,
+        &pixelShaderBlob,
+        nullptr))) {
+    std::cerr << "Failed to compile pixel shader" << std::endl;
+    return 1;
+  }
+  
+  if (FAILED(device->CreateVertexShader(
+        vertexShaderBlob->GetBufferPointer(),
+        vertexShaderBlob->GetBufferSize(),
+        nullptr, &vertexShader))
+   || FAILED(device->CreatePixelShader(
+        pixelShaderBlob->GetBufferPointer(),
+        pixelShaderBlob->GetBufferSize(),
+        nullptr, &pixelShader))) {
+    std::cerr << "Failed to create shaders" << std::endl;
+    return 1;
+  }
+  
+  D3D11_TEXTURE2D_DESC texDesc;
+  texDesc.Width              = g_imageSize;
+  texDesc.Height             = g_imageSize;
+  texDesc.MipLevels          = 1;
+  texDesc.ArraySize          = 1;
+  texDesc.Format             = DXGI_FORMAT_R8G8B8A8_UNORM;
+  texDesc.SampleDesc.Count   = 1;
+  texDesc.SampleDesc.Quality = 0;
+  texDesc.Usage              = D3D11_USAGE_DEFAULT;
+  texDesc.BindFlags          = D3D11_BIND_RENDER_TARGET;
+  texDesc.CPUAccessFlags     = 0;
+  texDesc.MiscFlags          = 0;
+  
+  if (FAILED(device->CreateTexture2D(&texDesc, nullptr, &renderTarget))
+   || FAILED(device->CreateRenderTargetView(renderTarget.ptr(), nullptr, &renderTargetView))) {
+    std::cerr << "Failed to create render target" << std::endl;
+    return 1;
+  }
+  
+  std::array<uint32_t, g_imageSize * g_imageSize> srcData;
+  srcData.fill(g_colorCopied);
+  
+  D3D11_SUBRESOURCE_DATA srcDataInfo;
+  srcDataInfo.pSysMem          = srcData.data();
+  srcDataInfo.SysMemPitch      = sizeof(uint32_t) * g_imageSize;
+  srcDataInfo.SysMemSlicePitch = 0;
+  
+  texDesc.Usage     = D3D11_USAGE_IMMUTABLE;
+  texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+  
+  if (FAILED(device->CreateTexture2D(&texDesc, &srcDataInfo, &copySource))) {
+    std::cerr << "Failed to create copy source" << std::endl;
+    return 1;
+  }
+  
+  texDesc.Usage          = D3D11_USAGE_STAGING;
+  texDesc.BindFlags      = 0;
+  texDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+  
+  if (FAILED(device->CreateTexture2D(&texDesc, nullptr, &readback))) {
+    std::cerr << "Failed to create readback texture" << std::endl;
+    return 1;
+  }
+  
+  D3D11_VIEWPORT viewport;
+  viewport.TopLeftX = 0.0f;
+  viewport.TopLeftY = 0.0f;
+  viewport.Width    = float(g_imageSize);
+  viewport.Height   = float(g_imageSize);
+  viewport.MinDepth = 0.0f;
+  viewport.MaxDepth = 1.0f;
+  
+  ID3D11RenderTargetView* rtv = renderTargetView.ptr();
+  
+  context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+  context->VSSetShader(vertexShader.ptr(), nullptr, 0);
+  context->PSSetShader(pixelShader.ptr(), nullptr, 0);
+  context->RSSetViewports(1, &viewport);
+  context->OMSetRenderTargets(1, &rtv, nullptr);
+  
+  // Discard the bound render target, then overwrite it
+  // outside of a render pass before drawing to it
+  context1->DiscardView(renderTargetView.ptr());
+  context->CopyResource(renderTarget.ptr(), copySource.ptr());
+  context->Draw(4, 0);
+  
+  context->CopyResource(readback.ptr(), renderTarget.ptr());
+  
+  D3D11_MAPPED_SUBRESOURCE mappedResource;
+  if (FAILED(context->Map(readback.ptr(), 0, D3D11_MAP_READ, 0, &mappedResource))) {
+    std::cerr << "Failed to map readback texture" << std::endl;
+    return 1;
+  }
+  
+  uint32_t errors = 0;
+  
+  for (uint32_t y = 0; y < g_imageSize; y++) {
+    const uint32_t* row = reinterpret_cast<const uint32_t*>(
+      reinterpret_cast<const char*>(mappedResource.pData) + y * mappedResource.RowPitch);
+    
+    for (uint32_t x = 0; x < g_imageSize; x++) {
+      const bool drawn = x < g_imageSize / 2 && y >= g_imageSize / 2;
+      
+      if (row[x] != (drawn ? g_colorDrawn : g_colorCopied))
+        errors += 1;
+    }
+  }
+  
+  context->Unmap(readback.ptr(), 0);
+  context->ClearState();
+  
+  if (errors != 0) {
+    std::cerr << "Discard test failed: " << errors << " wrong pixels" << std::endl;
+    return 1;
+  }
+  
+  std::cout << "Discard test passed" << std::endl;
+  return 0;
+}
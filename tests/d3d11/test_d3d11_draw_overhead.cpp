@@ -0,0 +1,279 @@
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <functional>
+
+#include <d3dcompiler.h>
+#include <d3d11.h>
+
+#include <windows.h>
+#include <windowsx.h>
+
+#include "../test_utils.h"
+
+using namespace dxvk;
+
+// Measures the CPU cost of individual D3D11 API calls by issuing
+// each of them many times in a row, followed by a draw. Meant to
+// be run on a build configured with -Denable_null_vulkan=true, so
+// that the result covers the D3D11 front end, the CS thread and
+// the DxvkContext, but not the driver.
+
+const uint32_t g_iterations  = 100000;
+const uint32_t g_viewCount   = 16;
+
+const std::string g_vertexShaderCode =
+  "cbuffer c_draw : register(b0) {\n"
+  "  float4 offset;\n"
+  "};\n"
+  "float4 main(uint id : SV_VertexID) : SV_POSITION {\n"
+  "  float2 pos = float2(id & 1, id >> 1);\n"
+  "  return float4(0.1f * pos + offset.xy, 0.0f, 1.0f);\n"
+  "}\n";
+
+const std::string g_pixelShaderCode =
+  "float4 main() : SV_TARGET {\n"
+  "  return float4(1.0f, 1.0f, 1.0f, 1.0f);\n"
+  "}\n";
+
+class DrawOverheadApp {
+  
+public:
+  
+  bool init() {
+    if (FAILED(D3D11CreateDevice(
+          nullptr, D3D_DRIVER_TYPE_HARDWARE,
+          nullptr, 0, nullptr, 0, D3D11_SDK_VERSION,
+          &m_device, nullptr, &m_context))) {
+      std::cerr << "Failed to create D3D11 device" << std::endl;
+      return false;
+    }
+    
+    Com<ID3DBlob> vertexShaderBlob;
+    Com<ID3DBlob> pixelShaderBlob;
+    
+    if (FAILED(D3DCompile(
+          g_vertexShaderCode.data(),
+          g_vertexShaderCode.size(),
+          "Vertex shader",
+          nullptr, nullptr,
+          "main", "vs_5_0", 0, 0,
+          &vertexShaderBlob,
+          nullptr))) {
+      std::cerr << "Failed to compile vertex shader" << std::endl;
+      return false;
+    }
+    
+    if (FAILED(D3DCompile(
+          g_pixelShaderCode.data(),
+          g_pixelShaderCode.size(),
+          "Pixel shader",
+          nullptr, nullptr,
+          "main", "ps_5_0", 0, 0,
+          &pixelShaderBlob,
+          nullptr))) {
+      std::cerr << "Failed to compile pixel shader" << std::endl;
+      return false;
+    }
+    
+    if (FAILED(m_device->CreateVertexShader(
+          vertexShaderBlob->GetBufferPointer(),
+          vertexShaderBlob->GetBufferSize(),
+          nullptr, &m_vertexShader))) {
+      std::cerr << "Failed to create vertex shader" << std::endl;
+      return false;
+    }
+    
+    if (FAILED(m_device->CreatePixelShader(
+          pixelShaderBlob->GetBufferPointer(),
+          pixelShaderBlob->GetBufferSize(),
+          nullptr, &m_pixelShader))) {
+      std::cerr << "Failed to create pixel shader" << std::endl;
+      return false;
+    }
+    
+    D3D11_BUFFER_DESC cbDesc;
+    cbDesc.ByteWidth            = 4 * sizeof(float);
+    cbDesc.Usage                = D3D11_USAGE_DYNAMIC;
+    cbDesc.BindFlags            = D3D11_BIND_CONSTANT_BUFFER;
+    cbDesc.CPUAccessFlags       = D3D11_CPU_ACCESS_WRITE;
+    cbDesc.MiscFlags            = 0;
+    cbDesc.StructureByteStride  = 0;
+    
+    if (FAILED(m_device->CreateBuffer(&cbDesc, nullptr, &m_constantBuffer))) {
+      std::cerr << "Failed to create constant buffer" << std::endl;
+      return false;
+    }
+    
+    D3D11_TEXTURE2D_DESC texDesc;
+    texDesc.Width              = 64;
+    texDesc.Height             = 64;
+    texDesc.MipLevels          = 1;
+    texDesc.ArraySize          = 1;
+    texDesc.Format             = DXGI_FORMAT_R8G8B8A8_UNORM;
+    texDesc.SampleDesc.Count   = 1;
+    texDesc.SampleDesc.Quality = 0;
+    texDesc.Usage              = D3D11_USAGE_DEFAULT;
+    texDesc.BindFlags          = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+    texDesc.CPUAccessFlags     = 0;
+    texDesc.MiscFlags          = 0;
+    
+    for (uint32_t i = 0; i < g_viewCount; i++) {
+      if (FAILED(m_device->CreateTexture2D(&texDesc, nullptr, &m_textures[i]))
+       || FAILED(m_device->CreateShaderResourceView(m_textures[i].ptr(), nullptr, &m_shaderResourceViews[i]))) {
+        std::cerr << "Failed to create texture" << std::endl;
+        return false;
+      }
+    }
+    
+    texDesc.Width  = 256;
+    texDesc.Height = 256;
+    
+    if (FAILED(m_device->CreateTexture2D(&texDesc, nullptr, &m_renderTarget))
+     || FAILED(m_device->CreateRenderTargetView(m_renderTarget.ptr(), nullptr, &m_renderTargetView))) {
+      std::cerr << "Failed to create render target" << std::endl;
+      return false;
+    }
+    
+    D3D11_QUERY_DESC queryDesc;
+    queryDesc.Query     = D3D11_QUERY_EVENT;
+    queryDesc.MiscFlags = 0;
+    
+    if (FAILED(m_device->CreateQuery(&queryDesc, &m_query))) {
+      std::cerr << "Failed to create event query" << std::endl;
+      return false;
+    }
+    
+    return true;
+  }
+  
+  
+  void run() {
+    measure("Draw", [] () { });
+    
+    measure("VSSetConstantBuffers + Draw", [this] () {
+      m_context->VSSetConstantBuffers(0, 1, &m_constantBuffer);
+    });
+    
+    measure("PSSetShaderResources (16) + Draw", [this] () {
+      ID3D11ShaderResourceView* views[g_viewCount];
+      
+      for (uint32_t i = 0; i < g_viewCount; i++)
+        views[i] = m_shaderResourceViews[(m_counter + i) % g_viewCount].ptr();
+      
+      m_context->PSSetShaderResources(0, g_viewCount, views);
+    });
+    
+    measure("Map (discard) + Draw", [this] () {
+      D3D11_MAPPED_SUBRESOURCE mappedResource;
+      
+      if (SUCCEEDED(m_context->Map(m_constantBuffer.ptr(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource))) {
+        const float data[4] = { float(m_counter % 16) / 8.0f - 1.0f, 0.0f, 0.0f, 0.0f };
+        std::memcpy(mappedResource.pData, data, sizeof(data));
+        m_context->Unmap(m_constantBuffer.ptr(), 0);
+      }
+    });
+    
+    measure("OMSetRenderTargets + Draw", [this] () {
+      ID3D11RenderTargetView* rtv = m_renderTargetView.ptr();
+      m_context->OMSetRenderTargets(1, &rtv, nullptr);
+    });
+  }
+  
+private:
+  
+  Com<ID3D11Device>           m_device;
+  Com<ID3D11DeviceContext>    m_context;
+  
+  Com<ID3D11VertexShader>     m_vertexShader;
+  Com<ID3D11PixelShader>      m_pixelShader;
+  Com<ID3D11Buffer>           m_constantBuffer;
+  Com<ID3D11Texture2D>        m_renderTarget;
+  Com<ID3D11RenderTargetView> m_renderTargetView;
+  Com<ID3D11Query>            m_query;
+  
+  std::array<Com<ID3D11Texture2D>,          g_viewCount> m_textures;
+  std::array<Com<ID3D11ShaderResourceView>, g_viewCount> m_shaderResourceViews;
+  
+  uint32_t m_counter = 0;
+  
+  void measure(const char* name, const std::function<void()>& call) {
+    setupState();
+    
+    // Run a few iterations first so that pipelines
+    // are compiled before the measurement starts
+    for (uint32_t i = 0; i < 100; i++)
+      iterate(call);
+    
+    waitForIdle();
+    
+    auto t0 = std::chrono::high_resolution_clock::now();
+    
+    for (uint32_t i = 0; i < g_iterations; i++)
+      iterate(call);
+    
+    auto t1 = std::chrono::high_resolution_clock::now();
+    
+    waitForIdle();
+    
+    auto t2 = std::chrono::high_resolution_clock::now();
+    
+    auto nsSubmit = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+    auto nsTotal  = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t0);
+    
+    std::cout << name << ": "
+              << (nsSubmit.count() / g_iterations) << " ns/call (API thread), "
+              << (nsTotal.count()  / g_iterations) << " ns/call (total)" << std::endl;
+  }
+  
+  
+  void iterate(const std::function<void()>& call) {
+    call();
+    m_context->Draw(4, 0);
+    m_counter += 1;
+  }
+  
+  
+  void setupState() {
+    ID3D11RenderTargetView* rtv = m_renderTargetView.ptr();
+    
+    D3D11_VIEWPORT viewport;
+    viewport.TopLeftX = 0.0f;
+    viewport.TopLeftY = 0.0f;
+    viewport.Width    = 256.0f;
+    viewport.Height   = 256.0f;
+    viewport.MinDepth = 0.0f;
+    viewport.MaxDepth = 1.0f;
+    
+    m_context->ClearState();
+    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    m_context->VSSetShader(m_vertexShader.ptr(), nullptr, 0);
+    m_context->PSSetShader(m_pixelShader.ptr(), nullptr, 0);
+    m_context->VSSetConstantBuffers(0, 1, &m_constantBuffer);
+    m_context->OMSetRenderTargets(1, &rtv, nullptr);
+    m_context->RSSetViewports(1, &viewport);
+  }
+  
+  
+  void waitForIdle() {
+    m_context->End(m_query.ptr());
+    
+    while (m_context->GetData(m_query.ptr(), nullptr, 0, 0) != S_OK)
+      continue;
+  }
+  
+};
+
+
+int WINAPI WinMain(HINSTANCE hInstance,
+                   HINSTANCE hPrevInstance,
+                   LPSTR lpCmdLine,
+                   int nCmdShow) {
+  DrawOverheadApp app;
+  
+  if (!app.init())
+    return 1;
+  
+  app.run();
+  return 0;
+}
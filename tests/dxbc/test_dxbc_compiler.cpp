@@ -1,5 +1,6 @@
 #include <iterator>
 #include <fstream>
+#include <sstream>
 
 #include <dxbc_module.h>
 #include <dxvk_shader.h>
@@ -14,6 +15,39 @@ namespace dxvk {
 
 using namespace dxvk;
 
+// Compiles the module and writes the SPIR-V
+// code to the given file. Returns the code.
+SpirvCodeBuffer compileShader(
+  const DxbcModule&   module,
+        bool          optimize,
+  const std::string&  fileName) {
+  DxbcOptions options;
+  options.optimizeSpirv = optimize;
+  
+  Rc<DxvkShader> shader = module.compile(options);
+  
+  std::ofstream ofile(fileName, std::ios::binary);
+  shader->dump(ofile);
+  
+  std::stringstream code;
+  shader->dump(code);
+  return SpirvCodeBuffer(code);
+}
+
+// Counts private variables, such as r# registers,
+// which the optimizer should promote to SSA values
+uint32_t countPrivateVariables(SpirvCodeBuffer& code) {
+  uint32_t count = 0;
+  
+  for (auto ins : code) {
+    if (ins.opCode() == spv::OpVariable
+     && ins.arg(3) == spv::StorageClassPrivate)
+      count += 1;
+  }
+  
+  return count;
+}
+
 int WINAPI WinMain(HINSTANCE hInstance,
                    HINSTANCE hPrevInstance,
                    LPSTR lpCmdLine,
@@ -23,7 +57,7 @@ int WINAPI WinMain(HINSTANCE hInstance,
     GetCommandLineW(), &argc);  
   
   if (argc < 3) {
-    Logger::err("Usage: dxbc-compiler input.dxbc output.spv");
+    Logger::err("Usage: dxbc-compiler input.dxbc output.spv [optimized.spv]");
     return 1;
   }
   
@@ -40,9 +74,19 @@ int WINAPI WinMain(HINSTANCE hInstance,
     DxbcReader reader(dxbcCode.data(), dxbcCode.size());
     DxbcModule module(reader);
     
-    Rc<DxvkShader> shader = module.compile(DxbcOptions());
-    std::ofstream ofile(str::fromws(argv[2]), std::ios::binary);
-    shader->dump(ofile);
+    // Write the optimized module as well so that both
+    // can be validated and compared with spirv-val
+    const std::string outputName    = str::fromws(argv[2]);
+    const std::string optimizedName = argc >= 4
+      ? str::fromws(argv[3]) : outputName + ".opt";
+    
+    SpirvCodeBuffer code      = compileShader(module, false, outputName);
+    SpirvCodeBuffer optimized = compileShader(module, true,  optimizedName);
+    
+    Logger::info(str::format("Unoptimized: ", code.size(), " bytes, ",
+      countPrivateVariables(code), " private variables"));
+    Logger::info(str::format("Optimized:   ", optimized.size(), " bytes, ",
+      countPrivateVariables(optimized), " private variables"));
     return 0;
   } catch (const DxvkError& e) {
     Logger::err(e.message());
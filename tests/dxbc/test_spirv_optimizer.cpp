@@ -0,0 +1,159 @@
+#include <array>
+#include <fstream>
+#include <string>
+
+#include "../../src/spirv/spirv_module.h"
+#include "../../src/spirv/spirv_optimizer.h"
+
+#include <shellapi.h>
+#include <windows.h>
+#include <windowsx.h>
+
+namespace dxvk {
+  Logger Logger::s_instance("spirv-optimizer.log");
+}
+
+using namespace dxvk;
+
+// Builds a vertex shader laid out like the DXBC compiler
+// output: the entry point calls vs_main, which writes the
+// private variable r0 in a branch and reads it afterwards.
+SpirvCodeBuffer buildModule(uint32_t callCount) {
+  SpirvModule m;
+  m.enableCapability(spv::CapabilityShader);
+  m.setMemoryModel(
+    spv::AddressingModelLogical,
+    spv::MemoryModelGLSL450);
+  
+  uint32_t voidType  = m.defVoidType();
+  uint32_t boolType  = m.defBoolType();
+  uint32_t floatType = m.defFloatType(32);
+  uint32_t funcType  = m.defFunctionType(voidType, 0, nullptr);
+  
+  uint32_t inputVar = m.newVar(
+    m.defPointerType(floatType, spv::StorageClassInput),
+    spv::StorageClassInput);
+  uint32_t outputVar = m.newVar(
+    m.defPointerType(floatType, spv::StorageClassOutput),
+    spv::StorageClassOutput);
+  uint32_t r0Var = m.newVar(
+    m.defPointerType(floatType, spv::StorageClassPrivate),
+    spv::StorageClassPrivate);
+  
+  m.decorateLocation(inputVar,  0);
+  m.decorateLocation(outputVar, 0);
+  m.setDebugName(r0Var, "r0");
+  
+  uint32_t mainFunc = m.allocateId();
+  uint32_t vsMainFunc = m.allocateId();
+  m.setDebugName(vsMainFunc, "vs_main");
+  
+  // vs_main: r0 = 0; if (v0 > 0) r0 = v0; o0 = r0 + 1;
+  m.functionBegin(voidType, vsMainFunc, funcType, spv::FunctionControlMaskNone);
+  m.opLabel(m.allocateId());
+  
+  uint32_t labelIf    = m.allocateId();
+  uint32_t labelMerge = m.allocateId();
+  
+  m.opStore(r0Var, m.constf32(0.0f));
+  uint32_t input = m.opLoad(floatType, inputVar);
+  uint32_t cond  = m.opFOrdGreaterThan(boolType, input, m.constf32(0.0f));
+  m.opSelectionMerge(labelMerge, spv::SelectionControlMaskNone);
+  m.opBranchConditional(cond, labelIf, labelMerge);
+  
+  m.opLabel(labelIf);
+  m.opStore(r0Var, input);
+  m.opBranch(labelMerge);
+  
+  m.opLabel(labelMerge);
+  uint32_t r0 = m.opLoad(floatType, r0Var);
+  m.opStore(outputVar, m.opFAdd(floatType, r0, m.constf32(1.0f)));
+  m.opReturn();
+  m.functionEnd();
+  
+  // Entry point, which only calls vs_main
+  m.functionBegin(voidType, mainFunc, funcType, spv::FunctionControlMaskNone);
+  m.opLabel(m.allocateId());
+  
+  for (uint32_t i = 0; i < callCount; i++)
+    m.opFunctionCall(voidType, vsMainFunc, 0, nullptr);
+  
+  m.opReturn();
+  m.functionEnd();
+  
+  const std::array<uint32_t, 2> interfaces = {{ inputVar, outputVar }};
+  m.addEntryPoint(mainFunc, spv::ExecutionModelVertex, "main",
+    interfaces.size(), interfaces.data());
+  return m.compile();
+}
+
+// Counts private variables, such as r# registers,
+// which the optimizer should promote to SSA values
+uint32_t countPrivateVariables(SpirvCodeBuffer& code) {
+  uint32_t count = 0;
+  
+  for (auto ins : code) {
+    if (ins.opCode() == spv::OpVariable
+     && ins.arg(3) == spv::StorageClassPrivate)
+      count += 1;
+  }
+  
+  return count;
+}
+
+// Optimizes the module, writes both versions of it so that
+// they can be checked with spirv-val, and returns whether
+// the number of remaining private variables is as expected
+bool runTest(
+  const std::string&  outputDir,
+  const std::string&  name,
+        uint32_t      callCount,
+        uint32_t      expectedCount) {
+  SpirvCodeBuffer code = buildModule(callCount);
+  
+  SpirvOptimizer optimizer(code);
+  optimizer.run();
+  
+  SpirvCodeBuffer optimized = optimizer.getCode();
+  
+  std::ofstream codeFile(outputDir + "/" + name + ".spv", std::ios::binary | std::ios::trunc);
+  code.store(codeFile);
+  
+  std::ofstream optimizedFile(outputDir + "/" + name + ".opt.spv", std::ios::binary | std::ios::trunc);
+  optimized.store(optimizedFile);
+  
+  uint32_t count = countPrivateVariables(optimized);
+  
+  Logger::info(str::format(name, ": ",
+    countPrivateVariables(code), " private variables, ",
+    count, " after optimization, expected ", expectedCount));
+  return count == expectedCount;
+}
+
+int WINAPI WinMain(HINSTANCE hInstance,
+                   HINSTANCE hPrevInstance,
+                   LPSTR lpCmdLine,
+                   int nCmdShow) {
+  int     argc = 0;
+  LPWSTR* argv = CommandLineToArgvW(
+    GetCommandLineW(), &argc);
+  
+  const std::string outputDir = argc >= 2
+    ? str::fromws(argv[1]) : std::string(".");
+  
+  try {
+    // r0 can only be promoted if vs_main runs once per invocation
+    bool success = runTest(outputDir, "spirv-optimizer-once",  1, 0);
+    success     &= runTest(outputDir, "spirv-optimizer-twice", 2, 1);
+    
+    if (!success) {
+      Logger::err("SPIR-V optimizer test failed");
+      return 1;
+    }
+    
+    return 0;
+  } catch (const DxvkError& e) {
+    Logger::err(e.message());
+    return 1;
+  }
+}
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <dxvk_stats_export.h>
+
+#include <shellapi.h>
+#include <windows.h>
+#include <windowsx.h>
+
+namespace dxvk {
+  Logger Logger::s_instance("dxvk-stats.log");
+}
+
+using namespace dxvk;
+
+struct StatsCapture {
+  std::vector<std::string>          names;
+  std::vector<uint64_t>             frameTimes;
+  std::vector<std::vector<int64_t>> frames;
+};
+
+bool readBinaryCapture(std::ifstream& file, StatsCapture& capture) {
+  DxvkStatsFileHeader expected;
+  DxvkStatsFileHeader header;
+  
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+   || std::memcmp(header.magic, expected.magic, sizeof(header.magic))
+   || header.version != expected.version)
+    return false;
+  
+  for (uint32_t i = 0; i < header.counterCount; i++) {
+    DxvkStatsFileCounter counter;
+    
+    if (!file.read(reinterpret_cast<char*>(&counter), sizeof(counter)))
+      return false;
+    
+    capture.names.push_back(std::string(counter.name,
+      strnlen(counter.name, sizeof(counter.name))));
+  }
+  
+  std::vector<uint64_t> record(header.counterCount + 1);
+  
+  while (file.read(reinterpret_cast<char*>(record.data()), record.size() * sizeof(uint64_t))) {
+    capture.frameTimes.push_back(record[0]);
+    capture.frames.emplace_back(record.begin() + 1, record.end());
+  }
+  
+  return true;
+}
+
+bool readCsvCapture(std::ifstream& file, StatsCapture& capture) {
+  std::string line;
+  std::string field;
+  
+  if (!std::getline(file, line))
+    return false;
+  
+  std::istringstream header(line);
+  
+  if (!std::getline(header, field, ',') || field != "FrameTime")
+    return false;
+  
+  while (std::getline(header, field, ','))
+    capture.names.push_back(field);
+  
+  while (std::getline(file, line)) {
+    std::istringstream row(line);
+    std::vector<int64_t> values;
+    
+    while (std::getline(row, field, ','))
+      values.push_back(std::stoll(field));
+    
+    // Skip partially written rows
+    if (values.size() != capture.names.size() + 1)
+      continue;
+    
+    capture.frameTimes.push_back(uint64_t(values[0]));
+    capture.frames.emplace_back(values.begin() + 1, values.end());
+  }
+  
+  return true;
+}
+
+void printSummary(const StatsCapture& capture) {
+  const size_t frameCount = capture.frames.size();
+  
+  if (frameCount == 0) {
+    std::cout << "No frames recorded" << std::endl;
+    return;
+  }
+  
+  // The first frame time includes device initialization
+  std::vector<uint64_t> frameTimes(capture.frameTimes.begin() + 1, capture.frameTimes.end());
+  std::sort(frameTimes.begin(), frameTimes.end());
+  
+  uint64_t totalTime = 0;
+  
+  for (uint64_t t : frameTimes)
+    totalTime += t;
+  
+  auto ms = [] (uint64_t ns) { return double(ns) / 1000000.0; };
+  
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "Frames:       " << frameCount << std::endl;
+  
+  if (!frameTimes.empty()) {
+    const size_t p99Index = std::min(frameTimes.size() - 1, (frameTimes.size() * 99) / 100);
+    
+    std::cout << "Duration:     " << ms(totalTime) / 1000.0 << " s" << std::endl;
+    std::cout << "Frame time:   " << ms(totalTime) / double(frameTimes.size()) << " ms mean, "
+                                  << ms(frameTimes[p99Index]) << " ms p99, "
+                                  << ms(frameTimes.back()) << " ms max" << std::endl;
+  }
+  
+  // For counters that describe a current value rather than
+  // an event count, the sum of all deltas is the final value
+  std::cout << std::endl
+    << std::left  << std::setw(24) << "Counter"
+    << std::right << std::setw(16) << "Sum"
+    << std::right << std::setw(16) << "Per frame"
+    << std::right << std::setw(16) << "Max" << std::endl;
+  
+  for (size_t i = 0; i < capture.names.size(); i++) {
+    int64_t sum = 0;
+    int64_t max = capture.frames[0][i];
+    
+    for (const auto& frame : capture.frames) {
+      sum += frame[i];
+      max  = std::max(max, frame[i]);
+    }
+    
+    std::cout
+      << std::left  << std::setw(24) << capture.names[i]
+      << std::right << std::setw(16) << sum
+      << std::right << std::setw(16) << double(sum) / double(frameCount)
+      << std::right << std::setw(16) << max << std::endl;
+  }
+}
+
+int WINAPI WinMain(HINSTANCE hInstance,
+                   HINSTANCE hPrevInstance,
+                   LPSTR lpCmdLine,
+                   int nCmdShow) {
+  int     argc = 0;
+  LPWSTR* argv = CommandLineToArgvW(
+    GetCommandLineW(), &argc);
+  
+  if (argc < 2) {
+    std::cerr << "Usage: dxvk-stats capture.dxvk-stats|capture.csv" << std::endl;
+    return 1;
+  }
+  
+  std::ifstream file(str::fromws(argv[1]), std::ios::binary);
+  
+  if (!file) {
+    std::cerr << "Failed to open " << str::fromws(argv[1]) << std::endl;
+    return 1;
+  }
+  
+  StatsCapture capture;
+  
+  char magic[4] = { };
+  file.read(magic, sizeof(magic));
+  file.clear();
+  file.seekg(0, std::ios_base::beg);
+  
+  const bool valid = std::memcmp(magic, DxvkStatsFileHeader().magic, sizeof(magic)) == 0
+    ? readBinaryCapture(file, capture)
+    : readCsvCapture(file, capture);
+  
+  if (!valid) {
+    std::cerr << "Invalid capture file" << std::endl;
+    return 1;
+  }
+  
+  printSummary(capture);
+  return 0;
+}